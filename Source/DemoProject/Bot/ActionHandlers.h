@@ -0,0 +1,179 @@
+#pragma once
+
+#include "AgentModule.h"
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "State/Actions.h"
+
+namespace ForbocAI {
+namespace Bot {
+
+// ── Action Handlers ──
+// SDK actions become store actions through a table of builders keyed by
+// action type. The type is looked up as an FName (case-insensitive, like
+// FAgentAction::Type compares) and its payload parsed into FActionArgs once,
+// where the response arrives, off the game thread; executing an action is
+// then one hash lookup of the name, however many types are registered.
+// Types are only looked up, never interned, so whatever the server sends
+// can't grow the name table: a type no one registered parses to NAME_None.
+// Types without a handler are counted per type rather than dropped quietly,
+// the never-interned ones together under Unknown.
+//
+// Payload wire format (JSON), the "action" object of a batch response:
+//   {"type", "target", "payload": {"location": [x, y, z], "speed"}}
+// every field but "type" optional.
+
+struct FActionArgs {
+  // Name of the actor the action is aimed at
+  FString Target;
+  // World location the action is aimed at
+  TOptional<FVector> Location;
+  TOptional<float> Speed;
+};
+
+struct FParsedAction {
+  FName Type;
+  FActionArgs Args;
+};
+
+// The bot an action is built for.
+struct FActionSubject {
+  AActor *Actor = nullptr;
+  FVector Location = FVector::ZeroVector;
+};
+
+// Builds the store action for one SDK action. Returns false if there's
+// nothing to do.
+using FActionBuilder =
+    TFunction<bool(const FActionArgs &Args, const FActionSubject &Subject,
+                   State::FBotAction &Out)>;
+
+struct FActionHandlerStats {
+  uint64 Built = 0;
+  uint64 Unhandled = 0;
+};
+
+struct FActionHandlerTable {
+  TMap<FName, FActionBuilder> Handlers;
+  // Type without a handler (or UnknownType) -> times it was asked for
+  TMap<FName, uint64> Unhandled;
+  FActionHandlerStats Stats;
+};
+
+namespace ActionHandlerOps {
+
+namespace Detail {
+
+inline bool TryGetVector(const FJsonObject &Object, const TCHAR *Field,
+                         FVector &Out) {
+  const TArray<TSharedPtr<FJsonValue>> *Values = nullptr;
+  if (!Object.TryGetArrayField(Field, Values) || Values->Num() != 3) {
+    return false;
+  }
+  for (int32 Axis = 0; Axis < 3; ++Axis) {
+    if (!(*Values)[Axis].IsValid() ||
+        !(*Values)[Axis]->TryGetNumber(Out[Axis])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace Detail
+
+// Arguments in the optional fields of an action object. Any thread.
+inline FActionArgs ParseArgs(const FJsonObject &Action) {
+  FActionArgs Args;
+  Action.TryGetStringField(TEXT("target"), Args.Target);
+
+  const TSharedPtr<FJsonObject> *Payload = nullptr;
+  if (!Action.TryGetObjectField(TEXT("payload"), Payload) ||
+      !Payload->IsValid()) {
+    return Args;
+  }
+
+  FVector Location;
+  if (Detail::TryGetVector(**Payload, TEXT("location"), Location)) {
+    Args.Location = Location;
+  }
+  double Speed = 0.0;
+  if ((*Payload)->TryGetNumberField(TEXT("speed"), Speed)) {
+    Args.Speed = (float)Speed;
+  }
+  return Args;
+}
+
+// Stands in for every type that was never interned.
+inline FName UnknownType() {
+  static const FName Unknown(TEXT("Unknown"));
+  return Unknown;
+}
+
+// The key Type is counted under: itself, or UnknownType for NAME_None.
+inline FName StatKey(FName Type) {
+  return Type.IsNone() ? UnknownType() : Type;
+}
+
+// Looks up Action's type; NAME_None if it was never interned. Any thread.
+inline FParsedAction Parse(const FAgentAction &Action) {
+  FParsedAction Parsed;
+  Parsed.Type = FName(*Action.Type, FNAME_Find);
+  return Parsed;
+}
+
+// Looks up Action's type and reads its arguments from Json, the action
+// object it was parsed from. Any thread.
+inline FParsedAction Parse(const FAgentAction &Action,
+                           const FJsonObject &Json) {
+  FParsedAction Parsed = Parse(Action);
+  Parsed.Args = ParseArgs(Json);
+  return Parsed;
+}
+
+// Handles Type with Builder, replacing any handler it had.
+inline void Register(FActionHandlerTable &Table, FName Type,
+                     FActionBuilder Builder) {
+  Table.Handlers.Add(Type, MoveTemp(Builder));
+}
+
+// Builds the store action for Action into Out. Returns false if its type
+// has no handler (counted in Unhandled) or the handler had nothing to do.
+inline bool Build(FActionHandlerTable &Table, const FParsedAction &Action,
+                  const FActionSubject &Subject, State::FBotAction &Out) {
+  const FActionBuilder *Builder = Table.Handlers.Find(Action.Type);
+  if (!Builder) {
+    ++Table.Unhandled.FindOrAdd(StatKey(Action.Type));
+    ++Table.Stats.Unhandled;
+    return false;
+  }
+  if (!(*Builder)(Action.Args, Subject, Out)) {
+    return false;
+  }
+  ++Table.Stats.Built;
+  return true;
+}
+
+// MOVE (to the payload location, or 500 units ahead) and ATTACK.
+inline void RegisterDefaults(FActionHandlerTable &Table) {
+  Register(Table, TEXT("MOVE"),
+           [](const FActionArgs &Args, const FActionSubject &Subject,
+              State::FBotAction &Out) {
+             State::FActionMove Move;
+             Move.TargetLocation = Args.Location.Get(
+                 Subject.Location + FVector(500.0, 0.0, 0.0));
+             Move.Speed = Args.Speed.Get(100.0f);
+             Out = Move;
+             return true;
+           });
+  Register(Table, TEXT("ATTACK"),
+           [](const FActionArgs &, const FActionSubject &,
+              State::FBotAction &Out) {
+             Out = State::FActionAttack{nullptr};
+             return true;
+           });
+}
+
+} // namespace ActionHandlerOps
+
+} // namespace Bot
+} // namespace ForbocAI
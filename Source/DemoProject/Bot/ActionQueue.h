@@ -0,0 +1,61 @@
+#pragma once
+
+#include "Containers/Queue.h"
+#include "Bot/SlotMap.h"
+#include "CoreMinimal.h"
+#include "State/Actions.h"
+#include <variant>
+
+namespace ForbocAI {
+namespace Bot {
+
+// ── Deferred Actions ──
+// Producers on any thread (game code, HTTP completion callbacks) push
+// actions here instead of reducing on the spot. The orchestrator drains the
+// queue once per frame at a fixed point in Tick, so every reduction happens
+// on the game thread, in one pass, in enqueue order.
+
+struct FQueuedBotAction {
+  // Bot the action is for; resolved on the game thread at drain time, so a
+  // bot unregistered in between simply drops the action.
+  FBotHandle Bot;
+  State::FBotAction Action;
+};
+
+// Lock-free multi-producer / single-consumer FIFO.
+using FBotActionQueue = TQueue<FQueuedBotAction, EQueueMode::Mpsc>;
+
+namespace QueueOps {
+
+// Moves everything currently queued into Out (reset first), preserving
+// order. With bCoalesceTicks, an FActionTick immediately following another
+// FActionTick for the same bot is folded into it: DeltaTimes are summed and
+// Steps accumulate, so TickCount still advances once per heartbeat. The
+// summed DeltaTime may differ from sequential adds in the last bit.
+inline int32 Drain(FBotActionQueue &Queue, TArray<FQueuedBotAction> &Out,
+                   bool bCoalesceTicks) {
+  Out.Reset();
+
+  FQueuedBotAction Item;
+  while (Queue.Dequeue(Item)) {
+    if (bCoalesceTicks && Out.Num() > 0 && Out.Last().Bot == Item.Bot) {
+      State::FActionTick *LastTick =
+          std::get_if<State::FActionTick>(&Out.Last().Action);
+      const State::FActionTick *Tick =
+          std::get_if<State::FActionTick>(&Item.Action);
+      if (LastTick && Tick) {
+        LastTick->DeltaTime += Tick->DeltaTime;
+        LastTick->Steps += Tick->Steps;
+        continue;
+      }
+    }
+    Out.Add(MoveTemp(Item));
+  }
+
+  return Out.Num();
+}
+
+} // namespace QueueOps
+
+} // namespace Bot
+} // namespace ForbocAI
@@ -0,0 +1,146 @@
+#include "AgentBatch.h"
+#include "Async/Async.h"
+#include "DemoProject.h"
+#include "Dom/JsonObject.h"
+#include "HttpModule.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace ForbocAI {
+namespace Bot {
+namespace AgentBatchOps {
+
+FString BuildRequestBody(TArrayView<const FAgentBatchItem> Items) {
+  FORBOCAI_SCOPE(STAT_ForbocAI_Serialize);
+  FString Body;
+  auto Writer =
+      TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(
+          &Body);
+
+  Writer->WriteObjectStart();
+  Writer->WriteArrayStart(TEXT("requests"));
+  for (const FAgentBatchItem &Item : Items) {
+    Writer->WriteObjectStart();
+    Writer->WriteValue(TEXT("agentId"), Item.AgentId);
+    Writer->WriteValue(TEXT("persona"), Item.Persona);
+    if (Item.bStructuredObservation) {
+      Writer->WriteRawJSONValue(TEXT("observation"), Item.Observation);
+    } else {
+      Writer->WriteValue(TEXT("observation"), Item.Observation);
+    }
+    Writer->WriteObjectEnd();
+  }
+  Writer->WriteArrayEnd();
+  Writer->WriteObjectEnd();
+  Writer->Close();
+
+  return Body;
+}
+
+bool ParseResponseBody(const FString &Body,
+                       TArrayView<const FAgentBatchItem> Items,
+                       TArray<FAgentResponse> &OutResponses,
+                       TArray<FParsedAction> *OutActions) {
+  FORBOCAI_SCOPE(STAT_ForbocAI_Serialize);
+  TSharedPtr<FJsonObject> Root;
+  if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Body),
+                                    Root) ||
+      !Root.IsValid()) {
+    return false;
+  }
+
+  const TArray<TSharedPtr<FJsonValue>> *Entries = nullptr;
+  if (!Root->TryGetArrayField(TEXT("responses"), Entries) ||
+      Entries->Num() != Items.Num()) {
+    return false;
+  }
+
+  OutResponses.Reset(Items.Num());
+  if (OutActions) {
+    OutActions->Reset(Items.Num());
+  }
+  for (int32 Index = 0; Index < Items.Num(); ++Index) {
+    const TSharedPtr<FJsonObject> *Entry = nullptr;
+    if (!(*Entries)[Index]->TryGetObject(Entry)) {
+      return false;
+    }
+
+    FString AgentId;
+    if ((*Entry)->TryGetStringField(TEXT("agentId"), AgentId) &&
+        AgentId != Items[Index].AgentId) {
+      return false;
+    }
+
+    FAgentResponse Response;
+    (*Entry)->TryGetStringField(TEXT("dialogue"), Response.Dialogue);
+
+    const TSharedPtr<FJsonObject> *Action = nullptr;
+    const bool bHasAction =
+        (*Entry)->TryGetObjectField(TEXT("action"), Action) &&
+        Action->IsValid();
+    if (bHasAction) {
+      (*Action)->TryGetStringField(TEXT("type"), Response.Action.Type);
+    }
+    if (OutActions) {
+      OutActions->Add(bHasAction
+                          ? ActionHandlerOps::Parse(Response.Action, **Action)
+                          : ActionHandlerOps::Parse(Response.Action));
+    }
+
+    OutResponses.Add(MoveTemp(Response));
+  }
+
+  return true;
+}
+
+FHttpRequestPtr Send(const FString &Url, TArray<FAgentBatchItem> Items,
+                     FAgentBatchCallback OnComplete) {
+  TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request =
+      FHttpModule::Get().CreateRequest();
+  Request->SetURL(Url);
+  Request->SetVerb(TEXT("POST"));
+  Request->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+  Request->SetContentAsString(BuildRequestBody(Items));
+
+  // Parse where the response lands, then hand the result to the game thread
+  Request->SetDelegateThreadPolicy(
+      EHttpRequestDelegateThreadPolicy::CompleteOnHttpThread);
+  Request->OnProcessRequestComplete().BindLambda(
+      [Items = MoveTemp(Items), OnComplete = MoveTemp(OnComplete)](
+          FHttpRequestPtr, FHttpResponsePtr Response,
+          bool bConnected) mutable {
+        TArray<FAgentResponse> Responses;
+        TArray<FParsedAction> Actions;
+        const bool bOk =
+            bConnected && Response.IsValid() &&
+            EHttpResponseCodes::IsOk(Response->GetResponseCode()) &&
+            ParseResponseBody(Response->GetContentAsString(), Items,
+                              Responses, &Actions);
+
+        if (!bOk) {
+          UE_LOG(LogForbocAI, Warning,
+                 TEXT("AgentBatch: batch of %d failed, falling back"),
+                 Items.Num());
+          Responses.Reset();
+          Actions.Reset();
+        }
+        AsyncTask(ENamedThreads::GameThread,
+                  [bOk, Items = MoveTemp(Items),
+                   OnComplete = MoveTemp(OnComplete),
+                   Responses = MoveTemp(Responses),
+                   Actions = MoveTemp(Actions)]() mutable {
+                    OnComplete(bOk, Items, MoveTemp(Responses),
+                               MoveTemp(Actions));
+                  });
+      });
+
+  Request->ProcessRequest();
+  return Request;
+}
+
+} // namespace AgentBatchOps
+} // namespace Bot
+} // namespace ForbocAI
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "AgentModule.h"
+#include "Bot/ActionHandlers.h"
+#include "Bot/SlotMap.h"
+#include "CoreMinimal.h"
+#include "Interfaces/IHttpRequest.h"
+
+namespace ForbocAI {
+namespace Bot {
+
+// ── Batched Agent Requests ──
+// Observations due in the same frame (or within a short linger window) are
+// sent as one multi-agent request instead of one AgentOps::Process round
+// trip each. The response is a list aligned with the request list and is
+// fanned back out per bot.
+//
+// Wire format (JSON):
+//   request:  {"requests":  [{"agentId", "persona", "observation"}, ...]}
+//             observation is a string, or an object for structured items
+//   response: {"responses": [{"agentId", "dialogue", "action": {"type"}}, ...]}
+//             action may carry a target and payload, see ActionHandlers.h
+
+struct FAgentBatchItem {
+  // Bot this observation belongs to
+  FBotHandle Bot;
+  // Caller's request token, handed back untouched
+  uint64 Token = 0;
+  FString AgentId;
+  FString Persona;
+  FString Observation;
+  // Observation is a JSON object (ObservationOps::WriteJson), not text
+  bool bStructuredObservation = false;
+};
+
+// Receives the items that were sent and, when bOk, one response per item
+// with its action already parsed. bOk is false (and Responses and Actions
+// empty) when the request failed or the response didn't line up with the
+// request; callers fall back to per-bot Process calls in that case.
+using FAgentBatchCallback = TFunction<void(
+    bool bOk, const TArray<FAgentBatchItem> &Items,
+    TArray<FAgentResponse> Responses, TArray<FParsedAction> Actions)>;
+
+namespace AgentBatchOps {
+
+FString BuildRequestBody(TArrayView<const FAgentBatchItem> Items);
+
+// Parses a response body into one FAgentResponse per item, in item order,
+// and, given OutActions, their actions with arguments (ActionHandlerOps).
+// Fails if the count or any agentId doesn't match.
+bool ParseResponseBody(const FString &Body,
+                       TArrayView<const FAgentBatchItem> Items,
+                       TArray<FAgentResponse> &OutResponses,
+                       TArray<FParsedAction> *OutActions = nullptr);
+
+// POSTs Items to Url. The response is parsed on the HTTP thread; OnComplete
+// runs on the game thread.
+FHttpRequestPtr Send(const FString &Url, TArray<FAgentBatchItem> Items,
+                     FAgentBatchCallback OnComplete);
+
+} // namespace AgentBatchOps
+
+} // namespace Bot
+} // namespace ForbocAI
@@ -1,43 +1,549 @@
 #include "BotOrchestrator.h"
+#include "DemoProject.h"
+#include "Async/Async.h"
+#include "Async/MappedFileHandle.h"
+#include "Async/ParallelFor.h"
+#include "EngineUtils.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
 #include "State/Actions.h"
 
-ABotOrchestrator::ABotOrchestrator() { PrimaryActorTick.bCanEverTick = true; }
+namespace {
+
+FBotLodTier MakeLodTier(float MaxDistance, int32 TickDivisor,
+                        float ObservationInterval) {
+  FBotLodTier Tier;
+  Tier.MaxDistance = MaxDistance;
+  Tier.TickDivisor = TickDivisor;
+  Tier.ObservationInterval = ObservationInterval;
+  return Tier;
+}
+
+FBotLatencyStats
+MakeLatencyStats(const TCHAR *Scope, const FString &Key,
+                 const ForbocAI::Bot::FLatencyHistogram &Histogram) {
+  const ForbocAI::Bot::FLatencySummary Summary =
+      ForbocAI::Bot::LatencyOps::Summarize(Histogram);
+
+  FBotLatencyStats Out;
+  Out.Scope = Scope;
+  Out.Key = Key;
+  Out.Count = (int64)Summary.Count;
+  Out.MeanMs = (float)Summary.MeanMs;
+  Out.P50Ms = (float)Summary.P50Ms;
+  Out.P95Ms = (float)Summary.P95Ms;
+  Out.P99Ms = (float)Summary.P99Ms;
+  Out.MaxMs = (float)Summary.MaxMs;
+  return Out;
+}
+
+// Appends CSV rows to Path, starting the file with a header.
+bool AppendLatencyCsv(const FString &Path, const FString &Rows) {
+  if (Rows.IsEmpty())
+    return true;
+
+  FString Out;
+  if (!IFileManager::Get().FileExists(*Path)) {
+    Out = ForbocAI::Bot::LatencyOps::CsvHeader();
+  }
+  Out += Rows;
+  return FFileHelper::SaveStringToFile(
+      Out, *Path, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM,
+      &IFileManager::Get(), FILEWRITE_Append);
+}
+
+// ForbocAI.Latency [reset | csv <Path>]
+void HandleLatencyCommand(const TArray<FString> &Args, UWorld *World) {
+  for (TActorIterator<ABotOrchestrator> It(World); It; ++It) {
+    if (Args.Num() > 0 && Args[0] == TEXT("reset")) {
+      It->ResetLatencyStats();
+      continue;
+    }
+    if (Args.Num() > 1 && Args[0] == TEXT("csv")) {
+      if (!It->SaveLatencyCsv(Args[1])) {
+        UE_LOG(LogForbocAI, Error, TEXT("%s: Failed to write '%s'"),
+               *It->GetName(), *Args[1]);
+      }
+      continue;
+    }
+
+    UE_LOG(LogForbocAI, Display,
+           TEXT("%s: %-8s %-24s %8s %9s %9s %9s %9s"), *It->GetName(),
+           TEXT("Scope"), TEXT("Key"), TEXT("Count"), TEXT("p50 ms"),
+           TEXT("p95 ms"), TEXT("p99 ms"), TEXT("max ms"));
+    for (const FBotLatencyStats &Stats : It->GetLatencyStats()) {
+      if (Stats.Count == 0)
+        continue;
+      UE_LOG(LogForbocAI, Display,
+             TEXT("%s: %-8s %-24s %8lld %9.2f %9.2f %9.2f %9.2f"),
+             *It->GetName(), *Stats.Scope, *Stats.Key, Stats.Count,
+             Stats.P50Ms, Stats.P95Ms, Stats.P99Ms, Stats.MaxMs);
+    }
+  }
+}
+
+// The same Id for the same actor in every session, so a snapshot saved in
+// one session finds its bots when they register again in the next. Derived
+// from the actor's path without the editor's PIE prefix.
+FGuid StableBotId(const AActor *Actor) {
+  return FGuid::NewDeterministicGuid(
+      UWorld::RemovePIEPrefix(Actor->GetPathName()));
+}
+
+FAutoConsoleCommandWithWorldAndArgs LatencyCommand(
+    TEXT("ForbocAI.Latency"),
+    TEXT("Print observe -> execute latency percentiles of every bot "
+         "orchestrator. 'reset' clears them; 'csv <Path>' appends them to a "
+         "CSV file."),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(
+        &HandleLatencyCommand));
+
+} // namespace
+
+ABotOrchestrator::ABotOrchestrator()
+    : StateTable(std::make_shared<ForbocAI::State::FBotStateTable>()) {
+  PrimaryActorTick.bCanEverTick = true;
+
+  // Near: every frame. Mid: every 4th, observing every 15s. Far (out to
+  // WakeRadius): every 16th, every 30s.
+  for (const FBotLodTier &Tier : {MakeLodTier(1500.0f, 1, 0.0f),
+                                  MakeLodTier(3000.0f, 4, 15.0f),
+                                  MakeLodTier(WakeRadius, 16, 30.0f)}) {
+    LodTiers.Add(Tier);
+  }
+  SyncLodTiers();
+  ForbocAI::Bot::ActionHandlerOps::RegisterDefaults(ActionHandlers);
+}
 
 void ABotOrchestrator::BeginPlay() {
   Super::BeginPlay();
-  UE_LOG(LogTemp, Display, TEXT("BotOrchestrator: Brain Online."));
+  // Bots may have registered already, against the wheel's default clock
+  ForbocAI::Bot::SchedulerOps::Rebase(ObservationWheel,
+                                      GetWorld()->GetTimeSeconds());
+  ForbocAI::Bot::CacheOps::Reset(ResponseCache, ResponseCacheSize);
+  ForbocAI::Bot::GridOps::SetCellSize(Perception.Grid, PerceptionCellSize);
+  LatencyCsvPath = FPaths::ProfilingDir() / TEXT("ForbocAI") /
+                   FString::Printf(TEXT("Latency-%s.csv"),
+                                   *FDateTime::Now().ToString());
+  NextLatencyCsvTime = GetWorld()->GetTimeSeconds() + LatencyCsvInterval;
+  UE_LOG(LogForbocAI, Display, TEXT("BotOrchestrator: Brain Online."));
+}
+
+void ABotOrchestrator::EndPlay(const EEndPlayReason::Type EndPlayReason) {
+  // Invalidate every token first so cancelled batches don't fall back to
+  // per-bot calls, then stop the HTTP traffic itself.
+  ForbocAI::Bot::RequestOps::CancelAll(Requests);
+  PendingBatch.Reset();
+  for (const FHttpRequestPtr &Batch : InFlightBatches) {
+    Batch->CancelRequest();
+  }
+  InFlightBatches.Reset();
+
+  if (LatencyCsvWrite.IsValid()) {
+    LatencyCsvWrite.Wait();
+  }
+
+  Super::EndPlay(EndPlayReason);
 }
 
 void ABotOrchestrator::Tick(float DeltaTime) {
   Super::Tick(DeltaTime);
+  FORBOCAI_SCOPE(STAT_ForbocAI_Tick);
 
   float CurrentTime = GetWorld()->GetTimeSeconds();
+  ForbocAI::Bot::ObservationOps::Reset(ObservationBuffer);
+
+  // 0. Spawning
+  // Whatever is left of a RegisterBots wave, within the per-frame budget.
+  if (GetPendingSpawnCount() > 0) {
+    ProcessSpawnQueue();
+  }
+
+  // 0. Deferred Actions
+  // Everything queued since last frame (async results, gameplay events) is
+  // reduced here, before the heartbeat, in a single pass.
+  DrainPendingActions();
+
+  // 1. Functional Store Tick (Heartbeat)
+  // One batch pass over the rows of each LOD tier due this frame, optionally
+  // split across workers. A tier that skipped frames gets their DeltaTime
+  // in the same pass; sleeping rows are skipped entirely.
+  ForbocAI::Bot::FParallelTickConfig TickConfig;
+  TickConfig.ChunkSize = ParallelChunkSize;
+  TickConfig.MaxWorkers = ParallelMaxWorkers;
+  TickConfig.bSingleThread = !bParallelTick;
+  const bool bLodSyncFrame = ForbocAI::Bot::LodOps::Advance(
+      Lod, ForbocAI::Bot::SlotMapOps::Num(Bots), DeltaTime,
+      [this, &TickConfig](int32 Tier, int32 Begin, int32 End,
+                          const ForbocAI::State::FActionTick &Heartbeat) {
+        FORBOCAI_SCOPE(STAT_ForbocAI_Heartbeat);
+        ForbocAI::Bot::ParallelOps::Tick(*StateTable, Begin, End, Heartbeat,
+                                         TickConfig);
+        if (HeartbeatLog) {
+          ForbocAI::State::JournalOps::AppendPass(*HeartbeatLog, Tier,
+                                                  Heartbeat);
+        }
+      });
+  if (HeartbeatLog) {
+    KeyframeJournals();
+  }
+
+  // 1. Perception & LOD
+  // Only on sync frames, when no tier has time carried over. Sightings are
+  // queued for next frame's drain; bots are re-tiered by their distance to
+  // the nearest player and their phase.
+  if (bLodSyncFrame) {
+    SyncLodTiers();
+    UpdatePerception(CurrentTime);
+  }
 
-  for (auto &Pair : ActiveBots) {
-    FBotInstance &Instance = Pair.Value;
+  // 2. Observation Logic (Scheduled)
+  // Only bots whose slot the wheel sweeps past are touched, capped by the
+  // per-frame budget. Each is re-filed at the interval for its phase. Bots
+  // whose quantized state was answered recently reuse that answer.
+  ResponseCache.TtlSeconds = ResponseCacheTtlSeconds;
+  DueBots.Reset();
+  StaleBots.Reset();
+  ForbocAI::Bot::SchedulerOps::Advance(ObservationWheel, CurrentTime,
+                                       MaxObservationsPerFrame, DueBots);
 
-    // 1. Functional Store Tick (Heartbeat)
-    ForbocAI::State::FActionTick TickAction;
-    TickAction.DeltaTime = DeltaTime;
-    Instance.Store.Dispatch(TickAction);
+  for (const ForbocAI::Bot::FBotHandle Handle : DueBots) {
+    // Unregistered bots are dropped here, lazily
+    FBotInstance *Instance = ForbocAI::Bot::SlotMapOps::Find(Bots, Handle);
+    if (!Instance)
+      continue;
 
-    // 2. Observation Logic (Interval-based)
-    if (CurrentTime - Instance.LastObservationTime >= ObservationInterval) {
-      Instance.LastObservationTime = CurrentTime;
-      RequestNextAction(Instance);
+    // Actors can vanish without OnDestroyed (e.g. level streaming)
+    if (!Instance->BotActor.IsValid()) {
+      StaleBots.Add(Handle);
+      continue;
     }
+
+    // Sleeping bots keep their cadence but don't observe
+    const int32 Row = Instance->Row;
+    const bool bAwake = ForbocAI::Bot::LodOps::TierOf(Lod, Row) !=
+                        ForbocAI::Bot::LodOps::SleepTier(Lod);
+    if (bAwake && !TryCachedResponse(*Instance) &&
+        ForbocAI::Bot::RequestOps::Enqueue(
+            Requests, Handle, GetRequestPriority(StateTable->Phases[Row]))) {
+      Instance->Timing.Due = FPlatformTime::Seconds();
+    }
+    ForbocAI::Bot::SchedulerOps::Schedule(ObservationWheel, Handle,
+                                          GetBotObservationInterval(Row));
+  }
+
+  for (const ForbocAI::Bot::FBotHandle Handle : StaleBots) {
+    RemoveBot(Handle);
+  }
+
+  // 3. Requests (Backpressure)
+  // Abandoned requests free their slot first; then pending bots start, up
+  // to the concurrency cap. A bot that came due while its last request was
+  // still outstanding was coalesced into it above.
+  const double Now = FPlatformTime::Seconds();
+  Requests.MaxInFlight = MaxConcurrentRequests;
+  Requests.TimeoutSeconds = RequestTimeoutSeconds;
+
+  TimedOutBots.Reset();
+  ForbocAI::Bot::RequestOps::CollectTimedOut(Requests, Now, TimedOutBots);
+  if (TimedOutBots.Num() > 0) {
+    UE_LOG(LogForbocAI, Warning,
+           TEXT("BotOrchestrator: %d agent requests timed out"),
+           TimedOutBots.Num());
+  }
+
+  StartedRequests.Reset();
+  ForbocAI::Bot::RequestOps::Start(Requests, Now, StartedRequests);
+  for (const TPair<ForbocAI::Bot::FBotHandle, uint64> &Started :
+       StartedRequests) {
+    if (FBotInstance *Instance =
+            ForbocAI::Bot::SlotMapOps::Find(Bots, Started.Key)) {
+      RequestNextAction(*Instance, Started.Value);
+    } else {
+      ForbocAI::Bot::RequestOps::Cancel(Requests, Started.Key);
+    }
+  }
+
+  // 4. Batched Process
+  // A partial batch goes out once it has lingered long enough.
+  if (PendingBatch.Num() > 0 &&
+      CurrentTime - PendingBatchOpenedAt >= MaxBatchLingerSeconds) {
+    FlushAgentBatch();
+  }
+
+  SET_DWORD_STAT(STAT_ForbocAI_Bots, ForbocAI::Bot::SlotMapOps::Num(Bots));
+  SET_DWORD_STAT(STAT_ForbocAI_AwakeBots, GetAwakeBotCount());
+  SET_DWORD_STAT(STAT_ForbocAI_InFlight,
+                 ForbocAI::Bot::RequestOps::NumInFlight(Requests));
+  SET_DWORD_STAT(STAT_ForbocAI_Pending,
+                 ForbocAI::Bot::RequestOps::NumPending(Requests));
+  SET_FLOAT_STAT(STAT_ForbocAI_ActionsPerSecond,
+                 DeltaTime > 0.0f ? DrainedActions.Num() / DeltaTime : 0.0f);
+
+  // 5. Latency Dump
+  // Appended off the game thread; a dump still being written delays the
+  // next one.
+  if (LatencyCsvInterval > 0.0f && CurrentTime >= NextLatencyCsvTime &&
+      (!LatencyCsvWrite.IsValid() || LatencyCsvWrite.IsReady())) {
+    NextLatencyCsvTime = CurrentTime + LatencyCsvInterval;
+    FString Rows;
+    ForbocAI::Bot::LatencyOps::WriteCsv(Latency, CurrentTime, Rows);
+    LatencyCsvWrite = Async(EAsyncExecution::ThreadPool,
+                            [Path = LatencyCsvPath, Rows = MoveTemp(Rows)]() {
+                              return AppendLatencyCsv(Path, Rows);
+                            });
+  }
+}
+
+float ABotOrchestrator::GetObservationInterval(
+    ForbocAI::State::EBotPhase Phase) const {
+  float PhaseInterval = 0.0f;
+  switch (Phase) {
+  case ForbocAI::State::EBotPhase::Combat:
+    PhaseInterval = CombatObservationInterval;
+    break;
+  case ForbocAI::State::EBotPhase::Idle:
+    PhaseInterval = IdleObservationInterval;
+    break;
+  default:
+    break;
+  }
+  return PhaseInterval > 0.0f ? PhaseInterval : ObservationInterval;
+}
+
+float ABotOrchestrator::GetBotObservationInterval(int32 Row) const {
+  const float TierInterval =
+      Lod.Tiers[ForbocAI::Bot::LodOps::TierOf(Lod, Row)]
+          .Config.ObservationInterval;
+  return TierInterval > 0.0f ? TierInterval
+                             : GetObservationInterval(StateTable->Phases[Row]);
+}
+
+int32 ABotOrchestrator::GetRequestPriority(
+    ForbocAI::State::EBotPhase Phase) const {
+  switch (Phase) {
+  case ForbocAI::State::EBotPhase::Combat:
+    return 2;
+  case ForbocAI::State::EBotPhase::Flee:
+    return 1;
+  default:
+    return 0;
+  }
+}
+
+FBotRequestStats ABotOrchestrator::GetRequestStats() const {
+  const ForbocAI::Bot::FRequestStats &Stats = Requests.Stats;
+
+  FBotRequestStats Out;
+  Out.InFlight = ForbocAI::Bot::RequestOps::NumInFlight(Requests);
+  Out.Pending = ForbocAI::Bot::RequestOps::NumPending(Requests);
+  Out.PeakPending = Stats.PeakPending;
+  Out.Completed = Stats.Completed;
+  Out.TimedOut = Stats.TimedOut;
+  Out.Cancelled = Stats.Cancelled;
+  Out.Coalesced = Stats.Coalesced;
+  Out.AverageLatencyMs =
+      Stats.Completed > 0
+          ? (float)(Stats.TotalLatency * 1000.0 / Stats.Completed)
+          : 0.0f;
+  Out.MaxLatencyMs = (float)(Stats.MaxLatency * 1000.0);
+  return Out;
+}
+
+FBotCacheStats ABotOrchestrator::GetResponseCacheStats() const {
+  const ForbocAI::Bot::FResponseCacheStats &Stats = ResponseCache.Stats;
+
+  FBotCacheStats Out;
+  Out.Hits = Stats.Hits;
+  Out.Misses = Stats.Misses;
+  Out.Expired = Stats.Expired;
+  Out.Entries = ResponseCache.Entries.Num();
+  const uint64 Lookups = Stats.Hits + Stats.Misses;
+  Out.HitRate = Lookups > 0 ? (float)((double)Stats.Hits / Lookups) : 0.0f;
+  return Out;
+}
+
+void ABotOrchestrator::WriteBotSnapshot(TArray<uint8> &Out, bool bDirtyOnly) {
+  ForbocAI::State::SnapshotOps::Write(*StateTable, Out, bDirtyOnly);
+}
+
+int32 ABotOrchestrator::ApplyBotSnapshot(TArrayView<const uint8> Snapshot) {
+  ForbocAI::State::FBotSnapshotView View;
+  if (!ForbocAI::State::SnapshotOps::Parse(Snapshot, View)) {
+    UE_LOG(LogForbocAI, Error, TEXT("BotOrchestrator: Not a bot snapshot."));
+    return INDEX_NONE;
+  }
+
+  // Stores gather from the table on every call; only the grid keeps its
+  // own copy of positions
+  const int32 Applied = ForbocAI::State::SnapshotOps::Apply(*StateTable, View);
+  for (const FBotInstance &Instance : Bots.Dense) {
+    ForbocAI::Bot::GridOps::Update(Perception.Grid, Instance.Handle,
+                                   StateTable->Positions[Instance.Row]);
   }
+  return Applied;
+}
+
+bool ABotOrchestrator::SaveBotSnapshot(const FString &Path, bool bDirtyOnly) {
+  TArray<uint8> Bytes;
+  WriteBotSnapshot(Bytes, bDirtyOnly);
+  if (!FFileHelper::SaveArrayToFile(Bytes, *Path)) {
+    UE_LOG(LogForbocAI, Error, TEXT("BotOrchestrator: Failed to write '%s'"),
+           *Path);
+    return false;
+  }
+  return true;
+}
+
+int32 ABotOrchestrator::LoadBotSnapshot(const FString &Path) {
+  // The snapshot is read in place; the region must close before the file
+  TUniquePtr<IMappedFileHandle> File(
+      FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*Path));
+  TUniquePtr<IMappedFileRegion> Region(File ? File->MapRegion() : nullptr);
+  if (!Region) {
+    UE_LOG(LogForbocAI, Error, TEXT("BotOrchestrator: Failed to map '%s'"),
+           *Path);
+    return INDEX_NONE;
+  }
+
+  return ApplyBotSnapshot(
+      MakeArrayView(Region->GetMappedPtr(), (int32)Region->GetMappedSize()));
+}
+
+const ForbocAI::State::FActionJournal *
+ABotOrchestrator::FindBotJournal(ForbocAI::Bot::FBotHandle Bot) const {
+  const FBotInstance *Instance = ForbocAI::Bot::SlotMapOps::Find(Bots, Bot);
+  return Instance ? Instance->Journal.Get() : nullptr;
+}
+
+bool ABotOrchestrator::SaveBotJournal(AActor *Actor,
+                                      const FString &Path) const {
+  const ForbocAI::State::FActionJournal *Journal =
+      FindBotJournal(FindBot(Actor));
+  if (!Journal) {
+    UE_LOG(LogForbocAI, Warning, TEXT("BotOrchestrator: No journal for %s"),
+           Actor ? *Actor->GetName() : TEXT("null"));
+    return false;
+  }
+
+  TArray<uint8> Bytes;
+  ForbocAI::State::JournalOps::Save(*Journal, Bytes);
+  return FFileHelper::SaveArrayToFile(Bytes, *Path);
+}
+
+int32 ABotOrchestrator::GetAwakeBotCount() const {
+  return Lod.Begin[ForbocAI::Bot::LodOps::SleepTier(Lod)];
+}
+
+TArray<FBotLodTierStats> ABotOrchestrator::GetLodStats() const {
+  const int32 NumRows = ForbocAI::Bot::SlotMapOps::Num(Bots);
+
+  TArray<FBotLodTierStats> Out;
+  for (int32 Tier = 0; Tier < ForbocAI::Bot::LodOps::NumTiers(Lod); ++Tier) {
+    FBotLodTierStats &Stats = Out.AddDefaulted_GetRef();
+    Stats.Bots =
+        ForbocAI::Bot::LodOps::TierEnd(Lod, Tier, NumRows) - Lod.Begin[Tier];
+    Stats.TickDivisor = Lod.Tiers[Tier].Config.TickDivisor;
+    Stats.TickMilliseconds = (float)(Lod.Tiers[Tier].TickSeconds * 1000.0);
+  }
+  return Out;
+}
+
+TArray<FBotLatencyStats> ABotOrchestrator::GetLatencyStats() const {
+  TArray<FBotLatencyStats> Out;
+  ForbocAI::Bot::LatencyOps::ForEach(
+      Latency, [&Out](const TCHAR *Scope, const FString &Key,
+                      const ForbocAI::Bot::FLatencyHistogram &Histogram) {
+        Out.Add(MakeLatencyStats(Scope, Key, Histogram));
+      });
+  return Out;
+}
+
+FBotLatencyStats
+ABotOrchestrator::GetPersonaLatency(const FString &Persona) const {
+  const TUniquePtr<ForbocAI::Bot::FLatencyHistogram> *Histogram =
+      Latency.ByPersona.Find(Persona);
+  return Histogram ? MakeLatencyStats(TEXT("Persona"), Persona, **Histogram)
+                   : FBotLatencyStats();
+}
+
+FBotLatencyStats
+ABotOrchestrator::GetActionLatency(const FString &ActionType) const {
+  const TUniquePtr<ForbocAI::Bot::FLatencyHistogram> *Histogram =
+      Latency.ByAction.Find(ActionType);
+  return Histogram ? MakeLatencyStats(TEXT("Action"), ActionType, **Histogram)
+                   : FBotLatencyStats();
+}
+
+void ABotOrchestrator::ResetLatencyStats() {
+  ForbocAI::Bot::LatencyOps::Reset(Latency);
+}
+
+bool ABotOrchestrator::SaveLatencyCsv(const FString &Path) const {
+  FString Rows;
+  ForbocAI::Bot::LatencyOps::WriteCsv(
+      Latency, GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0, Rows);
+  return AppendLatencyCsv(Path, Rows);
+}
+
+FBotPoolStats ABotOrchestrator::GetStorePoolStats() const {
+  const ForbocAI::Bot::FStorePoolStats &Stats = StorePool.Stats;
+
+  FBotPoolStats Out;
+  Out.Live = Stats.Live;
+  Out.Capacity = ForbocAI::Bot::PoolOps::Capacity(StorePool);
+  Out.HighWater = Stats.HighWater;
+  Out.Acquired = Stats.Acquired;
+  Out.Recycled = Stats.Recycled;
+  return Out;
+}
+
+ForbocAI::Bot::FObservationKey
+ABotOrchestrator::MakeObservationKey(const FBotInstance &Instance) const {
+  ForbocAI::Bot::FObservationKeyConfig Config;
+  Config.HealthBucket = CacheHealthBucket;
+  Config.CellSize = CacheCellSize;
+
+  // Straight from the table's hot columns, no FBotState copy
+  const int32 Row = Instance.Row;
+  return ForbocAI::Bot::CacheOps::MakeKey(
+      StateTable->Stats[Row], StateTable->Positions[Row],
+      StateTable->Phases[Row], Instance.Persona, Config);
+}
+
+bool ABotOrchestrator::TryCachedResponse(const FBotInstance &Instance) {
+  if (!bCacheResponses)
+    return false;
+
+  const ForbocAI::Bot::FCachedResponse *Cached =
+      ForbocAI::Bot::CacheOps::FindEntry(ResponseCache,
+                                         MakeObservationKey(Instance),
+                                         GetWorld()->GetTimeSeconds());
+  if (!Cached)
+    return false;
+
+  // Step 7: EXECUTE (no round trip)
+  ExecuteAction(Instance, Cached->Parsed);
+  return true;
 }
 
 void ABotOrchestrator::RegisterBot(AActor *Actor, FString Persona) {
   if (!Actor)
     return;
 
-  FBotInstance Instance;
-  Instance.BotActor = Actor;
-
-  // Initialize Functional Store
-  Instance.Store = ForbocAI::Bot::Factory::CreateBotStore(Actor->GetName());
+  if (ActorHandles.Contains(FObjectKey(Actor))) {
+    UE_LOG(LogForbocAI, Warning,
+           TEXT("BotOrchestrator: '%s' already registered"),
+           *Actor->GetName());
+    return;
+  }
 
   // Initialize SDK Agent
   FAgentConfig Config;
@@ -46,64 +552,681 @@ void ABotOrchestrator::RegisterBot(AActor *Actor, FString Persona) {
 
   auto AgentResult = AgentFactory::Create(Config);
   if (AgentResult.isRight) {
-    Instance.Agent = MakeShared<const FAgent>(AgentResult.right);
-    ActiveBots.Add(Actor, Instance);
-    UE_LOG(LogTemp, Display, TEXT("BotOrchestrator: Registered Bot '%s'"),
-           *Actor->GetName());
+    CommitBot(Actor, MakeShared<const FAgent>(AgentResult.right));
   } else {
-    UE_LOG(LogTemp, Error, TEXT("BotOrchestrator: Failed to create agent: %s"),
+    UE_LOG(LogForbocAI, Error,
+           TEXT("BotOrchestrator: Failed to create agent: %s"),
            *AgentResult.left);
   }
 }
 
-void ABotOrchestrator::RequestNextAction(FBotInstance &Instance) {
+void ABotOrchestrator::RegisterBots(const TArray<AActor *> &Actors,
+                                    FString Persona) {
+  SpawnQueue.Reserve(SpawnQueue.Num() + Actors.Num());
+  for (AActor *Actor : Actors) {
+    if (Actor && !ActorHandles.Contains(FObjectKey(Actor))) {
+      SpawnQueue.Add({Actor, Persona});
+    }
+  }
+
+  // Capacity for the whole wave up front, so committing it never regrows
+  // the registry or the table mid-stream.
+  const int32 Capacity =
+      ForbocAI::Bot::SlotMapOps::Num(Bots) + GetPendingSpawnCount();
+  ForbocAI::Bot::SlotMapOps::Reserve(Bots, Capacity);
+  ForbocAI::State::TableOps::Reserve(*StateTable, Capacity);
+  ForbocAI::Bot::PoolOps::Reserve(StorePool, Capacity);
+  ActorHandles.Reserve(Capacity);
+
+  ProcessSpawnQueue();
+}
+
+int32 ABotOrchestrator::GetPendingSpawnCount() const {
+  return SpawnQueue.Num() - SpawnHead;
+}
+
+int32 ABotOrchestrator::GetScheduledBotCount() const {
+  return ObservationWheel.Num;
+}
+
+void ABotOrchestrator::ProcessSpawnQueue() {
+  struct FPreparedBot {
+    AActor *Actor = nullptr;
+    FAgentConfig Config;
+  };
+
+  const double Start = FPlatformTime::Seconds();
+  const double Budget = MaxSpawnMillisecondsPerFrame / 1000.0;
+  const FString AgentApiUrl = ApiUrl;
+
+  TArray<FPreparedBot> Prepared;
+  while (SpawnHead < SpawnQueue.Num()) {
+    const int32 Count =
+        FMath::Min(FMath::Max(1, SpawnBatchSize), GetPendingSpawnCount());
+    const FBotSpawnRequest *Slice = SpawnQueue.GetData() + SpawnHead;
+    SpawnHead += Count;
+
+    // Prepare: resolve actors here, build agent configs on worker threads.
+    // Nothing the orchestrator owns is touched until the commit below.
+    Prepared.Reset();
+    Prepared.SetNum(Count);
+    for (int32 Index = 0; Index < Count; ++Index) {
+      Prepared[Index].Actor = Slice[Index].Actor.Get();
+    }
+
+    ParallelFor(Count, [&Prepared, Slice, &AgentApiUrl](int32 Index) {
+      if (!Prepared[Index].Actor)
+        return;
+
+      FAgentConfig &Config = Prepared[Index].Config;
+      Config.Persona = Slice[Index].Persona;
+      Config.ApiUrl = AgentApiUrl;
+    });
+
+    // Commit: the whole slice lands in one game-thread pass. The SDK makes
+    // no promise that AgentFactory::Create is safe off the game thread, so
+    // agents are created here rather than in the ParallelFor.
+    for (const FPreparedBot &Bot : Prepared) {
+      if (!Bot.Actor || ActorHandles.Contains(FObjectKey(Bot.Actor)))
+        continue;
+
+      auto AgentResult = AgentFactory::Create(Bot.Config);
+      if (AgentResult.isRight) {
+        CommitBot(Bot.Actor, MakeShared<const FAgent>(AgentResult.right));
+      } else {
+        UE_LOG(LogForbocAI, Error,
+               TEXT("BotOrchestrator: Failed to create agent: %s"),
+               *AgentResult.left);
+      }
+    }
+
+    if (Budget > 0.0 && FPlatformTime::Seconds() - Start >= Budget)
+      break;
+  }
+
+  if (SpawnHead == SpawnQueue.Num()) {
+    SpawnQueue.Reset();
+    SpawnHead = 0;
+  }
+}
+
+void ABotOrchestrator::CancelPendingSpawns(const AActor *Actor) {
+  // Compact the pending tail in place; entries before SpawnHead are done
+  int32 Kept = SpawnHead;
+  for (int32 Index = SpawnHead; Index < SpawnQueue.Num(); ++Index) {
+    if (SpawnQueue[Index].Actor != Actor) {
+      SpawnQueue[Kept++] = MoveTemp(SpawnQueue[Index]);
+    }
+  }
+  SpawnQueue.SetNum(Kept, EAllowShrinking::No);
+
+  if (SpawnHead == SpawnQueue.Num()) {
+    SpawnQueue.Reset();
+    SpawnHead = 0;
+  }
+}
+
+ForbocAI::Bot::FBotHandle
+ABotOrchestrator::CommitBot(AActor *Actor, TSharedPtr<const FAgent> Agent) {
+  FBotInstance Instance;
+  Instance.BotActor = Actor;
+  Instance.ActorKey = FObjectKey(Actor);
+  Instance.Agent = MoveTemp(Agent);
+  Instance.Persona = FName(*Instance.Agent->Persona);
+
+  // Initialize Functional Store (a pooled view over this bot's table row).
+  // The row is appended in step with the registry, so Row == dense index.
+  ForbocAI::State::FBotState Initial = ForbocAI::State::CreateInitialState(
+      Actor->GetFName(), StableBotId(Actor));
+  Initial.Position = Actor->GetActorLocation();
+  Initial.Rotation = Actor->GetActorRotation();
+  Instance.Row = ForbocAI::State::TableOps::AddRow(*StateTable, Initial);
+  Instance.StoreSlot =
+      ForbocAI::Bot::PoolOps::Acquire(StorePool, *StateTable, Instance.Row);
+  Instance.Store = ForbocAI::Bot::PoolOps::CreateStore(Instance.StoreSlot);
+  if (bJournalActions) {
+    if (!HeartbeatLog) {
+      HeartbeatLog = MakeShared<ForbocAI::State::FHeartbeatLog>();
+      KeyframePass = ForbocAI::State::JournalOps::PassEnd(HeartbeatLog.Get());
+    }
+    Instance.Journal = MakeShared<ForbocAI::State::FActionJournal>();
+    Instance.Journal->MaxKeyframes = JournalMaxKeyframes;
+    ForbocAI::State::JournalOps::Begin(
+        *Instance.Journal, Instance.Store.GetState(), JournalKeyframeInterval,
+        HeartbeatLog);
+  }
+
+  Instance.SleptAt = Lod.Clock;
+  Instance.SleptAtFrame = Lod.Frame;
+
+  const ForbocAI::Bot::FBotHandle Handle =
+      ForbocAI::Bot::SlotMapOps::Add(Bots, MoveTemp(Instance));
+  check(ForbocAI::Bot::SlotMapOps::DenseIndex(Bots, Handle) ==
+        ForbocAI::State::TableOps::Num(*StateTable) - 1);
+  ForbocAI::Bot::SlotMapOps::Find(Bots, Handle)->Handle = Handle;
+  ActorHandles.Add(FObjectKey(Actor), Handle);
+
+  // The new last row belongs to the sleeping tier; bots start in the
+  // nearest one instead and the next perception pass decides otherwise.
+  ForbocAI::Bot::LodOps::Move(
+      Lod, ForbocAI::Bot::SlotMapOps::Num(Bots) - 1, 0,
+      [this](int32 A, int32 B) { SwapBotRows(A, B); });
+  RecordBotTier(Handle, 0);
+  ForbocAI::Bot::GridOps::Update(Perception.Grid, Handle, Initial.Position);
+
+  // First observation lands somewhere in the first interval, spread so
+  // bots registered together don't all fire in the same frame.
+  ForbocAI::Bot::SchedulerOps::Schedule(
+      ObservationWheel, Handle,
+      ForbocAI::Bot::SchedulerOps::SpreadOffset(RegistrationCount++,
+                                                ObservationInterval));
+
+  Actor->OnDestroyed.AddDynamic(this, &ABotOrchestrator::HandleBotDestroyed);
+
+  UE_LOG(LogForbocAI, Verbose, TEXT("BotOrchestrator: Registered Bot '%s'"),
+         *Actor->GetName());
+  return Handle;
+}
+
+void ABotOrchestrator::UnregisterBot(AActor *Actor) {
+  if (Actor && GetPendingSpawnCount() > 0) {
+    CancelPendingSpawns(Actor);
+  }
+
+  const ForbocAI::Bot::FBotHandle Handle = FindBot(Actor);
+  if (!Handle.IsSet())
+    return;
+
+  if (Actor) {
+    Actor->OnDestroyed.RemoveDynamic(this,
+                                     &ABotOrchestrator::HandleBotDestroyed);
+  }
+  RemoveBot(Handle);
+}
+
+ForbocAI::Bot::FBotHandle ABotOrchestrator::FindBot(const AActor *Actor) const {
+  const ForbocAI::Bot::FBotHandle *Handle =
+      ActorHandles.Find(FObjectKey(Actor));
+  return Handle ? *Handle : ForbocAI::Bot::FBotHandle();
+}
+
+void ABotOrchestrator::RemoveBot(ForbocAI::Bot::FBotHandle Handle) {
+  const int32 DenseIndex = ForbocAI::Bot::SlotMapOps::DenseIndex(Bots, Handle);
+  if (DenseIndex == INDEX_NONE)
+    return;
+
+  // Move the bot into the last tier first, so the swap-remove below only
+  // ever pulls a row of that same tier into the hole.
+  ForbocAI::Bot::LodOps::Move(Lod, DenseIndex,
+                              ForbocAI::Bot::LodOps::SleepTier(Lod),
+                              [this](int32 A, int32 B) { SwapBotRows(A, B); });
+  const FBotInstance *Instance = ForbocAI::Bot::SlotMapOps::Find(Bots, Handle);
+
+  ActorHandles.Remove(Instance->ActorKey);
+
+  // Late responses and queued actions for the handle now resolve to nothing;
+  // its wheel entry is dropped when it comes due.
+  ForbocAI::Bot::RequestOps::Cancel(Requests, Handle);
+  PendingBatch.RemoveAll(
+      [Handle](const auto &Item) { return Item.Bot == Handle; });
+
+  ForbocAI::Bot::PerceptionOps::Remove(Perception, Handle);
+  ForbocAI::Bot::PoolOps::Release(StorePool, Instance->StoreSlot);
+
+  // Swap-remove in the registry and mirror it in the table. The bot that
+  // moved into the hole keeps its store; only its slot's row changes.
+  const int32 Row = ForbocAI::Bot::SlotMapOps::RemoveSwap(Bots, Handle);
+  if (ForbocAI::State::TableOps::RemoveRowSwap(*StateTable, Row)) {
+    FBotInstance &Moved = Bots.Dense[Row];
+    Moved.Row = Row;
+    Moved.StoreSlot->Row = Row;
+  }
+}
+
+void ABotOrchestrator::SwapBotRows(int32 A, int32 B) {
+  if (A == B)
+    return;
+
+  ForbocAI::Bot::SlotMapOps::SwapDense(Bots, A, B);
+  ForbocAI::State::TableOps::SwapRows(*StateTable, A, B);
+  for (const int32 Row : {A, B}) {
+    FBotInstance &Instance = Bots.Dense[Row];
+    Instance.Row = Row;
+    Instance.StoreSlot->Row = Row;
+  }
+}
+
+void ABotOrchestrator::UpdatePerception(float CurrentTime) {
+  if (CurrentTime < NextPerceptionTime)
+    return;
+  NextPerceptionTime = CurrentTime + PerceptionInterval;
+  FORBOCAI_SCOPE(STAT_ForbocAI_Perception);
+
+  PlayerLocations.Reset();
+  Sightings.Reset();
+  NearBots.Reset();
+  if (bEnablePerception) {
+    for (FConstPlayerControllerIterator It =
+             GetWorld()->GetPlayerControllerIterator();
+         It; ++It) {
+      const APlayerController *Controller = It->Get();
+      if (const APawn *Pawn = Controller ? Controller->GetPawn() : nullptr) {
+        PlayerLocations.Add(Pawn->GetActorLocation());
+      }
+    }
+
+    ForbocAI::Bot::FPerceptionConfig Config;
+    Config.SpotRadius = SpotRadius;
+    Config.WakeRadius = WakeRadius;
+    ForbocAI::Bot::PerceptionOps::Sense(Perception, PlayerLocations, Config,
+                                        Sightings, NearBots);
+  }
+
+  // Only bots that just came into range; the grid remembers the rest
+  for (const auto &Sighting : Sightings) {
+    EnqueueAction(Sighting.Key,
+                  ForbocAI::State::FActionSpotEnemy{Sighting.PlayerLocation});
+  }
+
+  // Every ticking bot is re-tiered. Of the sleepers (usually most bots) only
+  // those a player came near or an action touched are looked at, unless
+  // nothing may sleep any more.
+  const bool bHasPlayers = PlayerLocations.Num() > 0;
+  const bool bWakeAll = !bHasPlayers || !bSleepDistantBots;
+  const int32 SleepBegin = GetAwakeBotCount();
+
+  TierMoves.Reset();
+  auto Consider = [this, bHasPlayers](int32 Row) {
+    const ForbocAI::Bot::FBotHandle Handle = Bots.Dense[Row].Handle;
+    const int32 Tier = ForbocAI::Bot::LodOps::PickTier(
+        Lod, StateTable->Phases[Row], bHasPlayers, NearBots.Find(Handle),
+        bSleepDistantBots);
+    if (Tier != ForbocAI::Bot::LodOps::TierOf(Lod, Row)) {
+      TierMoves.Add({Handle, Tier});
+    }
+  };
+
+  const int32 ScanEnd =
+      bWakeAll ? ForbocAI::Bot::SlotMapOps::Num(Bots) : SleepBegin;
+  for (int32 Row = 0; Row < ScanEnd; ++Row) {
+    Consider(Row);
+  }
+  if (!bWakeAll) {
+    for (const TPair<ForbocAI::Bot::FBotHandle, double> &Near : NearBots) {
+      const int32 Row = ForbocAI::Bot::SlotMapOps::DenseIndex(Bots, Near.Key);
+      if (Row >= SleepBegin) {
+        Consider(Row);
+      }
+    }
+    for (const ForbocAI::Bot::FBotHandle Handle : DisturbedSleepers) {
+      const int32 Row = ForbocAI::Bot::SlotMapOps::DenseIndex(Bots, Handle);
+      if (Row >= SleepBegin) {
+        Consider(Row);
+      }
+    }
+  }
+  DisturbedSleepers.Reset();
+
+  // Rows move as bots change tier, so moves go by handle
+  for (const TPair<ForbocAI::Bot::FBotHandle, int32> &Move : TierMoves) {
+    SetBotTier(Move.Key, Move.Value);
+  }
+}
+
+void ABotOrchestrator::SyncLodTiers() {
+  TArray<ForbocAI::Bot::FLodTierConfig> Configs;
+  for (const FBotLodTier &Tier : LodTiers) {
+    Configs.Add({Tier.MaxDistance, Tier.TickDivisor, Tier.ObservationInterval});
+  }
+  if (Configs.Num() == 0) {
+    Configs.AddDefaulted();
+  }
+  if (ForbocAI::Bot::LodOps::Matches(Lod, Configs))
+    return;
+
+  // On a sync frame only the sleepers are owed any time
+  const int32 NumRows = ForbocAI::Bot::SlotMapOps::Num(Bots);
+  if (ForbocAI::Bot::LodOps::NumTiers(Lod) > 0) {
+    for (int32 Row = GetAwakeBotCount(); Row < NumRows; ++Row) {
+      CatchUpSleeper(Bots.Dense[Row]);
+    }
+  }
+  ForbocAI::Bot::LodOps::Reset(Lod, Configs, NumRows);
+
+  // Every bot now starts out in the nearest tier
+  for (const FBotInstance &Instance : Bots.Dense) {
+    if (Instance.Journal) {
+      ForbocAI::State::JournalOps::RecordTier(*Instance.Journal, 0);
+    }
+  }
+}
+
+void ABotOrchestrator::SetBotTier(ForbocAI::Bot::FBotHandle Handle,
+                                  int32 Tier) {
+  const int32 Row = ForbocAI::Bot::SlotMapOps::DenseIndex(Bots, Handle);
+  if (Row == INDEX_NONE)
+    return;
+
+  const int32 SleepTier = ForbocAI::Bot::LodOps::SleepTier(Lod);
+  const int32 Current = ForbocAI::Bot::LodOps::TierOf(Lod, Row);
+  if (Current == Tier)
+    return;
+
+  if (Current == SleepTier) {
+    CatchUpSleeper(Bots.Dense[Row]);
+  }
+  const int32 NewRow = ForbocAI::Bot::LodOps::Move(
+      Lod, Row, Tier, [this](int32 A, int32 B) { SwapBotRows(A, B); });
+  if (Tier == SleepTier) {
+    Bots.Dense[NewRow].SleptAt = Lod.Clock;
+    Bots.Dense[NewRow].SleptAtFrame = Lod.Frame;
+  }
+  RecordBotTier(Handle, Tier);
+}
+
+void ABotOrchestrator::RecordBotTier(ForbocAI::Bot::FBotHandle Handle,
+                                     int32 Tier) {
+  const FBotInstance *Instance = ForbocAI::Bot::SlotMapOps::Find(Bots, Handle);
+  if (Instance && Instance->Journal) {
+    ForbocAI::State::JournalOps::RecordTier(*Instance->Journal, Tier);
+  }
+}
+
+void ABotOrchestrator::KeyframeJournals() {
+  const uint64 Pass = ForbocAI::State::JournalOps::PassEnd(HeartbeatLog.Get());
+  if (Pass - KeyframePass < (uint64)FMath::Max(1, JournalKeyframeInterval))
+    return;
+  KeyframePass = Pass;
+
+  // A keyframe per journal lets each drop its oldest entries; the log then
+  // only has to reach back to the oldest keyframe any journal still keeps.
+  uint64 Oldest = Pass;
+  for (const FBotInstance &Instance : Bots.Dense) {
+    if (Instance.Journal) {
+      ForbocAI::State::JournalOps::AddKeyframe(*Instance.Journal,
+                                               Instance.Store.GetState());
+      Oldest = FMath::Min(
+          Oldest, ForbocAI::State::JournalOps::OldestPass(*Instance.Journal));
+    }
+  }
+  ForbocAI::State::JournalOps::TrimLog(*HeartbeatLog, Oldest);
+}
+
+void ABotOrchestrator::CatchUpSleeper(FBotInstance &Instance) {
+  ForbocAI::State::FActionTick CatchUp;
+  CatchUp.DeltaTime = (float)(Lod.Clock - Instance.SleptAt);
+  CatchUp.Steps = (uint32)(Lod.Frame - Instance.SleptAtFrame);
+  Instance.SleptAt = Lod.Clock;
+  Instance.SleptAtFrame = Lod.Frame;
+  if (CatchUp.Steps == 0)
+    return;
+
+  const int32 Row = Instance.Row;
+  ForbocAI::State::ApplyTick(
+      StateTable->TickCounts[Row], StateTable->TimeSinceLastSeenPlayer[Row],
+      StateTable->bHasAggro[Row], CatchUp.DeltaTime, CatchUp.Steps);
+  if (Instance.Journal) {
+    ForbocAI::State::JournalOps::Record(*Instance.Journal, CatchUp,
+                                        Instance.Store.GetState());
+  }
+}
+
+void ABotOrchestrator::EnqueueAction(ForbocAI::Bot::FBotHandle Bot,
+                                     const ForbocAI::State::FBotAction &Action) {
+  PendingActions.Enqueue({Bot, Action});
+}
+
+void ABotOrchestrator::DrainPendingActions() {
+  FORBOCAI_SCOPE(STAT_ForbocAI_Reduce);
+  ForbocAI::Bot::QueueOps::Drain(PendingActions, DrainedActions,
+                                 bCoalesceQueuedTicks);
+
+  for (const ForbocAI::Bot::FQueuedBotAction &Queued : DrainedActions) {
+    // Bots can be gone by the time their action is drained
+    if (FBotInstance *Instance =
+            ForbocAI::Bot::SlotMapOps::Find(Bots, Queued.Bot)) {
+      // Sleepers are brought up to date before anything happens to them,
+      // and looked at again on the next perception pass
+      if (ForbocAI::Bot::LodOps::TierOf(Lod, Instance->Row) ==
+          ForbocAI::Bot::LodOps::SleepTier(Lod)) {
+        CatchUpSleeper(*Instance);
+        DisturbedSleepers.Add(Queued.Bot);
+      }
+
+      const ForbocAI::State::FBotState &After =
+          Instance->Store.Dispatch(Queued.Action);
+      if (std::holds_alternative<ForbocAI::State::FActionMove>(Queued.Action)) {
+        ForbocAI::Bot::GridOps::Update(Perception.Grid, Queued.Bot,
+                                       After.Position);
+      }
+      if (Instance->Journal) {
+        ForbocAI::State::JournalOps::Record(*Instance->Journal, Queued.Action,
+                                            After);
+      }
+    }
+  }
+}
+
+void ABotOrchestrator::HandleBotDestroyed(AActor *DestroyedActor) {
+  UnregisterBot(DestroyedActor);
+}
+
+void ABotOrchestrator::RequestNextAction(FBotInstance &Instance,
+                                         uint64 Token) {
   if (!Instance.Agent.IsValid())
     return;
+  FORBOCAI_SCOPE(STAT_ForbocAI_Observe);
+
+  // Remember what was asked so the answer can be cached under it
+  Instance.PendingKey = MakeObservationKey(Instance);
+  Instance.Timing.Started = FPlatformTime::Seconds();
 
   // Step 1: OBSERVE
   // Combine internal functional state with physical world state
-  ForbocAI::State::FBotState InternalState = Instance.Store.GetState();
-  FString Observation = GetStateObservation(InternalState);
+  const ForbocAI::State::FBotState &InternalState = Instance.Store.GetState();
+
+  if (!bBatchAgentRequests) {
+    FString Observation;
+    {
+      FORBOCAI_SCOPE(STAT_ForbocAI_Serialize);
+      Observation = GetStateObservation(InternalState);
+    }
+    Instance.Timing.Serialized = FPlatformTime::Seconds();
+    ProcessObservation(Instance, Observation, Token);
+    return;
+  }
+
+  // Step 2-6 deferred: the observation joins the pending batch
+  if (PendingBatch.Num() == 0) {
+    PendingBatchOpenedAt = GetWorld()->GetTimeSeconds();
+  }
+
+  ForbocAI::Bot::FAgentBatchItem &Item = PendingBatch.AddDefaulted_GetRef();
+  Item.Bot = Instance.Handle;
+  Item.Token = Token;
+  Item.AgentId = Instance.Agent->Id;
+  Item.Persona = Instance.Agent->Persona;
+  {
+    FORBOCAI_SCOPE(STAT_ForbocAI_Serialize);
+    if (bStructuredBatchObservations) {
+      Item.Observation = FString(ForbocAI::Bot::ObservationOps::TextView(
+          ObservationBuffer,
+          ForbocAI::Bot::ObservationOps::WriteJson(ObservationBuffer,
+                                                   InternalState)));
+      Item.bStructuredObservation = true;
+    } else {
+      Item.Observation = GetStateObservation(InternalState);
+    }
+  }
+  Instance.Timing.Serialized = FPlatformTime::Seconds();
+
+  if (PendingBatch.Num() >= MaxBatchSize) {
+    FlushAgentBatch();
+  }
+}
+
+void ABotOrchestrator::ProcessObservation(FBotInstance &Instance,
+                                          const FString &Observation,
+                                          uint64 Token) {
+  FORBOCAI_SCOPE(STAT_ForbocAI_Process);
 
   // Step 2-6: Protocol Pipeline (Directive -> Generate -> Verdict)
-  // Re-captured for safety in the async lambda
-  AActor *BotActor = Instance.BotActor;
+  // Only weak handles and the request token go into the async lambda, so a
+  // response for a destroyed orchestrator or a cancelled request is dropped.
+  TWeakObjectPtr<ABotOrchestrator> WeakThis(this);
+  const ForbocAI::Bot::FBotHandle Bot = Instance.Handle;
+  Instance.Timing.Sent = FPlatformTime::Seconds();
+
+  AgentOps::Process(
+      *Instance.Agent, Observation, {},
+      [WeakThis, Bot, Token](FAgentResponse Response) {
+        // Parsed here, off the game thread
+        ForbocAI::Bot::FParsedAction Action =
+            ForbocAI::Bot::ActionHandlerOps::Parse(Response.Action);
+        AsyncTask(ENamedThreads::GameThread,
+                  [WeakThis, Bot, Token, Response = MoveTemp(Response),
+                   Action = MoveTemp(Action)]() {
+                    if (ABotOrchestrator *This = WeakThis.Get()) {
+                      This->OnAgentResponse(Bot, Token, Response, Action);
+                    }
+                  });
+      });
+}
+
+void ABotOrchestrator::OnAgentResponse(
+    ForbocAI::Bot::FBotHandle Bot, uint64 Token, const FAgentResponse &Response,
+    const ForbocAI::Bot::FParsedAction &Action) {
+  const double Received = FPlatformTime::Seconds();
+  if (!ForbocAI::Bot::RequestOps::Complete(Requests, Bot, Token, Received))
+    return;
+
+  const FBotInstance *Instance = ForbocAI::Bot::SlotMapOps::Find(Bots, Bot);
+  if (!Instance)
+    return;
+
+  if (bCacheResponses) {
+    ForbocAI::Bot::CacheOps::Store(ResponseCache, Instance->PendingKey,
+                                   Response.Action, Action,
+                                   GetWorld()->GetTimeSeconds());
+  }
+
+  // Step 7: EXECUTE
+  ExecuteAction(*Instance, Action);
+  ForbocAI::Bot::LatencyOps::RecordRequest(
+      Latency, Instance->Timing, Received, FPlatformTime::Seconds(),
+      Instance->Agent.IsValid() ? Instance->Agent->Persona : FString(),
+      ForbocAI::Bot::ActionHandlerOps::StatKey(Action.Type).ToString());
+}
+
+void ABotOrchestrator::FlushAgentBatch() {
+  FORBOCAI_SCOPE(STAT_ForbocAI_Process);
+  TArray<ForbocAI::Bot::FAgentBatchItem> Items = MoveTemp(PendingBatch);
+  PendingBatch.Reset();
 
-  AgentOps::Process(*Instance.Agent, Observation, {},
-                    [this, BotActor](FAgentResponse Response) {
-                      // Step 7: EXECUTE
-                      ExecuteAction(BotActor, Response.Action);
-                    });
+  InFlightBatches.RemoveAll([](const FHttpRequestPtr &Batch) {
+    return EHttpRequestStatus::IsFinished(Batch->GetStatus());
+  });
+
+  const double Sent = FPlatformTime::Seconds();
+  for (const ForbocAI::Bot::FAgentBatchItem &Item : Items) {
+    if (FBotInstance *Instance =
+            ForbocAI::Bot::SlotMapOps::Find(Bots, Item.Bot)) {
+      Instance->Timing.Sent = Sent;
+    }
+  }
+
+  TWeakObjectPtr<ABotOrchestrator> WeakThis(this);
+  InFlightBatches.Add(ForbocAI::Bot::AgentBatchOps::Send(
+      ApiUrl + BatchProcessPath, MoveTemp(Items),
+      [WeakThis](bool bOk,
+                 const TArray<ForbocAI::Bot::FAgentBatchItem> &SentItems,
+                 TArray<FAgentResponse> Responses,
+                 TArray<ForbocAI::Bot::FParsedAction> Actions) {
+        if (ABotOrchestrator *This = WeakThis.Get()) {
+          This->OnAgentBatchComplete(bOk, SentItems, Responses, Actions);
+        }
+      }));
+}
+
+void ABotOrchestrator::OnAgentBatchComplete(
+    bool bOk, const TArray<ForbocAI::Bot::FAgentBatchItem> &Items,
+    const TArray<FAgentResponse> &Responses,
+    const TArray<ForbocAI::Bot::FParsedAction> &Actions) {
+  for (int32 Index = 0; Index < Items.Num(); ++Index) {
+    const ForbocAI::Bot::FAgentBatchItem &Item = Items[Index];
+    if (bOk) {
+      OnAgentResponse(Item.Bot, Item.Token, Responses[Index],
+                      Actions[Index]);
+      continue;
+    }
+
+    // Fallback: one Process call per bot, under the same token, with a
+    // fresh text observation (the batched one may have been structured)
+    if (!ForbocAI::Bot::RequestOps::IsCurrent(Requests, Item.Bot, Item.Token))
+      continue;
+
+    if (FBotInstance *Instance =
+            ForbocAI::Bot::SlotMapOps::Find(Bots, Item.Bot)) {
+      ProcessObservation(*Instance,
+                         GetStateObservation(Instance->Store.GetState()),
+                         Item.Token);
+    }
+  }
 }
 
-void ABotOrchestrator::ExecuteAction(AActor *BotActor,
-                                     const FAgentAction &Action) {
-  if (!BotActor || !ActiveBots.Contains(BotActor))
+void ABotOrchestrator::ExecuteAction(
+    const FBotInstance &Instance, const ForbocAI::Bot::FParsedAction &Action) {
+  AActor *BotActor = Instance.BotActor.Get();
+  if (!BotActor)
     return;
 
-  FBotInstance &Instance = ActiveBots[BotActor];
+  FORBOCAI_SCOPE(STAT_ForbocAI_Execute);
+  INC_DWORD_STAT(STAT_ForbocAI_Executed);
+  UE_LOG(LogForbocAI, Verbose, TEXT("BotOrchestrator: Executing '%s' for %s"),
+         *Action.Type.ToString(), *BotActor->GetName());
+
+  // Map SDK Action -> Functional Action -> Queue for the next drain
+  ForbocAI::Bot::FActionSubject Subject;
+  Subject.Actor = BotActor;
+  Subject.Location = BotActor->GetActorLocation();
+  ForbocAI::State::FBotAction StoreAction;
+  if (ForbocAI::Bot::ActionHandlerOps::Build(ActionHandlers, Action, Subject,
+                                             StoreAction)) {
+    EnqueueAction(Instance.Handle, StoreAction);
+    return;
+  }
 
-  UE_LOG(LogTemp, Display, TEXT("BotOrchestrator: Executing '%s' for %s"),
-         *Action.Type, *BotActor->GetName());
+  // Warn the first time a type turns up that nothing handles
+  const FName Key = ForbocAI::Bot::ActionHandlerOps::StatKey(Action.Type);
+  const uint64 *Unhandled = ActionHandlers.Unhandled.Find(Key);
+  if (Unhandled && *Unhandled == 1) {
+    UE_LOG(LogForbocAI, Warning,
+           TEXT("BotOrchestrator: No handler for action type '%s'"),
+           *Key.ToString());
+  }
+}
+
+void ABotOrchestrator::RegisterActionHandler(
+    FName Type, ForbocAI::Bot::FActionBuilder Builder) {
+  ForbocAI::Bot::ActionHandlerOps::Register(ActionHandlers, Type,
+                                            MoveTemp(Builder));
+}
 
-  // Map SDK Action -> Functional Action -> Dispatch to Store
-  if (Action.Type == TEXT("MOVE")) {
-    ForbocAI::State::FActionMove Move;
-    // Simple mock: Move to target if specified in target field
-    // In a real game, would parse the observation context or payload
-    Move.TargetLocation = BotActor->GetActorLocation() + FVector(500, 0, 0);
-    Move.Speed = 100.0f;
-    Instance.Store.Dispatch(Move);
-  } else if (Action.Type == TEXT("ATTACK")) {
-    ForbocAI::State::FActionAttack Attack;
-    Instance.Store.Dispatch(Attack);
+FBotActionStats ABotOrchestrator::GetActionStats() const {
+  FBotActionStats Out;
+  Out.Built = ActionHandlers.Stats.Built;
+  Out.Unhandled = ActionHandlers.Stats.Unhandled;
+  for (const auto &Entry : ActionHandlers.Unhandled) {
+    Out.UnhandledTypes.Add(Entry.Key, Entry.Value);
   }
-  // ... and so on
+  return Out;
 }
 
 FString
 ABotOrchestrator::GetStateObservation(const ForbocAI::State::FBotState &State) {
-  return FString::Printf(
-      TEXT("Name: %s, Health: %.1f, Position: %s, Phase: %d"), *State.Name,
-      State.Stats.Health, *State.Position.ToString(), (int32)State.Phase);
+  // Formatted in the frame's pooled buffer; the SDK takes an FString, so the
+  // only allocation left is this final copy.
+  return FString(ForbocAI::Bot::ObservationOps::TextView(
+      ObservationBuffer,
+      ForbocAI::Bot::ObservationOps::WriteText(ObservationBuffer, State)));
 }
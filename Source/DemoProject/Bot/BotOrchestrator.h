@@ -1,24 +1,268 @@
 #pragma once
 
 #include "AgentModule.h"
+#include "Async/Future.h"
+#include "Bot/ActionHandlers.h"
+#include "Bot/ActionQueue.h"
+#include "Bot/AgentBatch.h"
+#include "Bot/LatencyHistogram.h"
+#include "Bot/LodTiers.h"
 #include "Bot/Factories/BotFactory.h"
+#include "Bot/ObservationScheduler.h"
+#include "Bot/ObservationWriter.h"
+#include "Bot/ParallelTick.h"
+#include "Bot/RequestTracker.h"
+#include "Bot/ResponseCache.h"
+#include "Bot/SlotMap.h"
+#include "Bot/SpatialGrid.h"
+#include "Bot/StorePool.h"
+#include "State/ActionJournal.h"
+#include "State/BotSnapshot.h"
+#include "State/BotStateTable.h"
+#include <memory>
 #include "BotOrchestrator.generated.h"
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "UObject/ObjectKey.h"
 
 /**
  * FBotInstance - Managed data for a single AI Bot entity.
  * Bridges the physical Actor, the Functional State Store, and the SDK Agent.
  */
 struct FBotInstance {
-  AActor *BotActor;
+  /** Weak, so a destroyed actor is noticed instead of dereferenced. */
+  TWeakObjectPtr<AActor> BotActor;
+  /**
+   * BotActor's key in the orchestrator's ActorHandles. Unlike the weak
+   * pointer it stays distinct once the actor is gone, so the right entry is
+   * removed.
+   */
+  FObjectKey ActorKey;
   TSharedPtr<const FAgent> Agent;
+  /** This bot's own handle in the orchestrator's registry. */
+  ForbocAI::Bot::FBotHandle Handle;
+  /**
+   * Row of this bot in the orchestrator's FBotStateTable. Equal to its dense
+   * index in the registry; changes when another bot is swap-removed and
+   * when this one falls asleep or wakes up.
+   */
+  int32 Row;
+  /** Pooled slot backing Store; follows the bot when its Row changes. */
+  ForbocAI::Bot::FStoreSlot *StoreSlot;
+  /** View over Row; dispatches reduce straight into the table. */
   ForbocAI::Bot::FBotStore Store;
-  float LastObservationTime;
+  /** Agent->Persona as a name, part of the response cache key. */
+  FName Persona;
+  /** Cache key of the observation currently in flight. */
+  ForbocAI::Bot::FObservationKey PendingKey;
+  /** Where the request in flight is in the pipeline, and since when. */
+  ForbocAI::Bot::FRequestTiming Timing;
+  /** Every action reduced into this bot (only with bJournalActions). */
+  TSharedPtr<ForbocAI::State::FActionJournal> Journal;
+  /** LOD clock and frame when the bot fell asleep, to catch it up. */
+  double SleptAt;
+  uint64 SleptAtFrame;
 
   FBotInstance()
-      : BotActor(nullptr), Agent(nullptr), Store({}),
-        LastObservationTime(0.0f) {}
+      : Agent(nullptr), Row(INDEX_NONE), StoreSlot(nullptr), Store({}),
+        SleptAt(0.0), SleptAtFrame(0) {}
+};
+
+/**
+ * FBotSpawnRequest - An actor waiting in a RegisterBots wave.
+ */
+struct FBotSpawnRequest {
+  TWeakObjectPtr<AActor> Actor;
+  FString Persona;
+};
+
+/**
+ * FBotRequestStats - Snapshot of the orchestrator's agent request traffic.
+ */
+USTRUCT(BlueprintType)
+struct FBotRequestStats {
+  GENERATED_BODY()
+
+  /** Requests waiting for a reply. */
+  UPROPERTY(BlueprintReadOnly, Category = "ForbocAI")
+  int32 InFlight = 0;
+
+  /** Bots waiting for a free request slot. */
+  UPROPERTY(BlueprintReadOnly, Category = "ForbocAI")
+  int32 Pending = 0;
+
+  /** Deepest the pending queue has been. */
+  UPROPERTY(BlueprintReadOnly, Category = "ForbocAI")
+  int32 PeakPending = 0;
+
+  UPROPERTY(BlueprintReadOnly, Category = "ForbocAI")
+  int64 Completed = 0;
+
+  UPROPERTY(BlueprintReadOnly, Category = "ForbocAI")
+  int64 TimedOut = 0;
+
+  UPROPERTY(BlueprintReadOnly, Category = "ForbocAI")
+  int64 Cancelled = 0;
+
+  /** Observations skipped because the bot's last request was outstanding. */
+  UPROPERTY(BlueprintReadOnly, Category = "ForbocAI")
+  int64 Coalesced = 0;
+
+  UPROPERTY(BlueprintReadOnly, Category = "ForbocAI")
+  float AverageLatencyMs = 0.0f;
+
+  UPROPERTY(BlueprintReadOnly, Category = "ForbocAI")
+  float MaxLatencyMs = 0.0f;
+};
+
+/**
+ * FBotCacheStats - Snapshot of the orchestrator's response cache.
+ */
+USTRUCT(BlueprintType)
+struct FBotCacheStats {
+  GENERATED_BODY()
+
+  UPROPERTY(BlueprintReadOnly, Category = "ForbocAI")
+  int64 Hits = 0;
+
+  UPROPERTY(BlueprintReadOnly, Category = "ForbocAI")
+  int64 Misses = 0;
+
+  /** Misses caused by an entry outliving its TTL. */
+  UPROPERTY(BlueprintReadOnly, Category = "ForbocAI")
+  int64 Expired = 0;
+
+  UPROPERTY(BlueprintReadOnly, Category = "ForbocAI")
+  int32 Entries = 0;
+
+  /** Hits / (Hits + Misses). */
+  UPROPERTY(BlueprintReadOnly, Category = "ForbocAI")
+  float HitRate = 0.0f;
+};
+
+/**
+ * FBotPoolStats - Snapshot of the pool backing the bots' state stores.
+ */
+USTRUCT(BlueprintType)
+struct FBotPoolStats {
+  GENERATED_BODY()
+
+  /** Slots held by registered bots. */
+  UPROPERTY(BlueprintReadOnly, Category = "ForbocAI")
+  int32 Live = 0;
+
+  /** Slots allocated, live or free. */
+  UPROPERTY(BlueprintReadOnly, Category = "ForbocAI")
+  int32 Capacity = 0;
+
+  /** Most slots live at once. */
+  UPROPERTY(BlueprintReadOnly, Category = "ForbocAI")
+  int32 HighWater = 0;
+
+  UPROPERTY(BlueprintReadOnly, Category = "ForbocAI")
+  int64 Acquired = 0;
+
+  /** Acquires served by a slot an unregistered bot gave back. */
+  UPROPERTY(BlueprintReadOnly, Category = "ForbocAI")
+  int64 Recycled = 0;
+};
+
+/**
+ * FBotLodTier - One AI level of detail: how near a player a bot must be to
+ * get it, and how often bots in it tick and observe.
+ */
+USTRUCT(BlueprintType)
+struct FBotLodTier {
+  GENERATED_BODY()
+
+  /** Nearest player within this distance (the last tier takes the rest). */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ForbocAI",
+            meta = (ClampMin = "0"))
+  float MaxDistance = 0.0f;
+
+  /** Frames per heartbeat, rounded up to a power of two. */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ForbocAI",
+            meta = (ClampMin = "1", ClampMax = "1024"))
+  int32 TickDivisor = 1;
+
+  /** Seconds between observations (0 = the interval for the bot's phase). */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ForbocAI",
+            meta = (ClampMin = "0"))
+  float ObservationInterval = 0.0f;
+};
+
+/**
+ * FBotLodTierStats - Occupancy and heartbeat cost of one LOD tier.
+ */
+USTRUCT(BlueprintType)
+struct FBotLodTierStats {
+  GENERATED_BODY()
+
+  UPROPERTY(BlueprintReadOnly, Category = "ForbocAI")
+  int32 Bots = 0;
+
+  /** Frames per heartbeat (0 for the sleeping tier). */
+  UPROPERTY(BlueprintReadOnly, Category = "ForbocAI")
+  int32 TickDivisor = 0;
+
+  /** Game-thread time spent ticking the tier, averaged per frame. */
+  UPROPERTY(BlueprintReadOnly, Category = "ForbocAI")
+  float TickMilliseconds = 0.0f;
+};
+
+/**
+ * FBotLatencyStats - Percentiles of one observe -> execute latency
+ * histogram, in milliseconds.
+ */
+USTRUCT(BlueprintType)
+struct FBotLatencyStats {
+  GENERATED_BODY()
+
+  /** "Stage", "Persona" or "Action". */
+  UPROPERTY(BlueprintReadOnly, Category = "ForbocAI")
+  FString Scope;
+
+  /** Pipeline stage, persona or action type. */
+  UPROPERTY(BlueprintReadOnly, Category = "ForbocAI")
+  FString Key;
+
+  UPROPERTY(BlueprintReadOnly, Category = "ForbocAI")
+  int64 Count = 0;
+
+  UPROPERTY(BlueprintReadOnly, Category = "ForbocAI")
+  float MeanMs = 0.0f;
+
+  UPROPERTY(BlueprintReadOnly, Category = "ForbocAI")
+  float P50Ms = 0.0f;
+
+  UPROPERTY(BlueprintReadOnly, Category = "ForbocAI")
+  float P95Ms = 0.0f;
+
+  UPROPERTY(BlueprintReadOnly, Category = "ForbocAI")
+  float P99Ms = 0.0f;
+
+  UPROPERTY(BlueprintReadOnly, Category = "ForbocAI")
+  float MaxMs = 0.0f;
+};
+
+/**
+ * FBotActionStats - What became of the actions the agents answered with.
+ */
+USTRUCT(BlueprintType)
+struct FBotActionStats {
+  GENERATED_BODY()
+
+  /** Actions turned into store actions. */
+  UPROPERTY(BlueprintReadOnly, Category = "ForbocAI")
+  int64 Built = 0;
+
+  /** Actions of a type with no handler. */
+  UPROPERTY(BlueprintReadOnly, Category = "ForbocAI")
+  int64 Unhandled = 0;
+
+  /** Unhandled, by action type; types nothing registered under Unknown. */
+  UPROPERTY(BlueprintReadOnly, Category = "ForbocAI")
+  TMap<FName, int64> UnhandledTypes;
 };
 
 /**
@@ -34,6 +278,7 @@ public:
 
 protected:
   virtual void BeginPlay() override;
+  virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
   virtual void Tick(float DeltaTime) override;
 
 public:
@@ -41,23 +286,513 @@ public:
   UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ForbocAI")
   float ObservationInterval = 5.0f;
 
+  /** Observation interval for bots in Combat (0 = ObservationInterval). */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ForbocAI",
+            meta = (ClampMin = "0"))
+  float CombatObservationInterval = 0.0f;
+
+  /** Observation interval for bots in Idle (0 = ObservationInterval). */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ForbocAI",
+            meta = (ClampMin = "0"))
+  float IdleObservationInterval = 0.0f;
+
+  /**
+   * Most observations started per frame (0 = unlimited). Bots over budget
+   * stay due and go first next frame.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ForbocAI",
+            meta = (ClampMin = "0"))
+  int32 MaxObservationsPerFrame = 32;
+
   /** API URL for the SDK. */
   UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ForbocAI")
   FString ApiUrl = TEXT("http://localhost:8080");
 
+  /** Reduce the per-frame heartbeat on worker threads instead of inline. */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ForbocAI|Performance")
+  bool bParallelTick = false;
+
+  /** Bots per parallel work item. */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ForbocAI|Performance",
+            meta = (ClampMin = "1"))
+  int32 ParallelChunkSize = 1024;
+
+  /** Cap on concurrently running work items (0 = all worker threads). */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ForbocAI|Performance",
+            meta = (ClampMin = "0"))
+  int32 ParallelMaxWorkers = 0;
+
+  /**
+   * Most agent requests in flight at once (0 = unlimited). Further due bots
+   * wait in a queue, Combat bots first.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ForbocAI|Requests",
+            meta = (ClampMin = "0"))
+  int32 MaxConcurrentRequests = 16;
+
+  /** Seconds before an unanswered request is abandoned (0 = never). */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ForbocAI|Requests",
+            meta = (ClampMin = "0"))
+  float RequestTimeoutSeconds = 15.0f;
+
+  /**
+   * Reuse a recent action for bots whose quantized state (health bucket,
+   * grid cell, phase) and persona match an answered observation. Off by
+   * default: bots that match then act alike without asking the agent.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ForbocAI|Cache")
+  bool bCacheResponses = false;
+
+  /** Most cached actions kept; least recently used go first. */
+  UPROPERTY(EditAnywhere, Category = "ForbocAI|Cache",
+            meta = (ClampMin = "1"))
+  int32 ResponseCacheSize = 1024;
+
+  /** Seconds (game time) a cached action stays valid. */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ForbocAI|Cache",
+            meta = (ClampMin = "0"))
+  float ResponseCacheTtlSeconds = 30.0f;
+
+  /** Health bucket width for the cache key, as a fraction of MaxHealth. */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ForbocAI|Cache",
+            meta = (ClampMin = "0.01", ClampMax = "1"))
+  float CacheHealthBucket = 0.1f;
+
+  /** Grid cell edge (world units) for the cache key. */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ForbocAI|Cache",
+            meta = (ClampMin = "1"))
+  float CacheCellSize = 500.0f;
+
+  /**
+   * Send observations as multi-agent batches instead of one Process call
+   * per bot. Needs a backend that serves BatchProcessPath; failed batches
+   * fall back to per-bot calls.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ForbocAI|Batching")
+  bool bBatchAgentRequests = false;
+
+  /** Path under ApiUrl of the multi-agent process endpoint. */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ForbocAI|Batching")
+  FString BatchProcessPath = TEXT("/agents/process/batch");
+
+  /**
+   * Send batched observations as JSON objects rather than the text line
+   * used by per-bot Process calls. The backend must accept both.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ForbocAI|Batching")
+  bool bStructuredBatchObservations = false;
+
+  /** A batch is sent as soon as it holds this many observations. */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ForbocAI|Batching",
+            meta = (ClampMin = "1"))
+  int32 MaxBatchSize = 32;
+
+  /** Longest (in seconds) a partial batch waits for more observations. */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ForbocAI|Batching",
+            meta = (ClampMin = "0"))
+  float MaxBatchLingerSeconds = 0.05f;
+
+  /** Bots prepared and committed together by RegisterBots. */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ForbocAI|Spawning",
+            meta = (ClampMin = "1"))
+  int32 SpawnBatchSize = 64;
+
+  /**
+   * Game-thread time (ms) RegisterBots may spend per frame; at least one
+   * batch always goes through (0 = register the whole wave at once).
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ForbocAI|Spawning",
+            meta = (ClampMin = "0"))
+  float MaxSpawnMillisecondsPerFrame = 2.0f;
+
+  /**
+   * Record every action reduced into each bot so its states can be replayed
+   * offline. Heartbeats are logged once per tier pass and shared by every
+   * journal. Applies to bots registered afterwards.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ForbocAI|Debug")
+  bool bJournalActions = false;
+
+  /**
+   * Journal entries, and tier passes, between replay keyframes. Each pass
+   * interval every journal is keyframed and the heartbeat log trimmed.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ForbocAI|Debug",
+            meta = (ClampMin = "1"))
+  int32 JournalKeyframeInterval = 256;
+
+  /**
+   * Keyframes each journal keeps (0 = all). Entries older than the oldest
+   * one kept are dropped, which bounds the journal's memory.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ForbocAI|Debug",
+            meta = (ClampMin = "0"))
+  int32 JournalMaxKeyframes = 64;
+
+  /**
+   * Seconds between appending the latency histograms to
+   * Saved/Profiling/ForbocAI/Latency-<time>.csv (0 = never). Rows are
+   * cumulative since the last ResetLatencyStats.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ForbocAI|Debug",
+            meta = (ClampMin = "0"))
+  float LatencyCsvInterval = 0.0f;
+
+  /**
+   * Track bots in a spatial grid and check it against the player pawns
+   * every PerceptionInterval. A bot coming within SpotRadius of a player
+   * gets one FActionSpotEnemy.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ForbocAI|Perception")
+  bool bEnablePerception = true;
+
+  /** Distance at which a bot spots a player. */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ForbocAI|Perception",
+            meta = (ClampMin = "0"))
+  float SpotRadius = 1500.0f;
+
+  /** Seconds between perception passes (run on the next LOD sync frame). */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ForbocAI|Perception",
+            meta = (ClampMin = "0"))
+  float PerceptionInterval = 0.25f;
+
+  /** Edge (world units) of a perception grid cell; applied at BeginPlay. */
+  UPROPERTY(EditAnywhere, Category = "ForbocAI|Perception",
+            meta = (ClampMin = "1"))
+  float PerceptionCellSize = 2000.0f;
+
+  /**
+   * Put bots farther than WakeRadius from every player to sleep: no
+   * heartbeat and no observations until a player comes near (or an action
+   * puts them in combat). Nothing sleeps while there are no players.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ForbocAI|Perception")
+  bool bSleepDistantBots = true;
+
+  /** Distance within which a player keeps bots awake. */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ForbocAI|Perception",
+            meta = (ClampMin = "0"))
+  float WakeRadius = 5000.0f;
+
+  /**
+   * AI levels of detail, nearest first. Each perception pass puts a bot in
+   * the first tier whose MaxDistance reaches its nearest player; bots in
+   * Combat or Flee always get the first. Tiers only change every few frames
+   * (the largest TickDivisor), when no tier has time carried over.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ForbocAI|Perception")
+  TArray<FBotLodTier> LodTiers;
+
+  /** Fold back-to-back queued ticks for the same bot into one reduction. */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ForbocAI")
+  bool bCoalesceQueuedTicks = true;
+
   /** Register a physical actor as a managed bot. */
   UFUNCTION(BlueprintCallable, Category = "ForbocAI")
   void RegisterBot(AActor *Actor, FString Persona);
 
+  /**
+   * Register a wave of actors sharing one persona. Capacity for the whole
+   * wave is reserved up front; agent configs are built on worker threads in
+   * slices of SpawnBatchSize and each slice is committed in one go. Bots
+   * that don't fit in MaxSpawnMillisecondsPerFrame register over the
+   * following frames.
+   */
+  UFUNCTION(BlueprintCallable, Category = "ForbocAI")
+  void RegisterBots(const TArray<AActor *> &Actors, FString Persona);
+
+  /** Actors queued by RegisterBots and not registered yet. */
+  UFUNCTION(BlueprintPure, Category = "ForbocAI")
+  int32 GetPendingSpawnCount() const;
+
+  /**
+   * Bots waiting in the observation schedule. Unregistered bots count until
+   * they come due and are dropped.
+   */
+  UFUNCTION(BlueprintPure, Category = "ForbocAI")
+  int32 GetScheduledBotCount() const;
+
+  /**
+   * Stop managing a bot. Its outstanding requests are cancelled and the last
+   * bot's state is swapped into its row. An actor still waiting in a
+   * RegisterBots wave is taken out of the wave instead.
+   */
+  UFUNCTION(BlueprintCallable, Category = "ForbocAI")
+  void UnregisterBot(AActor *Actor);
+
+  /** Handle of a registered actor (unset if not registered). */
+  ForbocAI::Bot::FBotHandle FindBot(const AActor *Actor) const;
+
+  /**
+   * Queue an action for a bot. Safe to call from any thread; the action is
+   * reduced on the game thread at the start of the next Tick.
+   */
+  void EnqueueAction(ForbocAI::Bot::FBotHandle Bot,
+                     const ForbocAI::State::FBotAction &Action);
+
+  /**
+   * Build the store action for agent actions of Type with Builder, replacing
+   * its current handler. MOVE and ATTACK are handled out of the box.
+   */
+  void RegisterActionHandler(FName Type, ForbocAI::Bot::FActionBuilder Builder);
+
+  /** Handled and unhandled agent actions, by type. */
+  UFUNCTION(BlueprintPure, Category = "ForbocAI")
+  FBotActionStats GetActionStats() const;
+
+  /** Request traffic: in-flight/pending depth and latency. */
+  UFUNCTION(BlueprintPure, Category = "ForbocAI")
+  FBotRequestStats GetRequestStats() const;
+
+  /** Response cache hit/miss counters. */
+  UFUNCTION(BlueprintPure, Category = "ForbocAI")
+  FBotCacheStats GetResponseCacheStats() const;
+
+  /**
+   * Write the state of every bot (or only those changed by an action since
+   * the last snapshot) to Path in the State/BotSnapshot.h format.
+   */
+  UFUNCTION(BlueprintCallable, Category = "ForbocAI")
+  bool SaveBotSnapshot(const FString &Path, bool bDirtyOnly = false);
+
+  /**
+   * Memory-map a snapshot file and restore it onto the registered bots,
+   * matched by state Id. A bot's Id is derived from its actor's path, so a
+   * snapshot from an earlier session restores onto the same actors once
+   * they've registered again. Returns the number restored, or -1 if the
+   * file can't be read as a snapshot.
+   */
+  UFUNCTION(BlueprintCallable, Category = "ForbocAI")
+  int32 LoadBotSnapshot(const FString &Path);
+
+  /** In-memory forms of SaveBotSnapshot / LoadBotSnapshot. */
+  void WriteBotSnapshot(TArray<uint8> &Out, bool bDirtyOnly = false);
+  int32 ApplyBotSnapshot(TArrayView<const uint8> Snapshot);
+
+  /** Write a bot's action journal to Path (see State/ActionJournal.h). */
+  UFUNCTION(BlueprintCallable, Category = "ForbocAI")
+  bool SaveBotJournal(AActor *Actor, const FString &Path) const;
+
+  /** A bot's action journal, or null if it isn't journaled. */
+  const ForbocAI::State::FActionJournal *
+  FindBotJournal(ForbocAI::Bot::FBotHandle Bot) const;
+
+  /** Bots currently ticking (the rest are asleep). */
+  UFUNCTION(BlueprintPure, Category = "ForbocAI")
+  int32 GetAwakeBotCount() const;
+
+  /** Per LodTiers entry, then the sleeping bots: counts and tick cost. */
+  UFUNCTION(BlueprintPure, Category = "ForbocAI")
+  TArray<FBotLodTierStats> GetLodStats() const;
+
+  /** Occupancy and high-water mark of the bot store pool. */
+  UFUNCTION(BlueprintPure, Category = "ForbocAI")
+  FBotPoolStats GetStorePoolStats() const;
+
+  /**
+   * Observe -> execute latency of answered requests: every pipeline stage
+   * (Queue, Serialize, Batch, Protocol, Dispatch, Total), then the Total
+   * per persona and per action type. Cached responses aren't included.
+   */
+  UFUNCTION(BlueprintPure, Category = "ForbocAI")
+  TArray<FBotLatencyStats> GetLatencyStats() const;
+
+  /** Total latency of requests from bots with Persona. */
+  UFUNCTION(BlueprintPure, Category = "ForbocAI")
+  FBotLatencyStats GetPersonaLatency(const FString &Persona) const;
+
+  /**
+   * Total latency of requests answered with ActionType. Types nothing
+   * registered are recorded together as "Unknown".
+   */
+  UFUNCTION(BlueprintPure, Category = "ForbocAI")
+  FBotLatencyStats GetActionLatency(const FString &ActionType) const;
+
+  UFUNCTION(BlueprintCallable, Category = "ForbocAI")
+  void ResetLatencyStats();
+
+  /** Append the latency histograms to a CSV file at Path. */
+  UFUNCTION(BlueprintCallable, Category = "ForbocAI")
+  bool SaveLatencyCsv(const FString &Path) const;
+
 private:
-  /** Internal registry of active bots. */
-  TMap<AActor *, FBotInstance> ActiveBots;
+  /**
+   * Internal registry of active bots, packed in table row order, which is
+   * grouped by LOD tier.
+   */
+  ForbocAI::Bot::TSlotMap<FBotInstance> Bots;
+
+  /** Row ranges, carried time and cost of each LOD tier. */
+  ForbocAI::Bot::FLodPartition Lod;
 
-  /** Multi-Round Protocol: Observe & Process */
-  void RequestNextAction(FBotInstance &Instance);
+  /** Actor -> handle, for registration and unregistration by actor. */
+  TMap<FObjectKey, ForbocAI::Bot::FBotHandle> ActorHandles;
+
+  /** SoA state of every registered bot, one row per FBotInstance. */
+  std::shared_ptr<ForbocAI::State::FBotStateTable> StateTable;
+
+  /** Recycled backing storage for each bot's store view. */
+  ForbocAI::Bot::FBotStorePool StorePool;
+
+  /**
+   * Bots filed under the tick of their next observation. Unregistered bots
+   * are left in place and dropped when they come due.
+   */
+  ForbocAI::Bot::TObservationWheel<ForbocAI::Bot::FBotHandle> ObservationWheel;
+
+  /** Bots handed out by the wheel this frame (reused buffer). */
+  TArray<ForbocAI::Bot::FBotHandle> DueBots;
+
+  /** Due bots whose actor turned out to be gone (reused buffer). */
+  TArray<ForbocAI::Bot::FBotHandle> StaleBots;
+
+  /** RegisterBots waves; entries before SpawnHead are done. */
+  TArray<FBotSpawnRequest> SpawnQueue;
+  int32 SpawnHead = 0;
+
+  /** Register queued spawns, slice by slice, within the frame budget. */
+  void ProcessSpawnQueue();
+
+  /** Drop Actor's entries not yet reached in SpawnQueue. */
+  void CancelPendingSpawns(const AActor *Actor);
+
+  /** Add a bot whose agent is ready to the registry and the table. */
+  ForbocAI::Bot::FBotHandle CommitBot(AActor *Actor,
+                                      TSharedPtr<const FAgent> Agent);
+
+  /** Swap-remove a bot from the registry and the state table. */
+  void RemoveBot(ForbocAI::Bot::FBotHandle Handle);
+
+  /** Exchange two bots' rows in the registry and the table. */
+  void SwapBotRows(int32 A, int32 B);
+
+  /** Bot positions, the bots spotting a player, and the next pass time. */
+  ForbocAI::Bot::TPerception<ForbocAI::Bot::FBotHandle> Perception;
+  float NextPerceptionTime = 0.0f;
+
+  /** Reused buffers for the perception pass. */
+  TArray<FVector> PlayerLocations;
+  TArray<ForbocAI::Bot::TSighting<ForbocAI::Bot::FBotHandle>> Sightings;
+  TMap<ForbocAI::Bot::FBotHandle, double> NearBots;
+  TArray<TPair<ForbocAI::Bot::FBotHandle, int32>> TierMoves;
+
+  /** Sleeping bots that had an action reduced since the last pass. */
+  TSet<ForbocAI::Bot::FBotHandle> DisturbedSleepers;
+
+  /** Spot players and re-tier bots. Only called on LOD sync frames. */
+  void UpdatePerception(float CurrentTime);
+
+  /** Reset the tiers to LodTiers if it changed, waking every sleeper. */
+  void SyncLodTiers();
+
+  /** Move a bot to Tier, catching it up if it was asleep. */
+  void SetBotTier(ForbocAI::Bot::FBotHandle Handle, int32 Tier);
+
+  /** Reduce the heartbeats a sleeping bot missed, in one FActionTick. */
+  void CatchUpSleeper(FBotInstance &Instance);
+
+  /** Heartbeats of every tier pass, shared by all bot journals. */
+  TSharedPtr<ForbocAI::State::FHeartbeatLog> HeartbeatLog;
+  uint64 KeyframePass = 0;
+
+  /** Note in a journaled bot's journal that it moved to Tier. */
+  void RecordBotTier(ForbocAI::Bot::FBotHandle Handle, int32 Tier);
+
+  /** Every JournalKeyframeInterval passes, keyframe and trim the journals. */
+  void KeyframeJournals();
+
+  /** Interval until the next observation of the bot in Row. */
+  float GetBotObservationInterval(int32 Row) const;
+
+  /** Registrations so far; seeds each bot's spread-out first observation. */
+  uint32 RegistrationCount = 0;
+
+  /** Interval until the next observation of a bot in Phase. */
+  float GetObservationInterval(ForbocAI::State::EBotPhase Phase) const;
+
+  /** Actions waiting for the next drain (MPSC, any thread -> game thread). */
+  ForbocAI::Bot::FBotActionQueue PendingActions;
+
+  /** Reused drain buffer, so draining doesn't allocate once warmed up. */
+  TArray<ForbocAI::Bot::FQueuedBotAction> DrainedActions;
+
+  /** Reduce everything in PendingActions, in enqueue order. */
+  void DrainPendingActions();
+
+  /** Per-bot in-flight requests, the concurrency cap and pending queue. */
+  ForbocAI::Bot::TRequestTracker<ForbocAI::Bot::FBotHandle> Requests;
+
+  /** Reused buffers for the request pass. */
+  TArray<TPair<ForbocAI::Bot::FBotHandle, uint64>> StartedRequests;
+  TArray<ForbocAI::Bot::FBotHandle> TimedOutBots;
+
+  /** Batch HTTP requests that may still be running, for cancellation. */
+  TArray<FHttpRequestPtr> InFlightBatches;
+
+  /** Observe -> execute latency, by stage, persona and action type. */
+  ForbocAI::Bot::FLatencyRecorder Latency;
+
+  /** Where and when the periodic CSV dump goes, and the one in progress. */
+  FString LatencyCsvPath;
+  float NextLatencyCsvTime = 0.0f;
+  TFuture<bool> LatencyCsvWrite;
+
+  /** Agent action type -> store action builder. */
+  ForbocAI::Bot::FActionHandlerTable ActionHandlers;
+
+  /** Recently answered observations, by quantized state. */
+  ForbocAI::Bot::FResponseCache ResponseCache;
+
+  /** Quantized key of Instance's current state. */
+  ForbocAI::Bot::FObservationKey
+  MakeObservationKey(const FBotInstance &Instance) const;
+
+  /** Execute a cached action for Instance if there is one. */
+  bool TryCachedResponse(const FBotInstance &Instance);
+
+  /** Pending-queue priority of a bot in Phase (higher goes first). */
+  int32 GetRequestPriority(ForbocAI::State::EBotPhase Phase) const;
+
+  /** Pooled per-frame storage for observation strings. */
+  ForbocAI::Bot::FObservationBuffer ObservationBuffer;
+
+  /** Observations waiting to be sent as one batch. */
+  TArray<ForbocAI::Bot::FAgentBatchItem> PendingBatch;
+
+  /** World time the oldest entry in PendingBatch was added. */
+  float PendingBatchOpenedAt = 0.0f;
+
+  /** Multi-Round Protocol: Observe & Process (Token from Requests) */
+  void RequestNextAction(FBotInstance &Instance, uint64 Token);
+
+  /** Process one observation through its own AgentOps::Process call. */
+  void ProcessObservation(FBotInstance &Instance, const FString &Observation,
+                          uint64 Token);
+
+  /**
+   * Game-thread landing point of every agent response, with its action
+   * parsed where the response arrived.
+   */
+  void OnAgentResponse(ForbocAI::Bot::FBotHandle Bot, uint64 Token,
+                       const FAgentResponse &Response,
+                       const ForbocAI::Bot::FParsedAction &Action);
+
+  /** Send everything in PendingBatch as one request. */
+  void FlushAgentBatch();
+
+  /** Fan a batch response out to ExecuteAction, or fall back per bot. */
+  void OnAgentBatchComplete(
+      bool bOk, const TArray<ForbocAI::Bot::FAgentBatchItem> &Items,
+      const TArray<FAgentResponse> &Responses,
+      const TArray<ForbocAI::Bot::FParsedAction> &Actions);
 
   /** Multi-Round Protocol: Execute (Finalize) */
-  void ExecuteAction(AActor *BotActor, const FAgentAction &Action);
+  void ExecuteAction(const FBotInstance &Instance,
+                     const ForbocAI::Bot::FParsedAction &Action);
+
+  /** Unregisters a bot whose actor is being destroyed. */
+  UFUNCTION()
+  void HandleBotDestroyed(AActor *DestroyedActor);
 
   /** Helper to map game state to strings for observation. */
   FString GetStateObservation(const ForbocAI::State::FBotState &State);
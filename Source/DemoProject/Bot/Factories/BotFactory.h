@@ -2,8 +2,10 @@
 
 #include "State/Actions.h"
 #include "State/BotState.h"
+#include "State/BotStateTable.h"
 #include "State/Reducers.h"
 #include <functional>
+#include <memory>
 
 namespace ForbocAI {
 namespace Bot {
@@ -13,9 +15,14 @@ namespace Bot {
 // However, to maintain state *across* calls, we need a closure or an object.
 // Since we can't use classes, we'll use a functional closure approach
 // where the State is held in a shared_ptr captured by the lambda.
+//
+// Dispatch reduces in place and both functions hand back a read-only
+// reference to the held State, so a dispatch costs no copies. The reference
+// stays valid for the life of the store; copy it if you need a snapshot.
 
-using Dispatcher = std::function<State::FBotState(State::FBotAction)>;
-using StateGetter = std::function<State::FBotState()>;
+using Dispatcher =
+    std::function<const State::FBotState &(const State::FBotAction &)>;
+using StateGetter = std::function<const State::FBotState &()>;
 
 struct FBotStore {
   Dispatcher Dispatch;
@@ -24,29 +31,53 @@ struct FBotStore {
 
 namespace Factory {
 
-inline FBotStore CreateBotStore(const FString &BotName) {
+inline FBotStore CreateBotStore(FName BotName) {
   // Shared State held by the closure
   // We use std::make_shared to ensure the state survives after this function
   // returns
   auto StateContainer =
       std::make_shared<State::FBotState>(State::CreateInitialState(BotName));
 
-  Dispatcher Dispatch =
-      [StateContainer](State::FBotAction Action) -> State::FBotState {
-    // 1. Reduce
-    State::FBotState NewState = State::Reduce(*StateContainer, Action);
+  Dispatcher Dispatch = [StateContainer](const State::FBotAction &Action)
+      -> const State::FBotState & {
+    // Reduce (Mutation of the container, effectively "State = NewState")
+    State::ReduceInPlace(*StateContainer, Action);
+    return *StateContainer;
+  };
+
+  StateGetter GetState = [StateContainer]() -> const State::FBotState & {
+    return *StateContainer;
+  };
+
+  return {std::move(Dispatch), std::move(GetState)};
+}
 
-    // 2. Update (Mutation of the container, effectively "State = NewState")
-    *StateContainer = NewState;
+// A Store whose State lives in one row of a shared FBotStateTable instead of
+// its own container. Same Dispatch/GetState contract as CreateBotStore, so
+// callers can't tell the difference; batch reducers over the table and
+// per-bot dispatches through the view see the same data. The view keeps one
+// scratch FBotState that the row is gathered into on each call.
+inline FBotStore
+CreateBotStoreView(const std::shared_ptr<State::FBotStateTable> &Table,
+                   int32 Row) {
+  auto Scratch = std::make_shared<State::FBotState>(
+      State::TableOps::ReadRow(*Table, Row));
 
-    return NewState;
+  Dispatcher Dispatch = [Table, Row, Scratch](const State::FBotAction &Action)
+      -> const State::FBotState & {
+    State::TableOps::ReadRow(*Table, Row, *Scratch);
+    State::ReduceInPlace(*Scratch, Action);
+    State::TableOps::WriteRow(*Table, Row, *Scratch);
+    return *Scratch;
   };
 
-  StateGetter GetState = [StateContainer]() -> State::FBotState {
-    return *StateContainer;
+  StateGetter GetState = [Table, Row,
+                          Scratch]() -> const State::FBotState & {
+    State::TableOps::ReadRow(*Table, Row, *Scratch);
+    return *Scratch;
   };
 
-  return {Dispatch, GetState};
+  return {std::move(Dispatch), std::move(GetState)};
 }
 } // namespace Factory
 
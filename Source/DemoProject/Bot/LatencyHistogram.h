@@ -0,0 +1,300 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+namespace ForbocAI {
+namespace Bot {
+
+// ── Latency Histograms ──
+// HDR-style histograms of microsecond latencies. Values below SubBuckets
+// get a bucket each; above that every power of two is split into SubBuckets
+// linear buckets, so any recorded value is known to within 1/SubBuckets
+// (about 3%), up to 2^MaxBits us (about 19 hours). Recording is a few
+// relaxed atomic adds and never locks or allocates, so any thread may
+// record into a histogram it holds; readers get percentiles off a live
+// histogram without stopping the writers.
+
+struct FLatencyHistogram {
+  static constexpr int32 SubBucketBits = 5;
+  static constexpr int32 SubBuckets = 1 << SubBucketBits;
+  static constexpr int32 MaxBits = 36;
+  static constexpr int32 NumBuckets =
+      (MaxBits - SubBucketBits + 1) * SubBuckets;
+  static constexpr uint64 MaxValue = (uint64(1) << MaxBits) - 1;
+
+  std::atomic<uint64> Counts[NumBuckets];
+  std::atomic<uint64> Total{0};
+  // Microseconds, over every recorded value
+  std::atomic<uint64> Sum{0};
+  std::atomic<uint64> Max{0};
+
+  FLatencyHistogram() {
+    for (std::atomic<uint64> &Count : Counts) {
+      Count.store(0, std::memory_order_relaxed);
+    }
+  }
+};
+
+// Percentiles in milliseconds.
+struct FLatencySummary {
+  uint64 Count = 0;
+  double MeanMs = 0.0;
+  double P50Ms = 0.0;
+  double P95Ms = 0.0;
+  double P99Ms = 0.0;
+  double MaxMs = 0.0;
+};
+
+// ── Request Timing ──
+// Timestamps (FPlatformTime::Seconds) one agent request collects on its way
+// from the observation wheel to ExecuteAction. Each stage is the gap
+// between two of them:
+//   Queue      Due -> Started         waiting for a request slot
+//   Serialize  Started -> Serialized  building the observation
+//   Batch      Serialized -> Sent     in a batch (or a failed one)
+//   Protocol   Sent -> Received       the network and the SDK protocol
+//                                     (Directive -> Generate -> Verdict)
+//   Dispatch   Received -> Executed   mapping the response to an action
+//   Total      Started -> Executed    RequestNextAction to ExecuteAction
+
+enum class ELatencyStage : uint8 {
+  Queue,
+  Serialize,
+  Batch,
+  Protocol,
+  Dispatch,
+  Total,
+  Num
+};
+
+struct FRequestTiming {
+  double Due = 0.0;
+  double Started = 0.0;
+  double Serialized = 0.0;
+  double Sent = 0.0;
+};
+
+// Per-stage histograms for every request, plus Total by persona and by
+// action type. Keyed histograms are added on the game thread only and never
+// move once added.
+struct FLatencyRecorder {
+  FLatencyHistogram Stages[(int32)ELatencyStage::Num];
+  TMap<FString, TUniquePtr<FLatencyHistogram>> ByPersona;
+  TMap<FString, TUniquePtr<FLatencyHistogram>> ByAction;
+};
+
+namespace LatencyOps {
+
+namespace Detail {
+
+inline uint64 BucketLow(int32 Bucket) {
+  constexpr int32 SubBuckets = FLatencyHistogram::SubBuckets;
+  if (Bucket < SubBuckets) {
+    return Bucket;
+  }
+  const int32 Shift = Bucket / SubBuckets - 1;
+  return uint64(SubBuckets + Bucket % SubBuckets) << Shift;
+}
+
+// Largest value that lands in Bucket.
+inline uint64 BucketHigh(int32 Bucket) {
+  constexpr int32 SubBuckets = FLatencyHistogram::SubBuckets;
+  const int32 Shift = Bucket < SubBuckets ? 0 : Bucket / SubBuckets - 1;
+  return BucketLow(Bucket) + (uint64(1) << Shift) - 1;
+}
+
+inline uint64 Micros(double FromSeconds, double ToSeconds) {
+  return (uint64)FMath::Max(0.0, (ToSeconds - FromSeconds) * 1e6);
+}
+
+inline void AppendCsvField(FString &Out, const FString &Field) {
+  if (!Field.Contains(TEXT(",")) && !Field.Contains(TEXT("\"")) &&
+      !Field.Contains(TEXT("\n"))) {
+    Out += Field;
+    return;
+  }
+  Out += TEXT("\"");
+  Out += Field.Replace(TEXT("\""), TEXT("\"\""));
+  Out += TEXT("\"");
+}
+
+} // namespace Detail
+
+inline int32 BucketOf(uint64 Micros) {
+  constexpr int32 SubBucketBits = FLatencyHistogram::SubBucketBits;
+  constexpr int32 SubBuckets = FLatencyHistogram::SubBuckets;
+  Micros = FMath::Min(Micros, FLatencyHistogram::MaxValue);
+  if (Micros < (uint64)SubBuckets) {
+    return (int32)Micros;
+  }
+  const int32 Shift = (int32)FMath::FloorLog2_64(Micros) - SubBucketBits;
+  return (Shift + 1) * SubBuckets + (int32)((Micros >> Shift) - SubBuckets);
+}
+
+inline void Record(FLatencyHistogram &Histogram, uint64 Micros) {
+  Histogram.Counts[BucketOf(Micros)].fetch_add(1, std::memory_order_relaxed);
+  Histogram.Total.fetch_add(1, std::memory_order_relaxed);
+  Histogram.Sum.fetch_add(Micros, std::memory_order_relaxed);
+
+  uint64 Max = Histogram.Max.load(std::memory_order_relaxed);
+  while (Micros > Max && !Histogram.Max.compare_exchange_weak(
+                             Max, Micros, std::memory_order_relaxed)) {
+  }
+}
+
+inline void Reset(FLatencyHistogram &Histogram) {
+  for (std::atomic<uint64> &Count : Histogram.Counts) {
+    Count.store(0, std::memory_order_relaxed);
+  }
+  Histogram.Total.store(0, std::memory_order_relaxed);
+  Histogram.Sum.store(0, std::memory_order_relaxed);
+  Histogram.Max.store(0, std::memory_order_relaxed);
+}
+
+// Smallest recorded value (to bucket precision) that Fraction of all
+// values are at or below, in microseconds. 0 if nothing was recorded.
+inline uint64 Percentile(const FLatencyHistogram &Histogram, double Fraction) {
+  const uint64 Total = Histogram.Total.load(std::memory_order_relaxed);
+  if (Total == 0) {
+    return 0;
+  }
+  const uint64 Rank = FMath::Clamp<uint64>(
+      (uint64)FMath::CeilToDouble(Fraction * Total), 1, Total);
+  const uint64 Max = Histogram.Max.load(std::memory_order_relaxed);
+
+  uint64 Seen = 0;
+  for (int32 Bucket = 0; Bucket < FLatencyHistogram::NumBuckets; ++Bucket) {
+    Seen += Histogram.Counts[Bucket].load(std::memory_order_relaxed);
+    if (Seen >= Rank) {
+      return FMath::Min(Detail::BucketHigh(Bucket), Max);
+    }
+  }
+  // Writers raced ahead of Total
+  return Max;
+}
+
+inline FLatencySummary Summarize(const FLatencyHistogram &Histogram) {
+  FLatencySummary Summary;
+  Summary.Count = Histogram.Total.load(std::memory_order_relaxed);
+  if (Summary.Count == 0) {
+    return Summary;
+  }
+  Summary.MeanMs =
+      Histogram.Sum.load(std::memory_order_relaxed) / 1000.0 / Summary.Count;
+  Summary.P50Ms = Percentile(Histogram, 0.50) / 1000.0;
+  Summary.P95Ms = Percentile(Histogram, 0.95) / 1000.0;
+  Summary.P99Ms = Percentile(Histogram, 0.99) / 1000.0;
+  Summary.MaxMs = Histogram.Max.load(std::memory_order_relaxed) / 1000.0;
+  return Summary;
+}
+
+inline const TCHAR *StageName(ELatencyStage Stage) {
+  switch (Stage) {
+  case ELatencyStage::Queue:
+    return TEXT("Queue");
+  case ELatencyStage::Serialize:
+    return TEXT("Serialize");
+  case ELatencyStage::Batch:
+    return TEXT("Batch");
+  case ELatencyStage::Protocol:
+    return TEXT("Protocol");
+  case ELatencyStage::Dispatch:
+    return TEXT("Dispatch");
+  case ELatencyStage::Total:
+    return TEXT("Total");
+  default:
+    return TEXT("?");
+  }
+}
+
+// Histogram for Key, added on first use. Game thread only.
+inline FLatencyHistogram &
+FindOrAdd(TMap<FString, TUniquePtr<FLatencyHistogram>> &Histograms,
+          const FString &Key) {
+  TUniquePtr<FLatencyHistogram> &Histogram = Histograms.FindOrAdd(Key);
+  if (!Histogram) {
+    Histogram = MakeUnique<FLatencyHistogram>();
+  }
+  return *Histogram;
+}
+
+// Records one request that was answered at Received and executed at
+// Executed. Game thread only (it may add keyed histograms).
+inline void RecordRequest(FLatencyRecorder &Recorder,
+                          const FRequestTiming &Timing, double Received,
+                          double Executed, const FString &Persona,
+                          const FString &ActionType) {
+  auto Stage = [&Recorder](ELatencyStage Which) -> FLatencyHistogram & {
+    return Recorder.Stages[(int32)Which];
+  };
+  Record(Stage(ELatencyStage::Queue),
+         Detail::Micros(Timing.Due, Timing.Started));
+  Record(Stage(ELatencyStage::Serialize),
+         Detail::Micros(Timing.Started, Timing.Serialized));
+  Record(Stage(ELatencyStage::Batch),
+         Detail::Micros(Timing.Serialized, Timing.Sent));
+  Record(Stage(ELatencyStage::Protocol),
+         Detail::Micros(Timing.Sent, Received));
+  Record(Stage(ELatencyStage::Dispatch), Detail::Micros(Received, Executed));
+
+  const uint64 Total = Detail::Micros(Timing.Started, Executed);
+  Record(Stage(ELatencyStage::Total), Total);
+  Record(FindOrAdd(Recorder.ByPersona, Persona), Total);
+  Record(FindOrAdd(Recorder.ByAction, ActionType), Total);
+}
+
+// Zeroes every histogram. Keyed ones stay, so pointers to them stay valid.
+inline void Reset(FLatencyRecorder &Recorder) {
+  for (FLatencyHistogram &Histogram : Recorder.Stages) {
+    Reset(Histogram);
+  }
+  for (const auto &Entry : Recorder.ByPersona) {
+    Reset(*Entry.Value);
+  }
+  for (const auto &Entry : Recorder.ByAction) {
+    Reset(*Entry.Value);
+  }
+}
+
+// Calls Fn(Scope, Key, Histogram) for every histogram: the stages in order,
+// then by persona, then by action type.
+template <typename FnType>
+void ForEach(const FLatencyRecorder &Recorder, FnType &&Fn) {
+  for (int32 Stage = 0; Stage < (int32)ELatencyStage::Num; ++Stage) {
+    Fn(TEXT("Stage"), FString(StageName((ELatencyStage)Stage)),
+       Recorder.Stages[Stage]);
+  }
+  for (const auto &Entry : Recorder.ByPersona) {
+    Fn(TEXT("Persona"), Entry.Key, *Entry.Value);
+  }
+  for (const auto &Entry : Recorder.ByAction) {
+    Fn(TEXT("Action"), Entry.Key, *Entry.Value);
+  }
+}
+
+inline const TCHAR *CsvHeader() {
+  return TEXT("Time,Scope,Key,Count,MeanMs,P50Ms,P95Ms,P99Ms,MaxMs\n");
+}
+
+// Appends one CSV row per histogram that has values, stamped with Time.
+inline void WriteCsv(const FLatencyRecorder &Recorder, double Time,
+                     FString &Out) {
+  ForEach(Recorder, [Time, &Out](const TCHAR *Scope, const FString &Key,
+                                 const FLatencyHistogram &Histogram) {
+    const FLatencySummary Summary = Summarize(Histogram);
+    if (Summary.Count == 0) {
+      return;
+    }
+    Out += FString::Printf(TEXT("%.3f,%s,"), Time, Scope);
+    Detail::AppendCsvField(Out, Key);
+    Out += FString::Printf(TEXT(",%llu,%.3f,%.3f,%.3f,%.3f,%.3f\n"),
+                           Summary.Count, Summary.MeanMs, Summary.P50Ms,
+                           Summary.P95Ms, Summary.P99Ms, Summary.MaxMs);
+  });
+}
+
+} // namespace LatencyOps
+
+} // namespace Bot
+} // namespace ForbocAI
@@ -0,0 +1,214 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformTime.h"
+#include "State/Actions.h"
+#include "State/BotState.h"
+
+namespace ForbocAI {
+namespace Bot {
+
+// ── AI Level of Detail ──
+// Bots are grouped into tiers by how much attention they deserve. Tier t
+// ticks every TickDivisor frames; the DeltaTime of the frames in between is
+// carried and handed over in one FActionTick (Steps = frames), so decay and
+// TickCount come out as if the bot had ticked every frame. The last tier
+// sleeps: it never ticks, and a bot leaving it is caught up in one step.
+//
+// Table rows are kept grouped by tier, tier 0 first, so each tier's
+// heartbeat is one contiguous batch pass. Bots only change tier on sync
+// frames (every SyncPeriod frames), where every ticking tier has just
+// ticked and nothing is owed to anyone but the sleepers.
+
+struct FLodTierConfig {
+  // Nearest player within this distance (and no nearer tier matching)
+  float MaxDistance = 0.0f;
+  // Frames per heartbeat, rounded up to a power of two so every tier ticks
+  // on the same frame once per SyncPeriod (0 = never, the sleep tier)
+  int32 TickDivisor = 1;
+  // Seconds between observations (0 = the interval for the bot's phase)
+  float ObservationInterval = 0.0f;
+};
+
+struct FLodTier {
+  FLodTierConfig Config;
+
+  // Carried since this tier last ticked
+  float Accumulated = 0.0f;
+  uint32 Frames = 0;
+
+  // Heartbeat cost, smoothed over frames (including frames it skipped)
+  double TickSeconds = 0.0;
+};
+
+struct FLodPartition {
+  TArray<FLodTier> Tiers;
+
+  // First row of each tier; the last tier runs to the end of the table
+  TArray<int32> Begin;
+
+  uint64 Frame = 0;
+  int32 SyncPeriod = 1;
+
+  // Sum of every frame's DeltaTime, for catching sleepers up
+  double Clock = 0.0;
+};
+
+namespace LodOps {
+
+// Weight of the newest frame in FLodTier::TickSeconds.
+constexpr double CostSmoothing = 0.05;
+
+namespace Detail {
+
+inline int32 Divisor(const FLodTierConfig &Config) {
+  return (int32)FMath::RoundUpToPowerOfTwo(
+      (uint32)FMath::Clamp(Config.TickDivisor, 1, 1 << 10));
+}
+
+} // namespace Detail
+
+inline int32 NumTiers(const FLodPartition &Lod) { return Lod.Tiers.Num(); }
+
+inline int32 SleepTier(const FLodPartition &Lod) {
+  return Lod.Tiers.Num() - 1;
+}
+
+inline int32 TierEnd(const FLodPartition &Lod, int32 Tier, int32 NumRows) {
+  return Tier + 1 < Lod.Begin.Num() ? Lod.Begin[Tier + 1] : NumRows;
+}
+
+// Tier of a row. Empty tiers share their Begin with the next one, so this
+// is the last tier starting at or before Row.
+inline int32 TierOf(const FLodPartition &Lod, int32 Row) {
+  int32 Tier = 0;
+  while (Tier + 1 < Lod.Begin.Num() && Lod.Begin[Tier + 1] <= Row) {
+    ++Tier;
+  }
+  return Tier;
+}
+
+// True if the ticking tiers match Configs (the sleep tier excluded).
+inline bool Matches(const FLodPartition &Lod,
+                    TArrayView<const FLodTierConfig> Configs) {
+  if (Configs.Num() + 1 != Lod.Tiers.Num()) {
+    return false;
+  }
+  for (int32 Tier = 0; Tier < Configs.Num(); ++Tier) {
+    const FLodTierConfig &Current = Lod.Tiers[Tier].Config;
+    if (Current.MaxDistance != Configs[Tier].MaxDistance ||
+        Current.TickDivisor != Detail::Divisor(Configs[Tier]) ||
+        Current.ObservationInterval != Configs[Tier].ObservationInterval) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Sets up Configs (at least one) plus a sleep tier and puts every row in
+// tier 0. Only call on a sync frame, with the sleepers woken.
+inline void Reset(FLodPartition &Lod, TArrayView<const FLodTierConfig> Configs,
+                  int32 NumRows) {
+  check(Configs.Num() > 0);
+  Lod.Tiers.Reset();
+  Lod.SyncPeriod = 1;
+  for (const FLodTierConfig &Config : Configs) {
+    FLodTier &Tier = Lod.Tiers.AddDefaulted_GetRef();
+    Tier.Config = Config;
+    Tier.Config.TickDivisor = Detail::Divisor(Config);
+    Lod.SyncPeriod = FMath::Max(Lod.SyncPeriod, Tier.Config.TickDivisor);
+  }
+  FLodTier &Sleep = Lod.Tiers.AddDefaulted_GetRef();
+  Sleep.Config.TickDivisor = 0;
+
+  Lod.Begin.Init(NumRows, Lod.Tiers.Num());
+  Lod.Begin[0] = 0;
+
+  // Start on a sync boundary
+  Lod.Frame = 0;
+}
+
+// Tier for a bot, given the squared distance to its nearest player (null
+// if no player is within the wake radius).
+inline int32 PickTier(const FLodPartition &Lod, State::EBotPhase Phase,
+                      bool bHasPlayers, const double *NearestSquared,
+                      bool bSleepDistant) {
+  const int32 Last = SleepTier(Lod) - 1;
+
+  // Fighting or fleeing bots are always relevant; without players there's
+  // nothing to measure relevance against
+  if (Phase == State::EBotPhase::Combat || Phase == State::EBotPhase::Flee ||
+      !bHasPlayers) {
+    return 0;
+  }
+  if (!NearestSquared) {
+    return bSleepDistant ? SleepTier(Lod) : Last;
+  }
+  for (int32 Tier = 0; Tier < Last; ++Tier) {
+    const double Max = Lod.Tiers[Tier].Config.MaxDistance;
+    if (*NearestSquared <= Max * Max) {
+      return Tier;
+    }
+  }
+  return Last;
+}
+
+// Moves Row to Target with one Swap(A, B) per tier boundary crossed, and
+// returns its new row. Swap must exchange rows A and B wherever they live.
+template <typename SwapType>
+int32 Move(FLodPartition &Lod, int32 Row, int32 Target, SwapType &&Swap) {
+  int32 Tier = TierOf(Lod, Row);
+  while (Tier < Target) {
+    // Last row of Tier, which then becomes the first of Tier + 1
+    const int32 Edge = --Lod.Begin[Tier + 1];
+    Swap(Row, Edge);
+    Row = Edge;
+    ++Tier;
+  }
+  while (Tier > Target) {
+    // First row of Tier, which then becomes the last of Tier - 1
+    const int32 Edge = Lod.Begin[Tier]++;
+    Swap(Row, Edge);
+    Row = Edge;
+    --Tier;
+  }
+  return Row;
+}
+
+// Steps one frame. Each ticking tier that is due calls
+// Tick(Tier, Begin, End, Heartbeat) with what it has carried. Returns true
+// on a sync frame.
+template <typename TickType>
+bool Advance(FLodPartition &Lod, int32 NumRows, float DeltaTime,
+             TickType &&Tick) {
+  ++Lod.Frame;
+  Lod.Clock += DeltaTime;
+
+  for (int32 Tier = 0; Tier < SleepTier(Lod); ++Tier) {
+    FLodTier &Current = Lod.Tiers[Tier];
+    Current.Accumulated += DeltaTime;
+    ++Current.Frames;
+
+    double Seconds = 0.0;
+    if (Lod.Frame % Current.Config.TickDivisor == 0) {
+      State::FActionTick Heartbeat;
+      Heartbeat.DeltaTime = Current.Accumulated;
+      Heartbeat.Steps = Current.Frames;
+
+      const double Start = FPlatformTime::Seconds();
+      Tick(Tier, Lod.Begin[Tier], TierEnd(Lod, Tier, NumRows), Heartbeat);
+      Seconds = FPlatformTime::Seconds() - Start;
+
+      Current.Accumulated = 0.0f;
+      Current.Frames = 0;
+    }
+    Current.TickSeconds += (Seconds - Current.TickSeconds) * CostSmoothing;
+  }
+
+  return Lod.Frame % Lod.SyncPeriod == 0;
+}
+
+} // namespace LodOps
+
+} // namespace Bot
+} // namespace ForbocAI
@@ -0,0 +1,207 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace ForbocAI {
+namespace Bot {
+
+// ── Observation Scheduler (Hierarchical Timing Wheel) ──
+// Bots are filed under the tick at which they next observe. Time advances in
+// fixed ticks of Resolution seconds; each frame only the slots the clock
+// sweeps past are visited, so the cost is proportional to the bots that are
+// actually due rather than to every registered bot.
+//
+//   Inner: InnerSlots ticks, one slot per tick
+//   Outer: OuterSlots blocks of InnerSlots ticks, cascaded into Inner when
+//          the clock enters the block
+//   Overflow: anything further out, re-filed once per outer revolution
+//
+// Due entries land in Ready (FIFO). Advance hands out at most Budget of them
+// per call; the rest stay in Ready and go first next frame.
+
+template <typename KeyType> struct TObservationWheel {
+  static constexpr int32 InnerSlots = 256;
+  static constexpr int32 OuterSlots = 64;
+  static constexpr uint64 Span = uint64(InnerSlots) * OuterSlots;
+
+  struct FEntry {
+    KeyType Key;
+    uint64 DueTick;
+  };
+
+  double Resolution = 1.0 / 30.0;
+  uint64 CurrentTick = 0;
+  int32 Num = 0;
+
+  TArray<FEntry> Inner[InnerSlots];
+  TArray<FEntry> Outer[OuterSlots];
+  TArray<FEntry> Overflow;
+
+  // Due, not yet handed out. Head index avoids shifting on pop.
+  TArray<FEntry> Ready;
+  int32 ReadyHead = 0;
+};
+
+namespace SchedulerOps {
+
+namespace Detail {
+
+template <typename KeyType>
+void Place(TObservationWheel<KeyType> &Wheel,
+           const typename TObservationWheel<KeyType>::FEntry &Entry) {
+  using FWheel = TObservationWheel<KeyType>;
+
+  if (Entry.DueTick <= Wheel.CurrentTick) {
+    Wheel.Ready.Add(Entry);
+  } else if (Entry.DueTick - Wheel.CurrentTick < FWheel::InnerSlots) {
+    Wheel.Inner[Entry.DueTick % FWheel::InnerSlots].Add(Entry);
+  } else if (Entry.DueTick - Wheel.CurrentTick < FWheel::Span) {
+    Wheel.Outer[(Entry.DueTick / FWheel::InnerSlots) % FWheel::OuterSlots].Add(
+        Entry);
+  } else {
+    Wheel.Overflow.Add(Entry);
+  }
+}
+
+template <typename KeyType>
+void Refile(TObservationWheel<KeyType> &Wheel,
+            TArray<typename TObservationWheel<KeyType>::FEntry> &Bucket) {
+  // Swap out first: Place may append to the very bucket being drained
+  TArray<typename TObservationWheel<KeyType>::FEntry> Entries =
+      MoveTemp(Bucket);
+  Bucket.Reset();
+  for (const auto &Entry : Entries) {
+    Place(Wheel, Entry);
+  }
+}
+
+} // namespace Detail
+
+// Restarts the wheel's clock at Now. Use before the first Schedule.
+template <typename KeyType>
+void Reset(TObservationWheel<KeyType> &Wheel, double Now,
+           double Resolution = 1.0 / 30.0) {
+  Wheel = TObservationWheel<KeyType>();
+  Wheel.Resolution = Resolution;
+  Wheel.CurrentTick = (uint64)FMath::Max(0.0, Now / Resolution);
+}
+
+// Moves the wheel's clock to Now, keeping every key filed as far ahead of it
+// as it was. For a time base that changes after keys were scheduled (e.g.
+// registration before the world started playing); nothing is dropped.
+template <typename KeyType>
+void Rebase(TObservationWheel<KeyType> &Wheel, double Now) {
+  using FWheel = TObservationWheel<KeyType>;
+
+  const uint64 NewTick = (uint64)FMath::Max(0.0, Now / Wheel.Resolution);
+  if (NewTick == Wheel.CurrentTick) {
+    return;
+  }
+
+  TArray<typename FWheel::FEntry> Entries = MoveTemp(Wheel.Overflow);
+  Wheel.Overflow.Reset();
+  for (auto &Slot : Wheel.Inner) {
+    Entries.Append(Slot);
+    Slot.Reset();
+  }
+  for (auto &Slot : Wheel.Outer) {
+    Entries.Append(Slot);
+    Slot.Reset();
+  }
+
+  // Ready keys are already due and stay so
+  for (auto &Entry : Entries) {
+    Entry.DueTick = NewTick + (Entry.DueTick - Wheel.CurrentTick);
+  }
+  Wheel.CurrentTick = NewTick;
+  for (const auto &Entry : Entries) {
+    Detail::Place(Wheel, Entry);
+  }
+}
+
+// Files Key to come due DelaySeconds from the wheel's current time (at
+// least one tick out).
+template <typename KeyType>
+void Schedule(TObservationWheel<KeyType> &Wheel, const KeyType &Key,
+              double DelaySeconds) {
+  const uint64 Ticks =
+      (uint64)FMath::Max(1.0, FMath::CeilToDouble(DelaySeconds /
+                                                  Wheel.Resolution));
+  Detail::Place(Wheel, {Key, Wheel.CurrentTick + Ticks});
+  Wheel.Num++;
+}
+
+// Moves the clock up to Now and appends at most Budget due keys to OutDue
+// (Budget <= 0 means unlimited), oldest first. Handed-out keys are no longer
+// in the wheel; reschedule them to keep them observing.
+template <typename KeyType>
+void Advance(TObservationWheel<KeyType> &Wheel, double Now, int32 Budget,
+             TArray<KeyType> &OutDue) {
+  using FWheel = TObservationWheel<KeyType>;
+
+  const uint64 TargetTick = (uint64)FMath::Max(0.0, Now / Wheel.Resolution);
+
+  if (TargetTick > Wheel.CurrentTick &&
+      TargetTick - Wheel.CurrentTick >= FWheel::Span) {
+    // Hitch longer than the whole wheel: jump and re-file everything
+    Wheel.CurrentTick = TargetTick;
+    for (auto &Slot : Wheel.Inner) {
+      Detail::Refile(Wheel, Slot);
+    }
+    for (auto &Slot : Wheel.Outer) {
+      Detail::Refile(Wheel, Slot);
+    }
+    Detail::Refile(Wheel, Wheel.Overflow);
+  }
+
+  while (Wheel.CurrentTick < TargetTick) {
+    const uint64 Tick = ++Wheel.CurrentTick;
+
+    if (Tick % FWheel::InnerSlots == 0) {
+      if (Tick % FWheel::Span == 0) {
+        Detail::Refile(Wheel, Wheel.Overflow);
+      }
+      Detail::Refile(
+          Wheel, Wheel.Outer[(Tick / FWheel::InnerSlots) % FWheel::OuterSlots]);
+    }
+
+    TArray<typename FWheel::FEntry> &Slot =
+        Wheel.Inner[Tick % FWheel::InnerSlots];
+    Wheel.Ready.Append(Slot);
+    Slot.Reset();
+  }
+
+  const int32 Available = Wheel.Ready.Num() - Wheel.ReadyHead;
+  const int32 Take = Budget > 0 ? FMath::Min(Budget, Available) : Available;
+  for (int32 Index = 0; Index < Take; ++Index) {
+    OutDue.Add(Wheel.Ready[Wheel.ReadyHead + Index].Key);
+  }
+  Wheel.ReadyHead += Take;
+  Wheel.Num -= Take;
+
+  if (Wheel.ReadyHead == Wheel.Ready.Num()) {
+    Wheel.Ready.Reset();
+    Wheel.ReadyHead = 0;
+  }
+}
+
+// Number of keys that are due but were held back by the budget.
+template <typename KeyType>
+int32 NumBacklogged(const TObservationWheel<KeyType> &Wheel) {
+  return Wheel.Ready.Num() - Wheel.ReadyHead;
+}
+
+// Start offset for the Index-th bot registered against Interval. Consecutive
+// indices follow the golden-ratio sequence, which keeps any run of bots
+// spread evenly over the interval, so a wave registered in one frame
+// doesn't observe (and hit the API) in one frame.
+inline double SpreadOffset(uint32 Index, double Interval) {
+  constexpr double GoldenRatioFraction = 0.6180339887498949;
+  const double Phase = Index * GoldenRatioFraction;
+  return (Phase - FMath::FloorToDouble(Phase)) * Interval;
+}
+
+} // namespace SchedulerOps
+
+} // namespace Bot
+} // namespace ForbocAI
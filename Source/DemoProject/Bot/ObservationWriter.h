@@ -0,0 +1,179 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "State/BotState.h"
+
+namespace ForbocAI {
+namespace Bot {
+
+// ── Observation Writer ──
+// Serializes FBotState into a pooled buffer that is reset (not freed) once
+// per frame, so steady-state observation building doesn't allocate. Each
+// write returns a span into the buffer; spans stay valid until the next
+// Reset, views over them only until the next write.
+//
+//   Text:   same string GetStateObservation always produced
+//   Json:   {"name","health","maxHealth","position":[x,y,z],"phase","aggro"},
+//           with null for a NaN or infinite number
+//   Binary: fixed 39-byte little-endian record, see WriteBinary
+
+struct FObservationBuffer {
+  TArray<TCHAR> Text;
+  TArray<uint8> Bytes;
+};
+
+struct FObservationSpan {
+  int32 Offset = 0;
+  int32 Length = 0;
+};
+
+namespace ObservationOps {
+
+constexpr uint8 BinaryVersion = 1;
+constexpr int32 BinarySize = 39;
+
+namespace Detail {
+
+// Formats straight into the buffer's spare capacity, growing only when the
+// pooled buffer is too small. Format must be a literal (FCString::Snprintf).
+template <typename FormatType, typename... ArgTypes>
+void AppendFormat(TArray<TCHAR> &Out, const FormatType &Format,
+                  ArgTypes... Args) {
+  const int32 Start = Out.Num();
+  int32 Room = FMath::Max(Out.Max() - Start, 128);
+  for (;;) {
+    Out.AddUninitialized(Room);
+    const int32 Written =
+        FCString::Snprintf(Out.GetData() + Start, Room, Format, Args...);
+    if (Written >= 0 && Written < Room) {
+      Out.SetNum(Start + Written, EAllowShrinking::No);
+      return;
+    }
+    Out.SetNum(Start, EAllowShrinking::No);
+    Room *= 2;
+  }
+}
+
+inline void AppendJsonEscaped(TArray<TCHAR> &Out, const TCHAR *Chars) {
+  for (; *Chars; ++Chars) {
+    const TCHAR Char = *Chars;
+    if (Char == TEXT('"') || Char == TEXT('\\')) {
+      Out.Add(TEXT('\\'));
+      Out.Add(Char);
+    } else if (Char < 0x20) {
+      AppendFormat(Out, TEXT("\\u%04x"), (int32)Char);
+    } else {
+      Out.Add(Char);
+    }
+  }
+}
+
+// JSON has no NaN or Infinity: a non-finite value is written as null.
+template <typename FormatType>
+void AppendJsonNumber(TArray<TCHAR> &Out, const FormatType &Format,
+                      double Value) {
+  if (FMath::IsFinite(Value)) {
+    AppendFormat(Out, Format, Value);
+  } else {
+    AppendFormat(Out, TEXT("null"));
+  }
+}
+
+template <typename ValueType>
+void AppendBytes(TArray<uint8> &Out, const ValueType &Value) {
+  const int32 Start = Out.AddUninitialized(sizeof(ValueType));
+  FMemory::Memcpy(Out.GetData() + Start, &Value, sizeof(ValueType));
+}
+
+} // namespace Detail
+
+// Empties the buffer for the next frame, keeping its capacity.
+inline void Reset(FObservationBuffer &Buffer) {
+  Buffer.Text.Reset();
+  Buffer.Bytes.Reset();
+}
+
+inline FStringView TextView(const FObservationBuffer &Buffer,
+                            FObservationSpan Span) {
+  return FStringView(Buffer.Text.GetData() + Span.Offset, Span.Length);
+}
+
+inline TArrayView<const uint8> BinaryView(const FObservationBuffer &Buffer,
+                                          FObservationSpan Span) {
+  return MakeArrayView(Buffer.Bytes.GetData() + Span.Offset, Span.Length);
+}
+
+// "Name: %s, Health: %.1f, Position: %s, Phase: %d" with FVector::ToString
+inline FObservationSpan WriteText(FObservationBuffer &Buffer,
+                                  const State::FBotState &State) {
+  const int32 Start = Buffer.Text.Num();
+  FNameBuilder Name(State.Name);
+  Detail::AppendFormat(
+      Buffer.Text,
+      TEXT("Name: %s, Health: %.1f, Position: X=%3.3f Y=%3.3f Z=%3.3f, "
+           "Phase: %d"),
+      *Name, State.Stats.Health, State.Position.X, State.Position.Y,
+      State.Position.Z, (int32)State.Phase);
+  return {Start, Buffer.Text.Num() - Start};
+}
+
+inline FObservationSpan WriteJson(FObservationBuffer &Buffer,
+                                  const State::FBotState &State) {
+  const int32 Start = Buffer.Text.Num();
+  Detail::AppendFormat(Buffer.Text, TEXT("{\"name\":\""));
+  Detail::AppendJsonEscaped(Buffer.Text, *FNameBuilder(State.Name));
+  const State::FStats &Stats = State.Stats;
+  const FVector &Position = State.Position;
+  if (FMath::IsFinite(Stats.Health) && FMath::IsFinite(Stats.MaxHealth) &&
+      !Position.ContainsNaN()) {
+    Detail::AppendFormat(
+        Buffer.Text,
+        TEXT("\",\"health\":%.1f,\"maxHealth\":%.1f,"
+             "\"position\":[%.3f,%.3f,%.3f]"),
+        Stats.Health, Stats.MaxHealth, Position.X, Position.Y, Position.Z);
+  } else {
+    Detail::AppendFormat(Buffer.Text, TEXT("\",\"health\":"));
+    Detail::AppendJsonNumber(Buffer.Text, TEXT("%.1f"), Stats.Health);
+    Detail::AppendFormat(Buffer.Text, TEXT(",\"maxHealth\":"));
+    Detail::AppendJsonNumber(Buffer.Text, TEXT("%.1f"), Stats.MaxHealth);
+    Detail::AppendFormat(Buffer.Text, TEXT(",\"position\":["));
+    Detail::AppendJsonNumber(Buffer.Text, TEXT("%.3f"), Position.X);
+    Detail::AppendFormat(Buffer.Text, TEXT(","));
+    Detail::AppendJsonNumber(Buffer.Text, TEXT("%.3f"), Position.Y);
+    Detail::AppendFormat(Buffer.Text, TEXT(","));
+    Detail::AppendJsonNumber(Buffer.Text, TEXT("%.3f"), Position.Z);
+    Detail::AppendFormat(Buffer.Text, TEXT("]"));
+  }
+  Detail::AppendFormat(Buffer.Text, TEXT(",\"phase\":%d,\"aggro\":%s}"),
+                       (int32)State.Phase,
+                       State.Memory.bHasAggro ? TEXT("true") : TEXT("false"));
+  return {Start, Buffer.Text.Num() - Start};
+}
+
+// Version(u8) Id(4 x u32) Health(f32) MaxHealth(f32) Position(3 x f32)
+// Phase(u8) Flags(u8: bit 0 = aggro). The bot is identified by Id, not Name.
+inline FObservationSpan WriteBinary(FObservationBuffer &Buffer,
+                                    const State::FBotState &State) {
+  TArray<uint8> &Out = Buffer.Bytes;
+  const int32 Start = Out.Num();
+
+  Detail::AppendBytes(Out, BinaryVersion);
+  Detail::AppendBytes(Out, State.Id.A);
+  Detail::AppendBytes(Out, State.Id.B);
+  Detail::AppendBytes(Out, State.Id.C);
+  Detail::AppendBytes(Out, State.Id.D);
+  Detail::AppendBytes(Out, State.Stats.Health);
+  Detail::AppendBytes(Out, State.Stats.MaxHealth);
+  Detail::AppendBytes(Out, (float)State.Position.X);
+  Detail::AppendBytes(Out, (float)State.Position.Y);
+  Detail::AppendBytes(Out, (float)State.Position.Z);
+  Detail::AppendBytes(Out, (uint8)State.Phase);
+  Detail::AppendBytes(Out, (uint8)(State.Memory.bHasAggro ? 1 : 0));
+
+  return {Start, Out.Num() - Start};
+}
+
+} // namespace ObservationOps
+
+} // namespace Bot
+} // namespace ForbocAI
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "Async/ParallelFor.h"
+#include "CoreMinimal.h"
+#include "State/BatchReducers.h"
+#include "State/BotStateTable.h"
+
+namespace ForbocAI {
+namespace Bot {
+
+// ── Parallel Heartbeat ──
+// Reducers are pure over independent rows, so the table is cut into
+// contiguous chunks and each chunk is reduced by whichever worker picks it
+// up. A row is only ever touched by the chunk that owns it, so the result is
+// identical to a single-threaded pass regardless of scheduling. Side effects
+// that need ordering (observations) stay on the game thread, driven by the
+// observation scheduler.
+
+struct FParallelTickConfig {
+  // Rows per work item
+  int32 ChunkSize = 1024;
+  // Upper bound on concurrently running work items (0 = no limit)
+  int32 MaxWorkers = 0;
+  // Run every chunk inline on the calling thread
+  bool bSingleThread = false;
+};
+
+namespace ParallelOps {
+
+inline int32 NumChunks(int32 Rows, int32 ChunkSize) {
+  return Rows > 0 ? FMath::DivideAndRoundUp(Rows, FMath::Max(1, ChunkSize))
+                  : 0;
+}
+
+// Calls Body(Begin, Count) once for each ChunkSize slice of [0, Rows).
+template <typename BodyType>
+void ForEachChunk(int32 Rows, const FParallelTickConfig &Config,
+                  BodyType &&Body) {
+  const int32 ChunkSize = FMath::Max(1, Config.ChunkSize);
+  const int32 Chunks = NumChunks(Rows, ChunkSize);
+  const int32 Tasks =
+      Config.MaxWorkers > 0 ? FMath::Min(Chunks, Config.MaxWorkers) : Chunks;
+
+  // Task t owns chunks t, t + Tasks, t + 2*Tasks ... which caps concurrency
+  // at Tasks without changing what each chunk computes.
+  ParallelFor(
+      Tasks,
+      [&](int32 Task) {
+        for (int32 Chunk = Task; Chunk < Chunks; Chunk += Tasks) {
+          const int32 Begin = Chunk * ChunkSize;
+          Body(Begin, FMath::Min(ChunkSize, Rows - Begin));
+        }
+      },
+      Config.bSingleThread ? EParallelForFlags::ForceSingleThread
+                           : EParallelForFlags::None);
+}
+
+// Applies Heartbeat to rows [Begin, End). Same result as dispatching it to
+// each of them.
+inline void Tick(State::FBotStateTable &Table, int32 Begin, int32 End,
+                 const State::FActionTick &Heartbeat,
+                 const FParallelTickConfig &Config) {
+  check(Begin >= 0 && Begin <= End && End <= State::TableOps::Num(Table));
+  uint64 *TickCounts = Table.TickCounts.GetData() + Begin;
+  float *TimeSince = Table.TimeSinceLastSeenPlayer.GetData() + Begin;
+  bool *Aggro = Table.bHasAggro.GetData() + Begin;
+
+  ForEachChunk(End - Begin, Config, [=](int32 First, int32 Count) {
+    State::Batch::Tick(Count, TickCounts + First, TimeSince + First,
+                       Aggro + First, Heartbeat.DeltaTime, Heartbeat.Steps);
+  });
+}
+
+// Applies FActionTick to every row. Same result as TableOps::ReduceTick.
+inline void Tick(State::FBotStateTable &Table, float DeltaTime,
+                 const FParallelTickConfig &Config) {
+  State::FActionTick Heartbeat;
+  Heartbeat.DeltaTime = DeltaTime;
+  Tick(Table, 0, State::TableOps::Num(Table), Heartbeat, Config);
+}
+
+} // namespace ParallelOps
+
+} // namespace Bot
+} // namespace ForbocAI
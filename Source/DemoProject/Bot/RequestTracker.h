@@ -0,0 +1,184 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace ForbocAI {
+namespace Bot {
+
+// ── In-Flight Requests ──
+// Tracks agent requests per bot. At most one request per key is in flight,
+// at most MaxInFlight overall; everything else waits in a priority queue
+// (higher Priority first, FIFO within a priority). Each started request gets
+// a token, and a response is only accepted while its token is current, so
+// timed-out or cancelled requests can't land late.
+
+struct FRequestStats {
+  uint64 Started = 0;
+  uint64 Completed = 0;
+  uint64 TimedOut = 0;
+  uint64 Cancelled = 0;
+  // Came due while already pending or in flight; served by that request
+  uint64 Coalesced = 0;
+  int32 PeakPending = 0;
+  // Seconds, over completed requests
+  double TotalLatency = 0.0;
+  double MaxLatency = 0.0;
+};
+
+template <typename KeyType> struct TRequestTracker {
+  struct FInFlight {
+    uint64 Token;
+    double StartTime;
+  };
+
+  struct FPending {
+    KeyType Key;
+    int32 Priority;
+    uint64 Sequence;
+  };
+
+  // 0 = unlimited
+  int32 MaxInFlight = 16;
+  // 0 = never time out
+  double TimeoutSeconds = 15.0;
+
+  TMap<KeyType, FInFlight> InFlight;
+  TArray<FPending> PendingHeap;
+  TSet<KeyType> Pending;
+  uint64 NextToken = 1;
+  uint64 NextSequence = 0;
+  FRequestStats Stats;
+};
+
+namespace RequestOps {
+
+namespace Detail {
+
+struct FPendingOrder {
+  template <typename PendingType>
+  bool operator()(const PendingType &A, const PendingType &B) const {
+    return A.Priority != B.Priority ? A.Priority > B.Priority
+                                    : A.Sequence < B.Sequence;
+  }
+};
+
+} // namespace Detail
+
+template <typename KeyType>
+int32 NumInFlight(const TRequestTracker<KeyType> &Tracker) {
+  return Tracker.InFlight.Num();
+}
+
+template <typename KeyType>
+int32 NumPending(const TRequestTracker<KeyType> &Tracker) {
+  return Tracker.Pending.Num();
+}
+
+// Queues a request for Key. Returns false (and counts it as coalesced) if
+// Key already has one pending or in flight.
+template <typename KeyType>
+bool Enqueue(TRequestTracker<KeyType> &Tracker, const KeyType &Key,
+             int32 Priority) {
+  if (Tracker.InFlight.Contains(Key) || Tracker.Pending.Contains(Key)) {
+    ++Tracker.Stats.Coalesced;
+    return false;
+  }
+
+  Tracker.Pending.Add(Key);
+  Tracker.PendingHeap.HeapPush({Key, Priority, Tracker.NextSequence++},
+                               Detail::FPendingOrder());
+  Tracker.Stats.PeakPending =
+      FMath::Max(Tracker.Stats.PeakPending, Tracker.Pending.Num());
+  return true;
+}
+
+// Moves pending requests in flight while there is room, appending
+// (Key, Token) for each one started.
+template <typename KeyType>
+void Start(TRequestTracker<KeyType> &Tracker, double Now,
+           TArray<TPair<KeyType, uint64>> &OutStarted) {
+  using FPending = typename TRequestTracker<KeyType>::FPending;
+
+  while (Tracker.PendingHeap.Num() > 0 &&
+         (Tracker.MaxInFlight <= 0 ||
+          Tracker.InFlight.Num() < Tracker.MaxInFlight)) {
+    FPending Next;
+    Tracker.PendingHeap.HeapPop(Next, Detail::FPendingOrder(),
+                                EAllowShrinking::No);
+    Tracker.Pending.Remove(Next.Key);
+
+    const uint64 Token = Tracker.NextToken++;
+    Tracker.InFlight.Add(Next.Key, {Token, Now});
+    ++Tracker.Stats.Started;
+    OutStarted.Emplace(Next.Key, Token);
+  }
+}
+
+template <typename KeyType>
+bool IsCurrent(const TRequestTracker<KeyType> &Tracker, const KeyType &Key,
+               uint64 Token) {
+  const auto *Entry = Tracker.InFlight.Find(Key);
+  return Entry && Entry->Token == Token;
+}
+
+// Retires the request if Token is still current. Returns false for stale
+// (timed out, cancelled or superseded) responses, which should be dropped.
+template <typename KeyType>
+bool Complete(TRequestTracker<KeyType> &Tracker, const KeyType &Key,
+              uint64 Token, double Now) {
+  const auto *Entry = Tracker.InFlight.Find(Key);
+  if (!Entry || Entry->Token != Token) {
+    return false;
+  }
+
+  const double Latency = Now - Entry->StartTime;
+  Tracker.Stats.TotalLatency += Latency;
+  Tracker.Stats.MaxLatency = FMath::Max(Tracker.Stats.MaxLatency, Latency);
+  ++Tracker.Stats.Completed;
+
+  Tracker.InFlight.Remove(Key);
+  return true;
+}
+
+// Retires every request older than TimeoutSeconds, appending its key.
+template <typename KeyType>
+void CollectTimedOut(TRequestTracker<KeyType> &Tracker, double Now,
+                     TArray<KeyType> &OutTimedOut) {
+  if (Tracker.TimeoutSeconds <= 0.0) {
+    return;
+  }
+
+  for (auto It = Tracker.InFlight.CreateIterator(); It; ++It) {
+    if (Now - It.Value().StartTime >= Tracker.TimeoutSeconds) {
+      OutTimedOut.Add(It.Key());
+      ++Tracker.Stats.TimedOut;
+      It.RemoveCurrent();
+    }
+  }
+}
+
+// Drops Key's pending and in-flight requests; a late response is ignored.
+template <typename KeyType>
+void Cancel(TRequestTracker<KeyType> &Tracker, const KeyType &Key) {
+  if (Tracker.InFlight.Remove(Key) > 0) {
+    ++Tracker.Stats.Cancelled;
+  }
+
+  if (Tracker.Pending.Remove(Key) > 0) {
+    Tracker.PendingHeap.RemoveAll(
+        [&Key](const auto &Entry) { return Entry.Key == Key; });
+    Tracker.PendingHeap.Heapify(Detail::FPendingOrder());
+  }
+}
+
+template <typename KeyType> void CancelAll(TRequestTracker<KeyType> &Tracker) {
+  Tracker.Stats.Cancelled += Tracker.InFlight.Num();
+  Tracker.InFlight.Reset();
+  Tracker.Pending.Reset();
+  Tracker.PendingHeap.Reset();
+}
+
+} // namespace RequestOps
+
+} // namespace Bot
+} // namespace ForbocAI
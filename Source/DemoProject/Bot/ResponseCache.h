@@ -0,0 +1,148 @@
+#pragma once
+
+#include "AgentModule.h"
+#include "Bot/ActionHandlers.h"
+#include "Containers/LruCache.h"
+#include "CoreMinimal.h"
+#include "State/BotState.h"
+
+namespace ForbocAI {
+namespace Bot {
+
+// ── Response Cache ──
+// Bots whose state hasn't meaningfully changed ask the backend the same
+// question over and over. The state is quantized (health bucket, position
+// grid cell, phase) into a key; while a key answered for the same persona
+// is fresh (TTL) the cached action is reused instead of sending a request.
+// Capacity is bounded by LRU eviction.
+
+struct FObservationKeyConfig {
+  // Width of a health bucket as a fraction of MaxHealth
+  float HealthBucket = 0.1f;
+  // Edge of a position grid cell, in world units
+  float CellSize = 500.0f;
+};
+
+struct FObservationKey {
+  // The persona itself, not its hash: two personas whose hashes collide
+  // must never be served each other's actions
+  FName Persona;
+  int32 HealthBucket = 0;
+  int32 CellX = 0;
+  int32 CellY = 0;
+  int32 CellZ = 0;
+  State::EBotPhase Phase = State::EBotPhase::Idle;
+
+  bool operator==(const FObservationKey &Other) const {
+    return Persona == Other.Persona && HealthBucket == Other.HealthBucket &&
+           CellX == Other.CellX && CellY == Other.CellY &&
+           CellZ == Other.CellZ && Phase == Other.Phase;
+  }
+
+  friend uint32 GetTypeHash(const FObservationKey &Key) {
+    uint32 Hash = HashCombineFast(GetTypeHash(Key.Persona),
+                                  ::GetTypeHash(Key.CellX));
+    Hash = HashCombineFast(Hash, ::GetTypeHash(Key.CellY));
+    Hash = HashCombineFast(Hash, ::GetTypeHash(Key.CellZ));
+    return HashCombineFast(Hash, ::GetTypeHash(Key.HealthBucket * 8 +
+                                               (int32)Key.Phase));
+  }
+};
+
+struct FCachedResponse {
+  FAgentAction Action;
+  // Action as parsed when it arrived, so a hit doesn't parse it again
+  FParsedAction Parsed;
+  double ExpiresAt = 0.0;
+};
+
+struct FResponseCacheStats {
+  uint64 Hits = 0;
+  uint64 Misses = 0;
+  // Misses caused by an entry outliving its TTL
+  uint64 Expired = 0;
+};
+
+struct FResponseCache {
+  TLruCache<FObservationKey, FCachedResponse> Entries;
+  double TtlSeconds = 30.0;
+  FResponseCacheStats Stats;
+
+  explicit FResponseCache(int32 Capacity = 1024) : Entries(Capacity) {}
+};
+
+namespace CacheOps {
+
+inline FObservationKey MakeKey(const State::FStats &Stats,
+                               const FVector &Position, State::EBotPhase Phase,
+                               FName Persona,
+                               const FObservationKeyConfig &Config) {
+  const float Health =
+      Stats.MaxHealth > 0.0f ? Stats.Health / Stats.MaxHealth : 0.0f;
+  const double Cell = FMath::Max(Config.CellSize, 1.0f);
+
+  FObservationKey Key;
+  Key.Persona = Persona;
+  Key.HealthBucket = FMath::FloorToInt32(
+      Health / FMath::Max(Config.HealthBucket, KINDA_SMALL_NUMBER));
+  Key.CellX = FMath::FloorToInt32(Position.X / Cell);
+  Key.CellY = FMath::FloorToInt32(Position.Y / Cell);
+  Key.CellZ = FMath::FloorToInt32(Position.Z / Cell);
+  Key.Phase = Phase;
+  return Key;
+}
+
+inline FObservationKey MakeKey(const State::FBotState &State,
+                               FName Persona,
+                               const FObservationKeyConfig &Config) {
+  return MakeKey(State.Stats, State.Position, State.Phase, Persona, Config);
+}
+
+// Returns the cached response for Key, or nullptr on a miss. Expired
+// entries are dropped on lookup.
+inline const FCachedResponse *FindEntry(FResponseCache &Cache,
+                                        const FObservationKey &Key,
+                                        double Now) {
+  const FCachedResponse *Entry = Cache.Entries.FindAndTouch(Key);
+  if (Entry && Entry->ExpiresAt <= Now) {
+    Cache.Entries.Remove(Key);
+    ++Cache.Stats.Expired;
+    Entry = nullptr;
+  }
+
+  if (!Entry) {
+    ++Cache.Stats.Misses;
+    return nullptr;
+  }
+
+  ++Cache.Stats.Hits;
+  return Entry;
+}
+
+// FindEntry's action.
+inline const FAgentAction *Find(FResponseCache &Cache,
+                                const FObservationKey &Key, double Now) {
+  const FCachedResponse *Entry = FindEntry(Cache, Key, Now);
+  return Entry ? &Entry->Action : nullptr;
+}
+
+inline void Store(FResponseCache &Cache, const FObservationKey &Key,
+                  const FAgentAction &Action, const FParsedAction &Parsed,
+                  double Now) {
+  Cache.Entries.Add(Key, {Action, Parsed, Now + Cache.TtlSeconds});
+}
+
+inline void Store(FResponseCache &Cache, const FObservationKey &Key,
+                  const FAgentAction &Action, double Now) {
+  Store(Cache, Key, Action, ActionHandlerOps::Parse(Action), Now);
+}
+
+// Drops every entry; a different capacity takes effect from here on.
+inline void Reset(FResponseCache &Cache, int32 Capacity) {
+  Cache.Entries.Empty(FMath::Max(1, Capacity));
+}
+
+} // namespace CacheOps
+
+} // namespace Bot
+} // namespace ForbocAI
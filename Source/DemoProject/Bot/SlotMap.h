@@ -0,0 +1,138 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace ForbocAI {
+namespace Bot {
+
+// ── Bot Handles (Generational Slot Map) ──
+// A handle names a slot plus the generation the slot had when the value was
+// added. Removing a value bumps its slot's generation, so old handles stop
+// resolving instead of aliasing whatever reuses the slot. Values themselves
+// live packed in Dense; removal swaps the last value into the hole, so
+// iteration is a straight walk and a value's dense index can change.
+
+struct FBotHandle {
+  int32 Index = INDEX_NONE;
+  uint32 Generation = 0;
+
+  bool IsSet() const { return Index != INDEX_NONE; }
+
+  bool operator==(const FBotHandle &Other) const {
+    return Index == Other.Index && Generation == Other.Generation;
+  }
+  bool operator!=(const FBotHandle &Other) const { return !(*this == Other); }
+
+  friend uint32 GetTypeHash(const FBotHandle &Handle) {
+    return HashCombineFast(::GetTypeHash(Handle.Index),
+                           ::GetTypeHash(Handle.Generation));
+  }
+};
+
+template <typename ValueType> struct TSlotMap {
+  struct FSlot {
+    int32 Dense = INDEX_NONE;
+    uint32 Generation = 1;
+  };
+
+  TArray<FSlot> Slots;
+  TArray<int32> FreeSlots;
+
+  // Packed values and, per dense index, the slot that owns it
+  TArray<ValueType> Dense;
+  TArray<int32> DenseToSlot;
+};
+
+namespace SlotMapOps {
+
+template <typename ValueType> int32 Num(const TSlotMap<ValueType> &Map) {
+  return Map.Dense.Num();
+}
+
+template <typename ValueType>
+void Reserve(TSlotMap<ValueType> &Map, int32 Capacity) {
+  Map.Slots.Reserve(Capacity);
+  Map.Dense.Reserve(Capacity);
+  Map.DenseToSlot.Reserve(Capacity);
+}
+
+// Dense index of Handle's value, or INDEX_NONE if the handle is stale.
+template <typename ValueType>
+int32 DenseIndex(const TSlotMap<ValueType> &Map, FBotHandle Handle) {
+  if (!Map.Slots.IsValidIndex(Handle.Index)) {
+    return INDEX_NONE;
+  }
+  const auto &Slot = Map.Slots[Handle.Index];
+  return Slot.Generation == Handle.Generation ? Slot.Dense : INDEX_NONE;
+}
+
+template <typename ValueType>
+ValueType *Find(TSlotMap<ValueType> &Map, FBotHandle Handle) {
+  const int32 Index = DenseIndex(Map, Handle);
+  return Index != INDEX_NONE ? &Map.Dense[Index] : nullptr;
+}
+
+template <typename ValueType>
+const ValueType *Find(const TSlotMap<ValueType> &Map, FBotHandle Handle) {
+  const int32 Index = DenseIndex(Map, Handle);
+  return Index != INDEX_NONE ? &Map.Dense[Index] : nullptr;
+}
+
+// Handle of the value at a dense index.
+template <typename ValueType>
+FBotHandle HandleAt(const TSlotMap<ValueType> &Map, int32 DenseIndex) {
+  const int32 Slot = Map.DenseToSlot[DenseIndex];
+  return {Slot, Map.Slots[Slot].Generation};
+}
+
+// Appends Value at dense index Num() and returns its handle.
+template <typename ValueType>
+FBotHandle Add(TSlotMap<ValueType> &Map, ValueType Value) {
+  const int32 Slot =
+      Map.FreeSlots.Num() > 0 ? Map.FreeSlots.Pop() : Map.Slots.AddDefaulted();
+
+  Map.Slots[Slot].Dense = Map.Dense.Add(MoveTemp(Value));
+  Map.DenseToSlot.Add(Slot);
+  return {Slot, Map.Slots[Slot].Generation};
+}
+
+// Removes Handle's value by moving the last value into its dense index.
+// Returns that index (the caller mirrors the swap in any parallel arrays),
+// or INDEX_NONE if the handle was stale.
+template <typename ValueType>
+int32 RemoveSwap(TSlotMap<ValueType> &Map, FBotHandle Handle) {
+  const int32 Hole = DenseIndex(Map, Handle);
+  if (Hole == INDEX_NONE) {
+    return INDEX_NONE;
+  }
+
+  const int32 Last = Map.Dense.Num() - 1;
+  if (Hole != Last) {
+    Map.Slots[Map.DenseToSlot[Last]].Dense = Hole;
+  }
+  Map.Dense.RemoveAtSwap(Hole, 1, EAllowShrinking::No);
+  Map.DenseToSlot.RemoveAtSwap(Hole, 1, EAllowShrinking::No);
+
+  auto &Slot = Map.Slots[Handle.Index];
+  Slot.Dense = INDEX_NONE;
+  ++Slot.Generation;
+  Map.FreeSlots.Add(Handle.Index);
+  return Hole;
+}
+
+// Exchanges the values at two dense indices; their handles stay valid.
+template <typename ValueType>
+void SwapDense(TSlotMap<ValueType> &Map, int32 A, int32 B) {
+  if (A == B) {
+    return;
+  }
+  Map.Dense.Swap(A, B);
+  Map.DenseToSlot.Swap(A, B);
+  Map.Slots[Map.DenseToSlot[A]].Dense = A;
+  Map.Slots[Map.DenseToSlot[B]].Dense = B;
+}
+
+} // namespace SlotMapOps
+
+} // namespace Bot
+} // namespace ForbocAI
@@ -0,0 +1,213 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace ForbocAI {
+namespace Bot {
+
+// ── Spatial Grid ──
+// A uniform grid over the XY plane. Each cell holds the keys inside it along
+// with their last known position, so a radius query only touches the cells
+// the circle overlaps and never goes back to the state table. Positions are
+// pushed in by whoever changes them (the orchestrator, on FActionMove).
+
+template <typename KeyType> struct TSpatialGrid {
+  struct FEntry {
+    KeyType Key;
+    FVector Position;
+  };
+
+  float CellSize = 2000.0f;
+  TMap<FIntPoint, TArray<FEntry>> Cells;
+  TMap<KeyType, FIntPoint> CellOf;
+};
+
+namespace GridOps {
+
+template <typename KeyType>
+FIntPoint CellAt(const TSpatialGrid<KeyType> &Grid, const FVector &Position) {
+  return FIntPoint(FMath::FloorToInt32(Position.X / Grid.CellSize),
+                   FMath::FloorToInt32(Position.Y / Grid.CellSize));
+}
+
+template <typename KeyType> int32 Num(const TSpatialGrid<KeyType> &Grid) {
+  return Grid.CellOf.Num();
+}
+
+template <typename KeyType>
+void Remove(TSpatialGrid<KeyType> &Grid, const KeyType &Key) {
+  FIntPoint Cell;
+  if (!Grid.CellOf.RemoveAndCopyValue(Key, Cell)) {
+    return;
+  }
+
+  TArray<typename TSpatialGrid<KeyType>::FEntry> &Entries =
+      Grid.Cells.FindChecked(Cell);
+  Entries.RemoveAllSwap([&Key](const auto &Entry) { return Entry.Key == Key; },
+                        EAllowShrinking::No);
+  if (Entries.Num() == 0) {
+    Grid.Cells.Remove(Cell);
+  }
+}
+
+// Adds Key at Position, or moves it there if it is already in the grid.
+template <typename KeyType>
+void Update(TSpatialGrid<KeyType> &Grid, const KeyType &Key,
+            const FVector &Position) {
+  const FIntPoint Cell = CellAt(Grid, Position);
+  if (const FIntPoint *Current = Grid.CellOf.Find(Key)) {
+    if (*Current == Cell) {
+      for (auto &Entry : Grid.Cells.FindChecked(Cell)) {
+        if (Entry.Key == Key) {
+          Entry.Position = Position;
+          break;
+        }
+      }
+      return;
+    }
+    Remove(Grid, Key);
+  }
+
+  Grid.Cells.FindOrAdd(Cell).Add({Key, Position});
+  Grid.CellOf.Add(Key, Cell);
+}
+
+// Re-buckets every entry under a new cell size.
+template <typename KeyType>
+void SetCellSize(TSpatialGrid<KeyType> &Grid, float CellSize) {
+  CellSize = FMath::Max(CellSize, 1.0f);
+  if (CellSize == Grid.CellSize) {
+    return;
+  }
+
+  TMap<FIntPoint, TArray<typename TSpatialGrid<KeyType>::FEntry>> Cells =
+      MoveTemp(Grid.Cells);
+  Grid.Cells.Reset();
+  Grid.CellOf.Reset();
+  Grid.CellSize = CellSize;
+  for (const auto &Cell : Cells) {
+    for (const auto &Entry : Cell.Value) {
+      Update(Grid, Entry.Key, Entry.Position);
+    }
+  }
+}
+
+// Calls Fn(Key, Position, DistSquared) for every key within Radius of
+// Center.
+template <typename KeyType, typename FnType>
+void ForEachInRadius(const TSpatialGrid<KeyType> &Grid, const FVector &Center,
+                     float Radius, FnType &&Fn) {
+  const FIntPoint Min = CellAt(Grid, Center - FVector(Radius, Radius, 0.0f));
+  const FIntPoint Max = CellAt(Grid, Center + FVector(Radius, Radius, 0.0f));
+  const double RadiusSquared = (double)Radius * Radius;
+
+  for (int32 Y = Min.Y; Y <= Max.Y; ++Y) {
+    for (int32 X = Min.X; X <= Max.X; ++X) {
+      const auto *Entries = Grid.Cells.Find(FIntPoint(X, Y));
+      if (!Entries) {
+        continue;
+      }
+      for (const auto &Entry : *Entries) {
+        const double DistSquared = FVector::DistSquared(Entry.Position, Center);
+        if (DistSquared <= RadiusSquared) {
+          Fn(Entry.Key, Entry.Position, DistSquared);
+        }
+      }
+    }
+  }
+}
+
+} // namespace GridOps
+
+// ── Perception ──
+// Batch proximity between bots in the grid and a handful of players. A
+// sighting is reported only on the pass a bot first comes within SpotRadius
+// of some player, not on every pass it stays there. Bots within WakeRadius
+// of any player are "near", with the distance to the nearest one;
+// everything else can sleep.
+
+struct FPerceptionConfig {
+  float SpotRadius = 1500.0f;
+  float WakeRadius = 5000.0f;
+};
+
+template <typename KeyType> struct TPerception {
+  TSpatialGrid<KeyType> Grid;
+
+  // Bots within SpotRadius as of the last pass
+  TSet<KeyType> Spotting;
+  TSet<KeyType> NextSpotting;
+};
+
+template <typename KeyType> struct TSighting {
+  KeyType Key;
+  // The nearest player in range
+  FVector PlayerLocation;
+};
+
+namespace PerceptionOps {
+
+// Runs one pass over Players. OutEntered gets the bots that came into
+// SpotRadius since the last pass; OutNear every bot within WakeRadius and
+// its squared distance to the nearest player.
+template <typename KeyType>
+void Sense(TPerception<KeyType> &Perception,
+           TArrayView<const FVector> Players, const FPerceptionConfig &Config,
+           TArray<TSighting<KeyType>> &OutEntered,
+           TMap<KeyType, double> &OutNear) {
+  OutEntered.Reset();
+  OutNear.Reset();
+  Perception.NextSpotting.Reset();
+
+  const double SpotSquared = (double)Config.SpotRadius * Config.SpotRadius;
+  const float QueryRadius = FMath::Max(Config.SpotRadius, Config.WakeRadius);
+
+  // Nearest player per newly spotting bot; few players, so a linear
+  // lookup into OutEntered stays cheap
+  TArray<double> EnteredDistances;
+  for (const FVector &Player : Players) {
+    GridOps::ForEachInRadius(
+        Perception.Grid, Player, QueryRadius,
+        [&](const KeyType &Key, const FVector &, double DistSquared) {
+          if (DistSquared <= (double)Config.WakeRadius * Config.WakeRadius) {
+            double &Nearest = OutNear.FindOrAdd(Key, DistSquared);
+            Nearest = FMath::Min(Nearest, DistSquared);
+          }
+          if (DistSquared > SpotSquared) {
+            return;
+          }
+
+          bool bAlreadySpotting = false;
+          Perception.NextSpotting.Add(Key, &bAlreadySpotting);
+          if (Perception.Spotting.Contains(Key)) {
+            return;
+          }
+          if (!bAlreadySpotting) {
+            OutEntered.Add({Key, Player});
+            EnteredDistances.Add(DistSquared);
+            return;
+          }
+          for (int32 Index = 0; Index < OutEntered.Num(); ++Index) {
+            if (OutEntered[Index].Key == Key &&
+                DistSquared < EnteredDistances[Index]) {
+              OutEntered[Index].PlayerLocation = Player;
+              EnteredDistances[Index] = DistSquared;
+            }
+          }
+        });
+  }
+
+  Swap(Perception.Spotting, Perception.NextSpotting);
+}
+
+// Drops a bot that left the world, so it re-enters cleanly if it returns.
+template <typename KeyType>
+void Remove(TPerception<KeyType> &Perception, const KeyType &Key) {
+  GridOps::Remove(Perception.Grid, Key);
+  Perception.Spotting.Remove(Key);
+}
+
+} // namespace PerceptionOps
+
+} // namespace Bot
+} // namespace ForbocAI
@@ -0,0 +1,138 @@
+#pragma once
+
+#include "Bot/Factories/BotFactory.h"
+#include "CoreMinimal.h"
+#include "State/BotState.h"
+#include "State/BotStateTable.h"
+
+namespace ForbocAI {
+namespace Bot {
+
+// ── Store Pool ──
+// Backing storage for table store views. CreateBotStoreView allocates a
+// shared scratch state plus two closures big enough to spill to the heap;
+// churning bots through it fragments the heap. The pool instead hands out
+// slots from fixed-size chunks that never move, and a store over a slot
+// captures only the slot pointer, which std::function keeps inline.
+// Released slots go on a free list and are reused before a new chunk is
+// allocated, so a steady spawn/despawn cycle allocates nothing.
+//
+// A slot names its row, not its bot: when a bot is swap-moved to another
+// row, updating Slot->Row retargets its existing store.
+
+struct FStoreSlot {
+  State::FBotStateTable *Table = nullptr;
+  int32 Row = INDEX_NONE;
+  State::FBotState Scratch;
+};
+
+struct FStorePoolStats {
+  int32 Live = 0;
+  int32 HighWater = 0;
+  int64 Acquired = 0;
+  // Acquires served from the free list rather than fresh chunk space
+  int64 Recycled = 0;
+};
+
+struct FBotStorePool {
+  static constexpr int32 ChunkSize = 256;
+
+  TArray<TUniquePtr<FStoreSlot[]>> Chunks;
+  TArray<FStoreSlot *> FreeSlots;
+  // Slots of the newest chunk not handed out yet
+  int32 ChunkUsed = ChunkSize;
+
+  FStorePoolStats Stats;
+};
+
+namespace PoolOps {
+
+inline int32 Capacity(const FBotStorePool &Pool) {
+  return Pool.Chunks.Num() * FBotStorePool::ChunkSize;
+}
+
+// Grows the pool so Count slots can be live without further allocation.
+inline void Reserve(FBotStorePool &Pool, int32 Count) {
+  const int32 Spare =
+      Pool.FreeSlots.Num() + (FBotStorePool::ChunkSize - Pool.ChunkUsed);
+  const int32 Missing = Count - Pool.Stats.Live - Spare;
+  if (Missing <= 0) {
+    return;
+  }
+
+  // Whatever is left of the current chunk goes on the free list first
+  if (Pool.Chunks.Num() > 0) {
+    FStoreSlot *Chunk = Pool.Chunks.Last().Get();
+    for (; Pool.ChunkUsed < FBotStorePool::ChunkSize; ++Pool.ChunkUsed) {
+      Pool.FreeSlots.Add(&Chunk[Pool.ChunkUsed]);
+    }
+  }
+
+  const int32 NewChunks =
+      FMath::DivideAndRoundUp(Missing, FBotStorePool::ChunkSize);
+  Pool.FreeSlots.Reserve(Pool.FreeSlots.Num() +
+                         NewChunks * FBotStorePool::ChunkSize);
+  for (int32 Index = 0; Index < NewChunks; ++Index) {
+    Pool.Chunks.Add(MakeUnique<FStoreSlot[]>(FBotStorePool::ChunkSize));
+    FStoreSlot *Chunk = Pool.Chunks.Last().Get();
+    for (int32 Slot = FBotStorePool::ChunkSize - 1; Slot >= 0; --Slot) {
+      Pool.FreeSlots.Add(&Chunk[Slot]);
+    }
+  }
+}
+
+// Takes a slot viewing Table's Row, preferring a recycled one.
+inline FStoreSlot *Acquire(FBotStorePool &Pool, State::FBotStateTable &Table,
+                           int32 Row) {
+  FStoreSlot *Slot = nullptr;
+  if (Pool.FreeSlots.Num() > 0) {
+    Slot = Pool.FreeSlots.Pop(EAllowShrinking::No);
+    ++Pool.Stats.Recycled;
+  } else {
+    if (Pool.ChunkUsed == FBotStorePool::ChunkSize) {
+      Pool.Chunks.Add(MakeUnique<FStoreSlot[]>(FBotStorePool::ChunkSize));
+      Pool.ChunkUsed = 0;
+    }
+    Slot = &Pool.Chunks.Last()[Pool.ChunkUsed++];
+  }
+
+  Slot->Table = &Table;
+  Slot->Row = Row;
+  State::TableOps::ReadRow(Table, Row, Slot->Scratch);
+
+  ++Pool.Stats.Acquired;
+  Pool.Stats.HighWater = FMath::Max(Pool.Stats.HighWater, ++Pool.Stats.Live);
+  return Slot;
+}
+
+// Returns a slot to the pool. Stores over it must not be called afterwards.
+inline void Release(FBotStorePool &Pool, FStoreSlot *Slot) {
+  check(Slot && Pool.Stats.Live > 0);
+  Slot->Table = nullptr;
+  Slot->Row = INDEX_NONE;
+  Pool.FreeSlots.Add(Slot);
+  --Pool.Stats.Live;
+}
+
+// Same contract as Factory::CreateBotStoreView, over a pooled slot.
+inline FBotStore CreateStore(FStoreSlot *Slot) {
+  Dispatcher Dispatch =
+      [Slot](const State::FBotAction &Action) -> const State::FBotState & {
+    State::TableOps::ReadRow(*Slot->Table, Slot->Row, Slot->Scratch);
+    State::ReduceInPlace(Slot->Scratch, Action);
+    State::TableOps::WriteRow(*Slot->Table, Slot->Row, Slot->Scratch);
+    return Slot->Scratch;
+  };
+
+  StateGetter GetState = [Slot]() -> const State::FBotState & {
+    State::TableOps::ReadRow(*Slot->Table, Slot->Row, Slot->Scratch);
+    return Slot->Scratch;
+  };
+
+  return {std::move(Dispatch), std::move(GetState)};
+}
+
+} // namespace PoolOps
+
+} // namespace Bot
+} // namespace ForbocAI
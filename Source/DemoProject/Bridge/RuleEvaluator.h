@@ -0,0 +1,189 @@
+#pragma once
+
+#include "Bridge/RuleRegistry.h"
+#include "BridgeModule.h"
+#include "CoreMinimal.h"
+
+namespace ForbocAI {
+namespace Bridge {
+
+// ── Compiled Rules ──
+// A rule set flattened for the response path. At compile time each rule is
+// filed under every action type it lists (rules listing none apply to every
+// type and are filed everywhere), so validating an action only runs the
+// rules for its type, found with one hash lookup. Within a bucket rules run
+// most-rejecting first, as measured, and the first rejection ends the
+// check; buckets are re-sorted every ReorderInterval validations.
+//
+// The verdict is the same as BridgeOps::Validate over the whole set. When
+// several rules reject an action, the reason reported may come from a
+// different one. Not thread-safe: keep one evaluator per thread of use.
+
+struct FRuleEvaluator {
+  struct FEntry {
+    const FValidationRule *Rule = nullptr;
+    uint64 Checked = 0;
+    uint64 Rejected = 0;
+  };
+
+  // Keeps the rules Entries point into alive
+  FRuleSetPtr Rules;
+  TArray<FEntry> Entries;
+
+  // Action type -> entry indices, in evaluation order. Keys compare like
+  // FAgentAction::Type does (case-insensitively).
+  TMap<FString, TArray<int32>> Buckets;
+  // Entries for types no rule lists
+  TArray<int32> AnyType;
+
+  uint32 ReorderInterval = 1024;
+  uint32 SinceReorder = 0;
+
+  uint64 Validated = 0;
+  uint64 Rejected = 0;
+};
+
+namespace RuleEvaluatorOps {
+
+namespace Detail {
+
+inline void SortBucket(const FRuleEvaluator &Evaluator,
+                       TArray<int32> &Bucket) {
+  // Laplace-smoothed so barely checked rules don't jump to the front
+  auto Rate = [&Evaluator](int32 Entry) {
+    const FRuleEvaluator::FEntry &Current = Evaluator.Entries[Entry];
+    return (Current.Rejected + 1.0) / (Current.Checked + 2.0);
+  };
+  // Ties keep authored order, which is also entry order
+  Bucket.Sort([&Rate](int32 A, int32 B) {
+    const double RateA = Rate(A);
+    const double RateB = Rate(B);
+    return RateA != RateB ? RateA > RateB : A < B;
+  });
+}
+
+inline FValidationResult Pass() {
+  FValidationResult Result;
+  Result.bValid = true;
+  return Result;
+}
+
+} // namespace Detail
+
+inline void Compile(FRuleEvaluator &Evaluator, FRuleSetPtr Rules) {
+  Evaluator.Entries.Reset();
+  Evaluator.Buckets.Reset();
+  Evaluator.AnyType.Reset();
+  Evaluator.SinceReorder = 0;
+  Evaluator.Validated = 0;
+  Evaluator.Rejected = 0;
+  Evaluator.Rules = MoveTemp(Rules);
+  if (!Evaluator.Rules.IsValid()) {
+    return;
+  }
+
+  const FRuleSet &Set = *Evaluator.Rules;
+  for (int32 Index = 0; Index < Set.Num(); ++Index) {
+    FRuleEvaluator::FEntry &Entry = Evaluator.Entries.AddDefaulted_GetRef();
+    Entry.Rule = &Set[Index];
+    for (const FString &ActionType : Set[Index].ActionTypes) {
+      TArray<int32> &Bucket = Evaluator.Buckets.FindOrAdd(ActionType);
+      if (Bucket.Num() == 0 || Bucket.Last() != Index) {
+        Bucket.Add(Index);
+      }
+    }
+  }
+
+  // Rules for every type go into every bucket, in authored order
+  for (int32 Index = 0; Index < Set.Num(); ++Index) {
+    if (Set[Index].ActionTypes.Num() > 0) {
+      continue;
+    }
+    Evaluator.AnyType.Add(Index);
+    for (auto &Bucket : Evaluator.Buckets) {
+      Bucket.Value.Add(Index);
+    }
+  }
+  for (auto &Bucket : Evaluator.Buckets) {
+    Bucket.Value.Sort();
+  }
+}
+
+// Rules that apply to ActionType, in evaluation order.
+inline const TArray<int32> &RulesFor(const FRuleEvaluator &Evaluator,
+                                     const FString &ActionType) {
+  const TArray<int32> *Bucket = Evaluator.Buckets.Find(ActionType);
+  return Bucket ? *Bucket : Evaluator.AnyType;
+}
+
+// Re-sorts every bucket by rejection rate so far.
+inline void Reorder(FRuleEvaluator &Evaluator) {
+  for (auto &Bucket : Evaluator.Buckets) {
+    Detail::SortBucket(Evaluator, Bucket.Value);
+  }
+  Detail::SortBucket(Evaluator, Evaluator.AnyType);
+  Evaluator.SinceReorder = 0;
+}
+
+// Runs Rules (from RulesFor) over Action, stopping at the first rejection.
+inline FValidationResult Run(FRuleEvaluator &Evaluator,
+                             const TArray<int32> &Rules,
+                             const FAgentAction &Action,
+                             const FBridgeValidationContext &Context) {
+  ++Evaluator.Validated;
+  for (const int32 Index : Rules) {
+    FRuleEvaluator::FEntry &Entry = Evaluator.Entries[Index];
+    ++Entry.Checked;
+    FValidationResult Result = Entry.Rule->Validator(Action, Context);
+    if (!Result.bValid) {
+      ++Entry.Rejected;
+      ++Evaluator.Rejected;
+      return Result;
+    }
+  }
+  return Detail::Pass();
+}
+
+inline FValidationResult Validate(FRuleEvaluator &Evaluator,
+                                  const FAgentAction &Action,
+                                  const FBridgeValidationContext &Context) {
+  if (Evaluator.ReorderInterval > 0 &&
+      ++Evaluator.SinceReorder >= Evaluator.ReorderInterval) {
+    Reorder(Evaluator);
+  }
+  return Run(Evaluator, RulesFor(Evaluator, Action.Type), Action, Context);
+}
+
+// Validates every action into OutResults (same order). ContextOf(Index)
+// returns the context for Actions[Index]. Runs of the same action type
+// share one bucket lookup, and reordering waits until the batch is done.
+template <typename ContextFnType>
+void ValidateBatch(FRuleEvaluator &Evaluator,
+                   TArrayView<const FAgentAction> Actions,
+                   ContextFnType &&ContextOf,
+                   TArray<FValidationResult> &OutResults) {
+  OutResults.Reset(Actions.Num());
+
+  const FString *LastType = nullptr;
+  const TArray<int32> *Rules = nullptr;
+  for (int32 Index = 0; Index < Actions.Num(); ++Index) {
+    const FAgentAction &Action = Actions[Index];
+    if (!LastType ||
+        !LastType->Equals(Action.Type, ESearchCase::IgnoreCase)) {
+      LastType = &Action.Type;
+      Rules = &RulesFor(Evaluator, Action.Type);
+    }
+    OutResults.Add(Run(Evaluator, *Rules, Action, ContextOf(Index)));
+  }
+
+  Evaluator.SinceReorder += (uint32)Actions.Num();
+  if (Evaluator.ReorderInterval > 0 &&
+      Evaluator.SinceReorder >= Evaluator.ReorderInterval) {
+    Reorder(Evaluator);
+  }
+}
+
+} // namespace RuleEvaluatorOps
+
+} // namespace Bridge
+} // namespace ForbocAI
@@ -0,0 +1,242 @@
+#include "RuleRegistry.h"
+#include "DemoProject.h"
+#include "Engine/World.h"
+#include "Hash/CityHash.h"
+#include "HttpModule.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Misc/ScopeLock.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
+
+namespace ForbocAI {
+namespace Bridge {
+namespace RuleRegistryOps {
+
+const TCHAR *const BatchPath = TEXT("/rules/register/batch");
+
+namespace {
+
+// Registers Rules with ApiUrl unless that was done before. Called with the
+// registry unlocked, since the registrar may complete straight away.
+void RegisterOnce(FRuleRegistry &Registry, const FRuleSetPtr &Rules,
+                  const FString &ApiUrl) {
+  FRuleRegistrar Registrar;
+  {
+    FScopeLock Guard(&Registry.Lock);
+    bool bAlreadyRegistered = false;
+    Registry.Registered.Add({Rules.Get(), ApiUrl}, &bAlreadyRegistered);
+    if (bAlreadyRegistered)
+      return;
+    ++Registry.Stats.Registrations;
+    Registrar = Registry.Registrar;
+  }
+
+  if (!Registrar) {
+    Registrar = [&Registry](const FString &ApiUrl, FRuleSetPtr Rules,
+                            TFunction<void(bool bOk)> OnComplete) {
+      RegisterBatch(Registry, ApiUrl, MoveTemp(Rules), MoveTemp(OnComplete));
+    };
+  }
+  Registrar(ApiUrl, Rules, [&Registry](bool bOk) {
+    if (!bOk) {
+      FScopeLock Guard(&Registry.Lock);
+      ++Registry.Stats.Failed;
+    }
+  });
+}
+
+// The interned copy of Rules, adding it if it's new. Registry locked.
+FRuleSetPtr InternLocked(FRuleRegistry &Registry, uint64 Hash,
+                         FRuleSet &&Rules) {
+  for (auto It = Registry.Sets.CreateConstKeyIterator(Hash); It; ++It) {
+    if (SameRules(*It.Value(), Rules)) {
+      return It.Value();
+    }
+  }
+  FRuleSetPtr Set = MakeShared<const FRuleSet, ESPMode::ThreadSafe>(
+      MoveTemp(Rules));
+  Registry.Sets.Add(Hash, Set);
+  Registry.Stats.Sets = Registry.Sets.Num();
+  return Set;
+}
+
+} // namespace
+
+FRuleRegistry &Get() {
+  static FRuleRegistry Registry;
+  // Registrations last for the session; see EndSession
+  static const FDelegateHandle Cleanup =
+      FWorldDelegates::OnWorldCleanup.AddLambda(
+          [](UWorld *World, bool, bool) {
+            if (World && World->IsGameWorld()) {
+              EndSession(Registry);
+            }
+          });
+  return Registry;
+}
+
+uint64 HashRules(TArrayView<const FValidationRule> Rules) {
+  // Separators can't appear in ids, names or action types
+  FString Content;
+  for (const FValidationRule &Rule : Rules) {
+    Content += Rule.Id;
+    Content += TEXT('\x1f');
+    Content += Rule.Name;
+    for (const FString &ActionType : Rule.ActionTypes) {
+      Content += TEXT('\x1f');
+      Content += ActionType;
+    }
+    Content += TEXT('\x1e');
+  }
+
+  const FTCHARToUTF8 Utf8(*Content);
+  return CityHash64(Utf8.Get(), Utf8.Length());
+}
+
+bool SameRules(TArrayView<const FValidationRule> A,
+               TArrayView<const FValidationRule> B) {
+  if (A.Num() != B.Num()) {
+    return false;
+  }
+  for (int32 Index = 0; Index < A.Num(); ++Index) {
+    const FValidationRule &RuleA = A[Index];
+    const FValidationRule &RuleB = B[Index];
+    if (RuleA.Id != RuleB.Id || RuleA.Name != RuleB.Name ||
+        RuleA.ActionTypes != RuleB.ActionTypes ||
+        !RuleA.Validator != !RuleB.Validator) {
+      return false;
+    }
+  }
+  return true;
+}
+
+FString BuildRequestBody(TArrayView<const FValidationRule> Rules) {
+  FString Body;
+  auto Writer =
+      TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(
+          &Body);
+
+  Writer->WriteObjectStart();
+  Writer->WriteArrayStart(TEXT("rules"));
+  for (const FValidationRule &Rule : Rules) {
+    Writer->WriteObjectStart();
+    Writer->WriteValue(TEXT("id"), Rule.Id);
+    Writer->WriteValue(TEXT("name"), Rule.Name);
+    Writer->WriteValue(TEXT("actionTypes"), Rule.ActionTypes);
+    Writer->WriteObjectEnd();
+  }
+  Writer->WriteArrayEnd();
+  Writer->WriteObjectEnd();
+  Writer->Close();
+
+  return Body;
+}
+
+void RegisterBatch(FRuleRegistry &Registry, const FString &ApiUrl,
+                   FRuleSetPtr Rules, TFunction<void(bool bOk)> OnComplete) {
+  bool bHasBatchRoute = false;
+  {
+    FScopeLock Guard(&Registry.Lock);
+    bHasBatchRoute = !Registry.NoBatchRoute.Contains(ApiUrl);
+  }
+  if (!bHasBatchRoute) {
+    for (const FValidationRule &Rule : *Rules) {
+      BridgeOps::RegisterRule(Rule, ApiUrl);
+    }
+    OnComplete(false);
+    return;
+  }
+
+  TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request =
+      FHttpModule::Get().CreateRequest();
+  Request->SetURL(ApiUrl + BatchPath);
+  Request->SetVerb(TEXT("POST"));
+  Request->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+  Request->SetContentAsString(BuildRequestBody(*Rules));
+
+  Request->OnProcessRequestComplete().BindLambda(
+      [&Registry, ApiUrl, Rules, OnComplete = MoveTemp(OnComplete)](
+          FHttpRequestPtr, FHttpResponsePtr Response, bool bConnected) {
+        const int32 Code =
+            bConnected && Response.IsValid() ? Response->GetResponseCode() : 0;
+        const bool bOk = EHttpResponseCodes::IsOk(Code);
+        if (Code == EHttpResponseCodes::NotFound ||
+            Code == EHttpResponseCodes::BadMethod ||
+            Code == EHttpResponseCodes::NotSupported) {
+          UE_LOG(LogForbocAI, Display,
+                 TEXT("RuleRegistry: %s has no batch route, registering "
+                      "rules one by one"),
+                 *ApiUrl);
+          FScopeLock Guard(&Registry.Lock);
+          Registry.NoBatchRoute.Add(ApiUrl);
+        }
+        if (!bOk) {
+          UE_LOG(LogForbocAI, Warning,
+                 TEXT("RuleRegistry: batch of %d rules failed, falling back"),
+                 Rules->Num());
+          for (const FValidationRule &Rule : *Rules) {
+            BridgeOps::RegisterRule(Rule, ApiUrl);
+          }
+        }
+        OnComplete(bOk);
+      });
+
+  Request->ProcessRequest();
+}
+
+FRuleSetPtr Acquire(FRuleRegistry &Registry, FRuleSet Rules,
+                    const FString &ApiUrl) {
+  const uint64 Hash = HashRules(Rules);
+  FRuleSetPtr Set;
+  {
+    FScopeLock Guard(&Registry.Lock);
+    ++Registry.Stats.Acquired;
+    Set = InternLocked(Registry, Hash, MoveTemp(Rules));
+  }
+  RegisterOnce(Registry, Set, ApiUrl);
+  return Set;
+}
+
+FRuleSetPtr AcquirePreset(FRuleRegistry &Registry, FName Preset,
+                          TFunctionRef<FRuleSet()> Build,
+                          const FString &ApiUrl) {
+  FRuleSetPtr Set;
+  {
+    FScopeLock Guard(&Registry.Lock);
+    ++Registry.Stats.Acquired;
+    if (const FRuleSetPtr *Existing = Registry.Presets.Find(Preset)) {
+      Set = *Existing;
+    } else {
+      FRuleSet Rules = Build();
+      const uint64 Hash = HashRules(Rules);
+      Set = InternLocked(Registry, Hash, MoveTemp(Rules));
+      Registry.Presets.Add(Preset, Set);
+    }
+  }
+  RegisterOnce(Registry, Set, ApiUrl);
+  return Set;
+}
+
+FRuleRegistryStats GetStats(FRuleRegistry &Registry) {
+  FScopeLock Guard(&Registry.Lock);
+  return Registry.Stats;
+}
+
+void EndSession(FRuleRegistry &Registry) {
+  FScopeLock Guard(&Registry.Lock);
+  Registry.Registered.Reset();
+  Registry.NoBatchRoute.Reset();
+}
+
+void Reset(FRuleRegistry &Registry) {
+  FScopeLock Guard(&Registry.Lock);
+  Registry.Sets.Reset();
+  Registry.Presets.Reset();
+  Registry.Registered.Reset();
+  Registry.NoBatchRoute.Reset();
+  Registry.Stats = FRuleRegistryStats();
+}
+
+} // namespace RuleRegistryOps
+} // namespace Bridge
+} // namespace ForbocAI
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "BridgeModule.h"
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+namespace ForbocAI {
+namespace Bridge {
+
+// ── Rule Registry ──
+// One per process. Actors ask it for their validation rules instead of
+// building and registering a copy each. Rule sets are interned by content
+// (each rule's id, name and action types, in order; hashed, then compared
+// in full), so identical sets share one immutable TArray<FValidationRule>,
+// and each distinct set is registered with each API once, in a single
+// batched call, no matter how many actors use it. Validators can't be
+// compared (std::function has no equality and the build has no RTTI), so
+// rules alike in everything else are taken to validate alike, as the API,
+// which knows rules by id, does.
+//
+// Registrations last for the play session: the process-wide registry
+// forgets them when a game world is torn down, so the next session
+// registers again with whatever API it talks to.
+//
+// Wire format (JSON), POSTed to ApiUrl + BatchPath:
+//   request:  {"rules": [{"id", "name", "actionTypes": [...]}, ...]}
+//   response: any 2xx
+// The batch route isn't part of every API. If the batch fails, its rules
+// fall back to one BridgeOps::RegisterRule call each; if the API doesn't
+// have the route (404, 405 or 501), that is remembered and later sets go
+// straight to per-rule calls.
+
+using FRuleSet = TArray<FValidationRule>;
+using FRuleSetPtr = TSharedPtr<const FRuleSet, ESPMode::ThreadSafe>;
+
+// Registers Rules with the API at ApiUrl, then calls OnComplete (on any
+// thread) with whether that worked.
+using FRuleRegistrar =
+    TFunction<void(const FString &ApiUrl, FRuleSetPtr Rules,
+                   TFunction<void(bool bOk)> OnComplete)>;
+
+struct FRuleRegistryStats {
+  uint64 Acquired = 0;
+  // Distinct rule sets interned
+  int32 Sets = 0;
+  // Registrar calls, one per distinct set per API
+  uint64 Registrations = 0;
+  uint64 Failed = 0;
+};
+
+struct FRuleRegistry {
+  // Unset = RuleRegistryOps::RegisterBatch
+  FRuleRegistrar Registrar;
+
+  FCriticalSection Lock;
+  // By content hash; sets that only share a hash get an entry each
+  TMultiMap<uint64, FRuleSetPtr> Sets;
+  // Preset name -> its interned set, so each preset is built once
+  TMap<FName, FRuleSetPtr> Presets;
+  // (interned set, ApiUrl) pairs registered or on their way
+  TSet<TPair<const FRuleSet *, FString>> Registered;
+  // APIs found without the batch route
+  TSet<FString> NoBatchRoute;
+  FRuleRegistryStats Stats;
+};
+
+namespace RuleRegistryOps {
+
+// Path under ApiUrl of the batched registration endpoint.
+extern const TCHAR *const BatchPath;
+
+// The process-wide registry.
+FRuleRegistry &Get();
+
+uint64 HashRules(TArrayView<const FValidationRule> Rules);
+
+// Whether A and B match in everything HashRules covers.
+bool SameRules(TArrayView<const FValidationRule> A,
+               TArrayView<const FValidationRule> B);
+
+FString BuildRequestBody(TArrayView<const FValidationRule> Rules);
+
+// The default registrar: one POST of every rule to ApiUrl + BatchPath,
+// with the per-rule fallback, or straight to per-rule calls for an API
+// Registry knows lacks the route. OnComplete runs on the game thread, with
+// false unless the batch was taken.
+void RegisterBatch(FRuleRegistry &Registry, const FString &ApiUrl,
+                   FRuleSetPtr Rules, TFunction<void(bool bOk)> OnComplete);
+
+// The shared copy of Rules, registered with ApiUrl if it wasn't already.
+// Registry must outlive the registrations it starts.
+FRuleSetPtr Acquire(FRuleRegistry &Registry, FRuleSet Rules,
+                    const FString &ApiUrl);
+
+// Like Acquire, for a named preset; Build only runs the first time.
+FRuleSetPtr AcquirePreset(FRuleRegistry &Registry, FName Preset,
+                          TFunctionRef<FRuleSet()> Build,
+                          const FString &ApiUrl);
+
+FRuleRegistryStats GetStats(FRuleRegistry &Registry);
+
+// Forgets which sets each API has, and which APIs lack the batch route.
+// Interned sets stay. Called on the process-wide registry when a game world
+// is torn down.
+void EndSession(FRuleRegistry &Registry);
+
+// Forgets every set and registration (sets already handed out live on).
+void Reset(FRuleRegistry &Registry);
+
+} // namespace RuleRegistryOps
+
+} // namespace Bridge
+} // namespace ForbocAI
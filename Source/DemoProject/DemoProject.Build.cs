@@ -9,6 +9,14 @@ public class DemoProject : ModuleRules
 	
 		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "ForbocAI_SDK" });
 
-		PrivateDependencyModuleNames.AddRange(new string[] {  });
+		PrivateDependencyModuleNames.AddRange(new string[] { "HTTP", "Json" });
+
+		// The localhost stub server the specs talk to; never shipped
+		bool bWithStubServer = Target.bBuildDeveloperTools || Target.Configuration != UnrealTargetConfiguration.Shipping;
+		if (bWithStubServer)
+		{
+			PrivateDependencyModuleNames.Add("HTTPServer");
+		}
+		PrivateDefinitions.Add("WITH_FORBOCAI_STUB_SERVER=" + (bWithStubServer ? "1" : "0"));
 	}
 }
@@ -3,3 +3,23 @@
 #include "Modules/ModuleManager.h"
 
 IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, DemoProject, "DemoProject" );
+
+DEFINE_LOG_CATEGORY(LogForbocAI);
+
+DEFINE_STAT(STAT_ForbocAI_Tick);
+DEFINE_STAT(STAT_ForbocAI_Reduce);
+DEFINE_STAT(STAT_ForbocAI_Heartbeat);
+DEFINE_STAT(STAT_ForbocAI_Perception);
+DEFINE_STAT(STAT_ForbocAI_Observe);
+DEFINE_STAT(STAT_ForbocAI_Serialize);
+DEFINE_STAT(STAT_ForbocAI_Process);
+DEFINE_STAT(STAT_ForbocAI_Execute);
+
+DEFINE_STAT(STAT_ForbocAI_Bots);
+DEFINE_STAT(STAT_ForbocAI_AwakeBots);
+DEFINE_STAT(STAT_ForbocAI_InFlight);
+DEFINE_STAT(STAT_ForbocAI_Pending);
+DEFINE_STAT(STAT_ForbocAI_ActionsPerSecond);
+DEFINE_STAT(STAT_ForbocAI_Executed);
+
+UE_TRACE_CHANNEL_DEFINE(ForbocAIChannel);
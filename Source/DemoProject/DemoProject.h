@@ -1,4 +1,61 @@
-
 #pragma once
 
 #include "CoreMinimal.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Stats/Stats.h"
+
+// ── Logging ──
+// Per-bot and per-action messages go out at Verbose, which shipping builds
+// compile out entirely; enable them elsewhere with `log LogForbocAI Verbose`.
+#if UE_BUILD_SHIPPING
+DECLARE_LOG_CATEGORY_EXTERN(LogForbocAI, Log, Log);
+#else
+DECLARE_LOG_CATEGORY_EXTERN(LogForbocAI, Log, All);
+#endif
+
+// ── Stats ──
+// `stat ForbocAI` in the console. Cycle stats cover the bot pipeline stages;
+// the counters are set once per orchestrator tick.
+DECLARE_STATS_GROUP(TEXT("ForbocAI"), STATGROUP_ForbocAI, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Orchestrator Tick"), STAT_ForbocAI_Tick,
+                          STATGROUP_ForbocAI, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Reduce"), STAT_ForbocAI_Reduce,
+                          STATGROUP_ForbocAI, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Heartbeat"), STAT_ForbocAI_Heartbeat,
+                          STATGROUP_ForbocAI, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Perception"), STAT_ForbocAI_Perception,
+                          STATGROUP_ForbocAI, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Observe"), STAT_ForbocAI_Observe,
+                          STATGROUP_ForbocAI, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Serialize"), STAT_ForbocAI_Serialize,
+                          STATGROUP_ForbocAI, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Process"), STAT_ForbocAI_Process,
+                          STATGROUP_ForbocAI, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Execute"), STAT_ForbocAI_Execute,
+                          STATGROUP_ForbocAI, );
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Bots"), STAT_ForbocAI_Bots,
+                                  STATGROUP_ForbocAI, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Awake Bots"), STAT_ForbocAI_AwakeBots,
+                                  STATGROUP_ForbocAI, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Requests In Flight"),
+                                  STAT_ForbocAI_InFlight, STATGROUP_ForbocAI, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Requests Pending"),
+                                  STAT_ForbocAI_Pending, STATGROUP_ForbocAI, );
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(TEXT("Actions Reduced/s"),
+                                  STAT_ForbocAI_ActionsPerSecond,
+                                  STATGROUP_ForbocAI, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Actions Executed"),
+                                      STAT_ForbocAI_Executed,
+                                      STATGROUP_ForbocAI, );
+
+// ── Tracing ──
+// Unreal Insights scopes for the Multi-Round Protocol stages, on their own
+// channel so they can be recorded alone: `-trace=cpu,ForbocAI`.
+UE_TRACE_CHANNEL_EXTERN(ForbocAIChannel);
+
+// A cycle stat and an Insights scope of the same name, for one stage.
+#define FORBOCAI_SCOPE(Stat)                                                   \
+  SCOPE_CYCLE_COUNTER(Stat);                                                   \
+  TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Stat, ForbocAIChannel)
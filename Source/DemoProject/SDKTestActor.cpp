@@ -1,6 +1,8 @@
 
 #include "SDKTestActor.h"
+#include "DemoProject.h"
 #include "AgentModule.h"
+#include "Async/Async.h"
 #include "Bot/Factories/BotFactory.h" // Functional Core
 #include "BridgeModule.h"
 #include "MemoryModule.h"
@@ -12,6 +14,8 @@ ASDKTestActor::ASDKTestActor() {
 
   Persona = TEXT("Cyber-Merchant");
   ApiUrl = TEXT("https://api.forboc.ai");
+  SoulBlocks =
+      MakeShared<ForbocAI::Soul::FSoulBlockCache, ESPMode::ThreadSafe>();
 }
 
 void ASDKTestActor::BeginPlay() {
@@ -21,7 +25,8 @@ void ASDKTestActor::BeginPlay() {
   if (Persona.Len() > 0) {
     InitializeAgent();
 
-    UE_LOG(LogTemp, Display, TEXT("SDKTestActor: Auto-initialized agent %s"),
+    UE_LOG(LogForbocAI, Display,
+           TEXT("SDKTestActor: Auto-initialized agent %s"),
            *CurrentAgent->Id);
   }
 }
@@ -34,20 +39,25 @@ void ASDKTestActor::InitializeAgent() {
   // Create agent via factory function (Functional C++ pattern).
   // MakeShared wraps the immutable FAgent so we can rebind later.
   CurrentAgent = MakeShared<const FAgent>(AgentFactory::Create(Config));
-
-  // Manually register RPG rules (formerly default) via Preset
-  ActiveRules = BridgeOps::CreateRPGRules();
-
-  UE_LOG(LogTemp, Display, TEXT("ForbocAI: Created Agent with Persona '%s'"),
+  AgentState = {};
+  bAgentStateDirty = false;
+  bAgentStatePatched = false;
+
+  // RPG rules (formerly default) via Preset. Built, and registered with
+  // ApiUrl, by the first actor that asks; everyone after shares that copy.
+  ActiveRules = ForbocAI::Bridge::RuleRegistryOps::AcquirePreset(
+      ForbocAI::Bridge::RuleRegistryOps::Get(), TEXT("RPG"),
+      [] { return BridgeOps::CreateRPGRules(); }, ApiUrl);
+  ForbocAI::Bridge::RuleEvaluatorOps::Compile(RuleEvaluator, ActiveRules);
+  ValidationContext.Emplace(
+      BridgeFactory::CreateContext(&CurrentAgent->State, {}));
+
+  UE_LOG(LogForbocAI, Display,
+         TEXT("ForbocAI: Created Agent with Persona '%s'"),
          *Persona);
-  UE_LOG(LogTemp, Display,
+  UE_LOG(LogForbocAI, Display,
          TEXT("ForbocAI: Registered %d validation rules via RPG Preset"),
-         ActiveRules.Num());
-
-  // REGISTER RULES WITH API (New Feature)
-  for (const FValidationRule &Rule : ActiveRules) {
-    BridgeOps::RegisterRule(Rule, ApiUrl);
-  }
+         ActiveRules->Num());
 
   // Trigger Blueprint event
   OnAgentInitialized(CurrentAgent->Id);
@@ -60,10 +70,10 @@ void ASDKTestActor::InitializeAgent() {
   auto BotStore = ForbocAI::Bot::Factory::CreateBotStore(TEXT("TestBotOps"));
 
   // 2. Initial State Check
-  ForbocAI::State::FBotState InitState = BotStore.GetState();
-  UE_LOG(LogTemp, Display,
+  const ForbocAI::State::FBotState &InitState = BotStore.GetState();
+  UE_LOG(LogForbocAI, Display,
          TEXT("FunctionalCore: Created Bot '%s' (Health: %.0f)"),
-         *InitState.Name, InitState.Stats.Health);
+         *InitState.Name.ToString(), InitState.Stats.Health);
 
   // 3. Dispatch Action (Move)
   ForbocAI::State::FActionMove MoveAction;
@@ -73,8 +83,8 @@ void ASDKTestActor::InitializeAgent() {
   BotStore.Dispatch(MoveAction);
 
   // 4. Verify State Mutation
-  ForbocAI::State::FBotState AfterMove = BotStore.GetState();
-  UE_LOG(LogTemp, Display, TEXT("FunctionalCore: Post-Move Position: %s"),
+  const ForbocAI::State::FBotState &AfterMove = BotStore.GetState();
+  UE_LOG(LogForbocAI, Display, TEXT("FunctionalCore: Post-Move Position: %s"),
          *AfterMove.Position.ToString());
 
   // 5. Dispatch Action (Damage) -> Trigger Phase Change
@@ -83,92 +93,222 @@ void ASDKTestActor::InitializeAgent() {
 
   BotStore.Dispatch(DamageAction);
 
-  ForbocAI::State::FBotState AfterDamage = BotStore.GetState();
+  const ForbocAI::State::FBotState &AfterDamage = BotStore.GetState();
   UE_LOG(
-      LogTemp, Display,
+      LogForbocAI, Display,
       TEXT("FunctionalCore: Post-Damage HP: %.0f, Phase: %d (Expected Flee=3)"),
       AfterDamage.Stats.Health, (int32)AfterDamage.Phase);
 }
 
 void ASDKTestActor::ProcessInput(const FString &InputText) {
   if (!CurrentAgent.IsValid()) {
-    UE_LOG(LogTemp, Warning,
+    UE_LOG(LogForbocAI, Warning,
            TEXT("ForbocAI: Cannot process input, agent not initialized."));
     return;
   }
+  SyncAgentState();
 
-  // Process input via async pipeline.
+  // Process input via async pipeline. The response arrives off the game
+  // thread; it's validated back on it, where the evaluator and context live.
+  TWeakObjectPtr<ASDKTestActor> WeakThis(this);
   AgentOps::Process(
-      *CurrentAgent, InputText, {}, [this](FAgentResponse Response) {
-        // ==========================================
-        // BRIDGE: Validate the Agent's Action
-        // ==========================================
-        // We use the "ActiveRules" we manually registered.
-        // Context would typically include World State.
-        const FBridgeValidationContext ValContext =
-            BridgeFactory::CreateContext(&CurrentAgent->State, {});
-
-        const FValidationResult ValResult =
-            BridgeOps::Validate(Response.Action, ActiveRules, ValContext);
-
-        if (ValResult.bValid) {
-          UE_LOG(LogTemp, Display, TEXT("Bridge: Action VALID (%s)"),
-                 *ValResult.Reason);
-        } else {
-          UE_LOG(LogTemp, Warning, TEXT("Bridge: Action BLOCKED (%s)"),
-                 *ValResult.Reason);
-          // In a real game, we might override the response or prevent execution
-          // here.
-        }
+      *CurrentAgent, InputText, {}, [WeakThis](FAgentResponse Response) {
+        AsyncTask(ENamedThreads::GameThread,
+                  [WeakThis, Response = MoveTemp(Response)]() {
+                    if (ASDKTestActor *Self = WeakThis.Get()) {
+                      Self->HandleAgentResponse(Response);
+                    }
+                  });
+      });
+}
 
-        UE_LOG(LogTemp, Display, TEXT("ForbocAI Response: %s"),
-               *Response.Dialogue);
+void ASDKTestActor::HandleAgentResponse(const FAgentResponse &Response) {
+  if (!ValidationContext.IsSet())
+    return;
 
-        // Trigger Blueprint event
-        OnAgentResponse(Response.Dialogue);
-      });
+  // ==========================================
+  // BRIDGE: Validate the Agent's Action
+  // ==========================================
+  // We use the "ActiveRules" we registered, compiled so only the rules for
+  // this action type run. Context would typically include World State.
+  const FValidationResult ValResult =
+      ForbocAI::Bridge::RuleEvaluatorOps::Validate(
+          RuleEvaluator, Response.Action, *ValidationContext);
+
+  if (ValResult.bValid) {
+    UE_LOG(LogForbocAI, Display, TEXT("Bridge: Action VALID (%s)"),
+           *ValResult.Reason);
+  } else {
+    UE_LOG(LogForbocAI, Warning, TEXT("Bridge: Action BLOCKED (%s)"),
+           *ValResult.Reason);
+    // In a real game, we might override the response or prevent execution
+    // here.
+  }
+
+  UE_LOG(LogForbocAI, Display, TEXT("ForbocAI Response: %s"),
+         *Response.Dialogue);
+
+  // Trigger Blueprint event
+  OnAgentResponse(Response.Dialogue);
 }
 
 void ASDKTestActor::UpdateAgentState(const FString &NewStateDescription) {
   if (!CurrentAgent.IsValid())
     return;
 
-  // Functional update — returns a NEW agent. The old agent
-  // data remains untouched; we rebind the shared pointer.
+  // A typed patch, not hand-built JSON: the description is escaped when
+  // the state is next written out
+  ForbocAI::State::FAgentStatePatch Patch;
+  ForbocAI::State::AgentStateOps::Set(Patch, {TEXT("description")},
+                                      NewStateDescription);
+  PatchAgentState(Patch);
+
+  UE_LOG(LogForbocAI, Display, TEXT("ForbocAI: Updated Agent State to '%s'"),
+         *NewStateDescription);
+}
+
+void ASDKTestActor::SetAgentStateString(FName Key, const FString &Value) {
+  ForbocAI::State::FAgentStatePatch Patch;
+  ForbocAI::State::AgentStateOps::Set(Patch, {Key}, Value);
+  PatchAgentState(Patch);
+}
+
+void ASDKTestActor::SetAgentStateNumber(FName Key, float Value) {
+  ForbocAI::State::FAgentStatePatch Patch;
+  ForbocAI::State::AgentStateOps::Set(Patch, {Key}, (double)Value);
+  PatchAgentState(Patch);
+}
+
+void ASDKTestActor::SetAgentStateBool(FName Key, bool Value) {
+  ForbocAI::State::FAgentStatePatch Patch;
+  ForbocAI::State::AgentStateOps::Set(Patch, {Key}, Value);
+  PatchAgentState(Patch);
+}
 
-  // Wrap the description in a simple JSON structure for the generic state
-  const FString JsonState =
-      FString::Printf(TEXT("{\"description\": \"%s\"}"), *NewStateDescription);
+void ASDKTestActor::RemoveAgentStateKey(FName Key) {
+  ForbocAI::State::FAgentStatePatch Patch;
+  ForbocAI::State::AgentStateOps::Remove(Patch, {Key});
+  PatchAgentState(Patch);
+}
 
-  const FAgentState NewState = TypeFactory::AgentState(JsonState);
+void ASDKTestActor::PatchAgentState(
+    const ForbocAI::State::FAgentStatePatch &Patch) {
+  if (!CurrentAgent.IsValid())
+    return;
+
+  // Functional update — a NEW state tree sharing everything the patch
+  // didn't touch. The agent itself is rebound when next read.
+  AgentState = ForbocAI::State::AgentStateOps::Apply(AgentState, Patch);
+  bAgentStateDirty = true;
+  bAgentStatePatched = true;
+}
+
+void ASDKTestActor::SyncAgentState() {
+  if (!bAgentStateDirty || !CurrentAgent.IsValid())
+    return;
+
+  // The SDK takes state as JSON, so it's written (escaped) once here for
+  // every patch since the last sync. The old agent data remains untouched;
+  // we rebind the shared pointer.
+  const FAgentState NewState = TypeFactory::AgentState(
+      ForbocAI::State::AgentStateOps::ToJson(AgentState));
   CurrentAgent =
       MakeShared<const FAgent>(AgentOps::WithState(*CurrentAgent, NewState));
-
-  UE_LOG(LogTemp, Display, TEXT("ForbocAI: Updated Agent State to '%s'"),
-         *JsonState);
+  ValidationContext.Emplace(
+      BridgeFactory::CreateContext(&CurrentAgent->State, {}));
+  bAgentStateDirty = false;
 }
 
 void ASDKTestActor::ExportSoul() {
   if (!CurrentAgent.IsValid()) {
-    UE_LOG(LogTemp, Warning,
+    UE_LOG(LogForbocAI, Warning,
            TEXT("ForbocAI: Cannot export Soul, agent not initialized."));
     return;
   }
+  if (bSoulExportInFlight) {
+    UE_LOG(LogForbocAI, Warning,
+           TEXT("ForbocAI: Soul export already in progress."));
+    return;
+  }
+
+  // Streaming writes the Soul from AgentState, which is empty until the
+  // first patch; before that the agent's initial state is only the SDK's,
+  // so it goes through the SDK's export for both to write the same Soul.
+  if (!bStreamSoulExport || !bAgentStatePatched) {
+    SyncAgentState();
+
+    // Create Soul from current Agent State
+    // Note: We pass empty memories for demo simplicity, or fetch from
+    // MemoryModule if implemented.
+    FSoul Soul = SoulOps::FromAgent(CurrentAgent->State, {},
+                                    CurrentAgent->Id, CurrentAgent->Persona);
+
+    UE_LOG(LogForbocAI, Display,
+           TEXT("ForbocAI: Exporting Soul to Arweave..."));
+
+    // Call SDK Ops
+    TWeakObjectPtr<ASDKTestActor> WeakThis(this);
+    SoulOps::ExportToArweave(Soul, ApiUrl, [WeakThis](FString TxId) {
+      // Getting back on Game Thread usually handled by HTTP module
+      // callbacks.
+      UE_LOG(LogForbocAI, Display, TEXT("ForbocAI: Soul Exported! TxId: %s"),
+             *TxId);
+      if (ASDKTestActor *Self = WeakThis.Get()) {
+        Self->OnSoulExported(TxId);
+      }
+    });
+    return;
+  }
+
+  // Snapshot the state tree (memories are its "memories" map); the tree is
+  // persistent, so this copies a pointer and later patches don't touch it.
+  // The Soul is written, compressed and uploaded block by block from here.
+  ForbocAI::Soul::FSoulSnapshot Snapshot;
+  Snapshot.AgentId = CurrentAgent->Id;
+  Snapshot.Persona = CurrentAgent->Persona;
+  Snapshot.State = AgentState;
+
+  UE_LOG(LogForbocAI, Display, TEXT("ForbocAI: Streaming Soul export..."));
+
+  TWeakObjectPtr<ASDKTestActor> WeakThis(this);
+  bSoulExportInFlight = true;
+  SoulExport = ForbocAI::Soul::SoulExportOps::Start(
+      ApiUrl + TEXT("/souls/stream"), MoveTemp(Snapshot), SoulBlocks, {},
+      [WeakThis](const ForbocAI::Soul::FSoulExportProgress &Progress) {
+        if (ASDKTestActor *Self = WeakThis.Get()) {
+          Self->OnSoulExportProgress(Progress.BytesSent, Progress.BytesTotal);
+        }
+      },
+      [WeakThis](bool bOk, const FString &TxId) {
+        if (ASDKTestActor *Self = WeakThis.Get()) {
+          Self->HandleSoulExported(bOk, TxId);
+        }
+      });
+}
+
+void ASDKTestActor::ResumeSoulExport() {
+  if (bSoulExportInFlight ||
+      !ForbocAI::Soul::SoulExportOps::Resume(SoulExport)) {
+    UE_LOG(LogForbocAI, Warning,
+           TEXT("ForbocAI: No stopped Soul export to resume."));
+    return;
+  }
+  bSoulExportInFlight = true;
+}
+
+void ASDKTestActor::HandleSoulExported(bool bOk, const FString &TxId) {
+  bSoulExportInFlight = false;
+  if (!bOk) {
+    UE_LOG(LogForbocAI, Warning, TEXT("ForbocAI: Soul export failed."));
+    OnSoulExportFailed();
+    return;
+  }
 
-  // Create Soul from current Agent State
-  // Note: We pass empty memories for demo simplicity, or fetch from
-  // MemoryModule if implemented.
-  FSoul Soul = SoulOps::FromAgent(CurrentAgent->State, {}, CurrentAgent->Id,
-                                  CurrentAgent->Persona);
-
-  UE_LOG(LogTemp, Display, TEXT("ForbocAI: Exporting Soul to Arweave..."));
-
-  // Call SDK Ops
-  SoulOps::ExportToArweave(Soul, ApiUrl, [this](FString TxId) {
-    // Logic inside callback (on game thread via Lambda, ensure thread safety if
-    // needed) Getting back on Game Thread usually handled by HTTP module
-    // callbacks.
-    UE_LOG(LogTemp, Display, TEXT("ForbocAI: Soul Exported! TxId: %s"), *TxId);
-    OnSoulExported(TxId);
-  });
+  const ForbocAI::Soul::FSoulExportProgress &Progress = SoulExport->Progress;
+  UE_LOG(LogForbocAI, Display,
+         TEXT("ForbocAI: Soul Exported! TxId: %s (%d of %d blocks sent, "
+              "%lld bytes compressed, of %lld)"),
+         *TxId, Progress.Blocks - Progress.BlocksSkipped, Progress.Blocks,
+         Progress.BytesTotal, Progress.RawBytes);
+  OnSoulExported(TxId);
 }
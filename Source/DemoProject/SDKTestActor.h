@@ -2,9 +2,13 @@
 #pragma once
 
 #include "AgentModule.h"  // ForbocAI SDK
+#include "Bridge/RuleEvaluator.h"
+#include "Bridge/RuleRegistry.h"
 #include "BridgeModule.h" // Validation Rules
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "Soul/SoulExport.h"
+#include "State/AgentStateTree.h"
 #include "SDKTestActor.generated.h"
 
 /**
@@ -43,6 +47,14 @@ public:
   UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ForbocAI")
   FString ApiUrl;
 
+  /**
+   * Export the Soul as streamed, deduplicated blocks to ApiUrl's
+   * /souls/stream route instead of through the SDK's Arweave export. The
+   * endpoint must implement the protocol in Soul/SoulExport.h.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ForbocAI")
+  bool bStreamSoulExport = false;
+
   // --- State ---
 
   /**
@@ -54,10 +66,46 @@ public:
 
   /**
    * Active Validation Rules.
-   * Registered via BridgeOps presets.
+   * A BridgeOps preset, shared with every other actor using it through the
+   * process-wide rule registry, which registers it with the API once.
    * Not a UPROPERTY because FValidationRule contains std::function.
    */
-  TArray<FValidationRule> ActiveRules;
+  ForbocAI::Bridge::FRuleSetPtr ActiveRules;
+
+  /**
+   * ActiveRules compiled for the response path. Validating updates its
+   * stats and rule order, so it is only used on the game thread.
+   */
+  ForbocAI::Bridge::FRuleEvaluator RuleEvaluator;
+
+  /**
+   * Validation context for CurrentAgent, rebuilt only when the agent is
+   * rebound. Optional because the context has no default state. Game
+   * thread only, like RuleEvaluator.
+   */
+  TOptional<FBridgeValidationContext> ValidationContext;
+
+  /**
+   * The agent's state, as a persistent tree that updates share structure
+   * with. CurrentAgent is only rebound to it (one AgentOps::WithState) when
+   * something reads the agent, however many patches came in between.
+   */
+  ForbocAI::State::FAgentStateObject AgentState;
+  bool bAgentStateDirty = false;
+
+  /**
+   * Whether AgentState is the agent's whole state. Not until the first
+   * patch: the SDK's FAgentState can't be read back into a tree, so until
+   * then only the SDK's own Soul export sees the agent's initial state.
+   */
+  bool bAgentStatePatched = false;
+
+  /** Soul blocks the export endpoint holds, skipped by later exports. */
+  ForbocAI::Soul::FSoulBlockCachePtr SoulBlocks;
+
+  /** The latest Soul export, kept so a stopped one can be resumed. */
+  ForbocAI::Soul::FSoulExportPtr SoulExport;
+  bool bSoulExportInFlight = false;
 
   // --- Blueprint Callable Functions ---
 
@@ -70,9 +118,38 @@ public:
   UFUNCTION(BlueprintCallable, Category = "ForbocAI")
   void UpdateAgentState(const FString &NewStateDescription);
 
+  /** Set one top-level key of the agent's state. */
+  UFUNCTION(BlueprintCallable, Category = "ForbocAI")
+  void SetAgentStateString(FName Key, const FString &Value);
+
+  UFUNCTION(BlueprintCallable, Category = "ForbocAI")
+  void SetAgentStateNumber(FName Key, float Value);
+
+  UFUNCTION(BlueprintCallable, Category = "ForbocAI")
+  void SetAgentStateBool(FName Key, bool Value);
+
+  UFUNCTION(BlueprintCallable, Category = "ForbocAI")
+  void RemoveAgentStateKey(FName Key);
+
+  /** Apply typed changes (nested paths included) to the agent's state. */
+  void PatchAgentState(const ForbocAI::State::FAgentStatePatch &Patch);
+
+  /**
+   * Export the agent's Soul (state and memories) to ApiUrl through the SDK.
+   * With bStreamSoulExport, streamed in blocks off the game thread instead;
+   * unchanged memory blocks aren't sent again. An agent whose state was
+   * never patched always goes through the SDK.
+   */
   UFUNCTION(BlueprintCallable, Category = "ForbocAI")
   void ExportSoul();
 
+  /**
+   * Continue a streamed export that stopped, from where the endpoint left
+   * off.
+   */
+  UFUNCTION(BlueprintCallable, Category = "ForbocAI")
+  void ResumeSoulExport();
+
   // --- Events (implement in Blueprint) ---
 
   UFUNCTION(BlueprintImplementableEvent, Category = "ForbocAI")
@@ -83,4 +160,20 @@ public:
 
   UFUNCTION(BlueprintImplementableEvent, Category = "ForbocAI")
   void OnSoulExported(const FString &TxId);
+
+  /** Compressed bytes of the Soul uploaded so far, out of BytesTotal. */
+  UFUNCTION(BlueprintImplementableEvent, Category = "ForbocAI")
+  void OnSoulExportProgress(int64 BytesSent, int64 BytesTotal);
+
+  UFUNCTION(BlueprintImplementableEvent, Category = "ForbocAI")
+  void OnSoulExportFailed();
+
+private:
+  /** Rebind CurrentAgent to AgentState if patches came in since. */
+  void SyncAgentState();
+
+  /** Validate and report a response, back on the game thread. */
+  void HandleAgentResponse(const FAgentResponse &Response);
+
+  void HandleSoulExported(bool bOk, const FString &TxId);
 };
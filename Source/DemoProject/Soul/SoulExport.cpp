@@ -0,0 +1,472 @@
+#include "SoulExport.h"
+#include "Algo/Sort.h"
+#include "Async/Async.h"
+#include "DemoProject.h"
+#include "Dom/JsonObject.h"
+#include "Hash/CityHash.h"
+#include "HttpModule.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Misc/Base64.h"
+#include "Misc/Compression.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace ForbocAI {
+namespace Soul {
+namespace SoulExportOps {
+
+namespace {
+
+namespace StateOps = State::AgentStateOps;
+
+using FMemoryRef = FSoulBlockPlan::FMemoryRef;
+using FReplyHandler =
+    TFunction<void(const FSoulExportPtr &Export, const FJsonObject *Reply)>;
+
+TSharedRef<StateOps::FAgentStateJsonWriter> MakeWriter(FString &Json) {
+  return TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(
+      &Json);
+}
+
+// Hashes Json and, unless Known holds it, compresses it into Block.
+bool MakeBlock(const FString &Json, const TSet<uint64> &Known,
+               FSoulBlock &Block) {
+  const FTCHARToUTF8 Utf8(*Json, Json.Len());
+  Block = FSoulBlock();
+  Block.RawSize = Utf8.Length();
+  Block.Hash = CityHash64(Utf8.Get(), Utf8.Length());
+  Block.bKnown = Known.Contains(Block.Hash);
+  if (Block.bKnown) {
+    return true;
+  }
+
+  int32 Size = FCompression::CompressMemoryBound(NAME_Zlib, Block.RawSize);
+  Block.Data.SetNumUninitialized(Size);
+  if (!FCompression::CompressMemory(NAME_Zlib, Block.Data.GetData(), Size,
+                                    Utf8.Get(), Block.RawSize)) {
+    return false;
+  }
+  Block.Data.SetNum(Size);
+  return true;
+}
+
+// Hands a copy of Export's progress to OnProgress on the game thread.
+void ReportProgress(const FSoulExportPtr &Export) {
+  if (!Export->OnProgress) {
+    return;
+  }
+  AsyncTask(ENamedThreads::GameThread,
+            [Export, Progress = Export->Progress]() {
+              Export->OnProgress(Progress);
+            });
+}
+
+void Finish(const FSoulExportPtr &Export, bool bOk, const FString &TxId) {
+  AsyncTask(ENamedThreads::GameThread, [Export, bOk, TxId]() {
+    if (bOk && Export->Cache.IsValid()) {
+      for (const FSoulBlock &Block : Export->Blocks) {
+        Export->Cache->Uploaded.Add(Block.Hash);
+      }
+    }
+    if (Export->OnComplete) {
+      Export->OnComplete(bOk, TxId);
+    }
+  });
+}
+
+// POSTs Body to Export's endpoint. OnReply gets the parsed response, or
+// null if the request failed, on the HTTP thread.
+void Post(const FSoulExportPtr &Export, const FString &Body,
+          FReplyHandler OnReply) {
+  TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request =
+      FHttpModule::Get().CreateRequest();
+  Request->SetURL(Export->Url);
+  Request->SetVerb(TEXT("POST"));
+  Request->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+  Request->SetContentAsString(Body);
+
+  Request->SetDelegateThreadPolicy(
+      EHttpRequestDelegateThreadPolicy::CompleteOnHttpThread);
+  Request->OnProcessRequestComplete().BindLambda(
+      [Export, OnReply = MoveTemp(OnReply)](FHttpRequestPtr,
+                                            FHttpResponsePtr Response,
+                                            bool bConnected) {
+        TSharedPtr<FJsonObject> Reply;
+        if (!bConnected || !Response.IsValid() ||
+            !EHttpResponseCodes::IsOk(Response->GetResponseCode()) ||
+            !FJsonSerializer::Deserialize(
+                TJsonReaderFactory<>::Create(Response->GetContentAsString()),
+                Reply)) {
+          Reply.Reset();
+        }
+        OnReply(Export, Reply.Get());
+      });
+
+  Request->ProcessRequest();
+}
+
+// Stops the export until Resume, reporting failure.
+void Stop(const FSoulExportPtr &Export) {
+  UE_LOG(LogForbocAI, Warning,
+         TEXT("SoulExport: %s stopped at block %d of %d, offset %d"),
+         *Export->ExportId, Export->NextBlock, NumBlocks(Export->Plan),
+         Export->NextOffset);
+  Export->bStopped = true;
+  Finish(Export, false, FString());
+}
+
+// Counts a failed try of the current request. Returns false, having
+// stopped the export, once it's out of attempts.
+bool Retry(const FSoulExportPtr &Export) {
+  if (++Export->Attempts < FMath::Max(1, Export->Config.MaxAttempts)) {
+    return true;
+  }
+  Stop(Export);
+  return false;
+}
+
+// Marks the blocks named in Missing for writing and uploading again, and
+// rewinds the upload to the first. Returns how many of Export's blocks
+// were named.
+int32 MarkMissing(const FSoulExportPtr &Export,
+                  const TArray<TSharedPtr<FJsonValue>> &Missing) {
+  TSet<FString> Names;
+  for (const TSharedPtr<FJsonValue> &Name : Missing) {
+    Names.Add(Name->AsString());
+  }
+
+  TArray<uint64> Evicted;
+  for (int32 Index = Export->Blocks.Num() - 1; Index >= 0; --Index) {
+    FSoulBlock &Block = Export->Blocks[Index];
+    if (!Names.Contains(BlockName(Block.Hash))) {
+      continue;
+    }
+    Block.bKnown = false;
+    Block.Data.Empty();
+    Export->Known.Remove(Block.Hash);
+    Evicted.Add(Block.Hash);
+    Export->NextBlock = Index;
+    Export->NextOffset = 0;
+  }
+
+  if (!Evicted.IsEmpty() && Export->Cache.IsValid()) {
+    AsyncTask(ENamedThreads::GameThread,
+              [Cache = Export->Cache, Evicted]() {
+                for (const uint64 Hash : Evicted) {
+                  Cache->Uploaded.Remove(Hash);
+                }
+              });
+  }
+  return Evicted.Num();
+}
+
+void SendNext(const FSoulExportPtr &Export);
+
+void Commit(const FSoulExportPtr &Export) {
+  Post(Export, BuildCommitBody(*Export),
+       [](const FSoulExportPtr &Export, const FJsonObject *Reply) {
+         FString TxId;
+         const TArray<TSharedPtr<FJsonValue>> *Missing = nullptr;
+         if (Reply && Reply->TryGetStringField(TEXT("txId"), TxId) &&
+             !TxId.IsEmpty()) {
+           Finish(Export, true, TxId);
+         } else if (Reply &&
+                    Reply->TryGetArrayField(TEXT("missing"), Missing) &&
+                    MarkMissing(Export, *Missing) > 0) {
+           // The endpoint dropped blocks it held; send them again
+           const int32 MaxAttempts = FMath::Max(1, Export->Config.MaxAttempts);
+           if (++Export->Recoveries <= MaxAttempts) {
+             SendNext(Export);
+           } else {
+             Stop(Export);
+           }
+         } else if (Retry(Export)) {
+           Commit(Export);
+         }
+       });
+}
+
+// Whether a spec asked for the next block write to fail.
+bool ForceWriteFailure(const FSoulExportPtr &Export) {
+#if WITH_FORBOCAI_STUB_SERVER
+  FSoulExportConfig &Config = Export->Config;
+  if (Config.WriteFailures > 0 &&
+      Export->NextBlock >= Config.WriteFailuresAfter) {
+    --Config.WriteFailures;
+    return true;
+  }
+#endif
+  return false;
+}
+
+// Writes the block at the upload position on a pool thread, then carries on
+// uploading. A block that fails to write stops the export there.
+void WriteNext(const FSoulExportPtr &Export) {
+  Async(EAsyncExecution::ThreadPool, [Export]() {
+    FSoulBlock Block;
+    if (ForceWriteFailure(Export) ||
+        !WriteBlock(Export->Plan, Export->NextBlock, Export->Known, Block)) {
+      UE_LOG(LogForbocAI, Warning, TEXT("SoulExport: %s failed to compress"),
+             *Export->ExportId);
+      Stop(Export);
+      return;
+    }
+
+    FSoulExportProgress &Progress = Export->Progress;
+    Progress.BytesTotal += Block.Data.Num();
+    if (Export->NextBlock == Export->Blocks.Num()) {
+      Progress.RawBytes += Block.RawSize;
+      Progress.BlocksSkipped += Block.bKnown ? 1 : 0;
+      Export->Blocks.Add(MoveTemp(Block));
+    } else {
+      Export->Blocks[Export->NextBlock] = MoveTemp(Block);
+    }
+    SendNext(Export);
+  });
+}
+
+// Uploads the next chunk still missing, writing its block first if it
+// hasn't been, then commits once none are. Blocks are let go of as they
+// finish uploading.
+void SendNext(const FSoulExportPtr &Export) {
+  while (Export->NextBlock < NumBlocks(Export->Plan)) {
+    if (Export->NextBlock == Export->Blocks.Num()) {
+      WriteNext(Export);
+      return;
+    }
+    FSoulBlock &Block = Export->Blocks[Export->NextBlock];
+    if (!Block.bKnown) {
+      if (Block.Data.IsEmpty()) {
+        // Dropped by the endpoint after being let go of here
+        WriteNext(Export);
+        return;
+      }
+      if (Export->NextOffset < Block.Data.Num()) {
+        break;
+      }
+    }
+    Block.Data.Empty();
+    Block.bKnown = true;
+    ++Export->NextBlock;
+    Export->NextOffset = 0;
+  }
+  if (Export->NextBlock == NumBlocks(Export->Plan)) {
+    Commit(Export);
+    return;
+  }
+
+  Post(Export, BuildChunkBody(*Export),
+       [](const FSoulExportPtr &Export, const FJsonObject *Reply) {
+         // The endpoint says how much of the block it holds; carry on from
+         // there. Anything short of progress counts as a failed try.
+         const int32 Size = Export->Blocks[Export->NextBlock].Data.Num();
+         int64 Received = 0;
+         if (Reply && Reply->TryGetNumberField(TEXT("received"), Received) &&
+             Received > Export->NextOffset) {
+           const int32 Offset = (int32)FMath::Min<int64>(Received, Size);
+           Export->Progress.BytesSent += Offset - Export->NextOffset;
+           Export->NextOffset = Offset;
+           Export->Attempts = 0;
+           ReportProgress(Export);
+         } else if (!Retry(Export)) {
+           return;
+         }
+         SendNext(Export);
+       });
+}
+
+} // namespace
+
+void PlanBlocks(FSoulSnapshot Snapshot, const FSoulExportConfig &Config,
+                FSoulBlockPlan &OutPlan) {
+  static const FName MemoriesKey(TEXT("memories"));
+  OutPlan.Snapshot = MoveTemp(Snapshot);
+  OutPlan.MemoryBlocks.Reset();
+
+  const State::FAgentStateObject *Memories =
+      StateOps::FindObject(OutPlan.Snapshot.State, {MemoriesKey});
+  if (!Memories || Memories->Num == 0) {
+    return;
+  }
+
+  // A memory's block only depends on its key's hash and the block count,
+  // and memories are written in key order, so an unchanged block writes
+  // the same bytes whatever else changed.
+  const int32 NumBuckets = (int32)FMath::RoundUpToPowerOfTwo(
+      (uint32)FMath::DivideAndRoundUp(Memories->Num,
+                                      FMath::Max(1, Config.MemoriesPerBlock)));
+  TArray<TArray<FMemoryRef>> Buckets;
+  Buckets.SetNum(NumBuckets);
+  StateOps::ForEach(
+      *Memories,
+      [&Buckets, NumBuckets](FName Key, const State::FAgentStateValue &Value) {
+        // The string's hash, which unlike the FName's is the same every run
+        const uint32 Hash = GetTypeHash(Key.ToString());
+        Buckets[Hash & (NumBuckets - 1)].Emplace(Key, &Value);
+      });
+
+  for (TArray<FMemoryRef> &Bucket : Buckets) {
+    if (Bucket.IsEmpty()) {
+      continue;
+    }
+    Algo::Sort(Bucket, [](const FMemoryRef &A, const FMemoryRef &B) {
+      return A.Key.LexicalLess(B.Key);
+    });
+    OutPlan.MemoryBlocks.Add(MoveTemp(Bucket));
+  }
+}
+
+bool WriteBlock(const FSoulBlockPlan &Plan, int32 Index,
+                const TSet<uint64> &Known, FSoulBlock &OutBlock) {
+  FORBOCAI_SCOPE(STAT_ForbocAI_Serialize);
+  static const FName MemoriesKey(TEXT("memories"));
+  check(Index >= 0 && Index < NumBlocks(Plan));
+
+  FString Json;
+  TSharedRef<StateOps::FAgentStateJsonWriter> Writer = MakeWriter(Json);
+  Writer->WriteObjectStart();
+  if (Index == 0) {
+    const FSoulSnapshot &Snapshot = Plan.Snapshot;
+    const FString StateKey = TEXT("state");
+    Writer->WriteValue(TEXT("agentId"), Snapshot.AgentId);
+    Writer->WriteValue(TEXT("persona"), Snapshot.Persona);
+    StateOps::WriteJson(*Writer,
+                        StateOps::Without(Snapshot.State, MemoriesKey),
+                        &StateKey);
+  } else {
+    Writer->WriteObjectStart(TEXT("memories"));
+    for (const FMemoryRef &Memory : Plan.MemoryBlocks[Index - 1]) {
+      StateOps::WriteValue(*Writer, Memory.Key.ToString(), *Memory.Value);
+    }
+    Writer->WriteObjectEnd();
+  }
+  Writer->WriteObjectEnd();
+  Writer->Close();
+  return MakeBlock(Json, Known, OutBlock);
+}
+
+bool WriteBlocks(const FSoulSnapshot &Snapshot, const TSet<uint64> &Known,
+                 const FSoulExportConfig &Config,
+                 TArray<FSoulBlock> &OutBlocks) {
+  FSoulBlockPlan Plan;
+  PlanBlocks(Snapshot, Config, Plan);
+  OutBlocks.SetNum(NumBlocks(Plan));
+  for (int32 Index = 0; Index < OutBlocks.Num(); ++Index) {
+    if (!WriteBlock(Plan, Index, Known, OutBlocks[Index])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ReadBlock(const FSoulBlock &Block, FString &OutJson) {
+  if (Block.bKnown) {
+    return false;
+  }
+  TArray<uint8> Raw;
+  Raw.SetNumUninitialized(Block.RawSize);
+  if (!FCompression::UncompressMemory(NAME_Zlib, Raw.GetData(), Raw.Num(),
+                                      Block.Data.GetData(),
+                                      Block.Data.Num())) {
+    return false;
+  }
+  const FUTF8ToTCHAR Text(reinterpret_cast<const ANSICHAR *>(Raw.GetData()),
+                          Raw.Num());
+  OutJson = FString(Text.Length(), Text.Get());
+  return true;
+}
+
+FString BlockName(uint64 Hash) {
+  return FString::Printf(TEXT("%016llx"), Hash);
+}
+
+FString BuildChunkBody(const FSoulExport &Export) {
+  const FSoulBlock &Block = Export.Blocks[Export.NextBlock];
+  const int32 Size =
+      FMath::Min(FMath::Max(1, Export.Config.ChunkBytes),
+                 Block.Data.Num() - Export.NextOffset);
+
+  FString Body;
+  TSharedRef<StateOps::FAgentStateJsonWriter> Writer = MakeWriter(Body);
+  Writer->WriteObjectStart();
+  Writer->WriteValue(TEXT("op"), TEXT("chunk"));
+  Writer->WriteValue(TEXT("exportId"), Export.ExportId);
+  Writer->WriteValue(TEXT("block"), BlockName(Block.Hash));
+  Writer->WriteValue(TEXT("rawSize"), Block.RawSize);
+  Writer->WriteValue(TEXT("size"), Block.Data.Num());
+  Writer->WriteValue(TEXT("offset"), Export.NextOffset);
+  Writer->WriteValue(
+      TEXT("data"),
+      FBase64::Encode(Block.Data.GetData() + Export.NextOffset, Size));
+  Writer->WriteObjectEnd();
+  Writer->Close();
+  return Body;
+}
+
+FString BuildCommitBody(const FSoulExport &Export) {
+  FString Body;
+  TSharedRef<StateOps::FAgentStateJsonWriter> Writer = MakeWriter(Body);
+  Writer->WriteObjectStart();
+  Writer->WriteValue(TEXT("op"), TEXT("commit"));
+  Writer->WriteValue(TEXT("exportId"), Export.ExportId);
+  Writer->WriteValue(TEXT("agentId"), Export.AgentId);
+  Writer->WriteValue(TEXT("persona"), Export.Persona);
+  Writer->WriteValue(TEXT("compression"), TEXT("zlib"));
+  Writer->WriteArrayStart(TEXT("blocks"));
+  for (const FSoulBlock &Block : Export.Blocks) {
+    Writer->WriteObjectStart();
+    Writer->WriteValue(TEXT("block"), BlockName(Block.Hash));
+    Writer->WriteValue(TEXT("rawSize"), Block.RawSize);
+    Writer->WriteObjectEnd();
+  }
+  Writer->WriteArrayEnd();
+  Writer->WriteObjectEnd();
+  Writer->Close();
+  return Body;
+}
+
+FSoulExportPtr Start(const FString &Url, FSoulSnapshot Snapshot,
+                     FSoulBlockCachePtr Cache, const FSoulExportConfig &Config,
+                     FSoulExportProgressCallback OnProgress,
+                     FSoulExportCallback OnComplete) {
+  FSoulExportPtr Export = MakeShared<FSoulExport, ESPMode::ThreadSafe>();
+  Export->Url = Url;
+  Export->ExportId = FGuid::NewGuid().ToString(EGuidFormats::DigitsLower);
+  Export->AgentId = Snapshot.AgentId;
+  Export->Persona = Snapshot.Persona;
+  Export->Config = Config;
+  Export->Cache = MoveTemp(Cache);
+  Export->OnProgress = MoveTemp(OnProgress);
+  Export->OnComplete = MoveTemp(OnComplete);
+
+  // The cache only changes on the game thread, so the export gets a copy
+  if (Export->Cache.IsValid()) {
+    Export->Known = Export->Cache->Uploaded;
+  }
+
+  Async(EAsyncExecution::ThreadPool,
+        [Export, Snapshot = MoveTemp(Snapshot)]() mutable {
+          PlanBlocks(MoveTemp(Snapshot), Export->Config, Export->Plan);
+          Export->Progress.Blocks = NumBlocks(Export->Plan);
+          ReportProgress(Export);
+          SendNext(Export);
+        });
+
+  return Export;
+}
+
+bool Resume(const FSoulExportPtr &Export) {
+  if (!Export.IsValid() || !Export->bStopped) {
+    return false;
+  }
+  Export->bStopped = false;
+  Export->Attempts = 0;
+  Export->Recoveries = 0;
+  SendNext(Export);
+  return true;
+}
+
+} // namespace SoulExportOps
+} // namespace Soul
+} // namespace ForbocAI
@@ -0,0 +1,192 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "State/AgentStateTree.h"
+
+namespace ForbocAI {
+namespace Soul {
+
+// ── Streaming Soul Export ──
+// A Soul goes up as content-addressed blocks instead of one FSoul built and
+// serialized on the game thread. The game thread only snapshots the agent's
+// state tree, which is persistent, so that copies a pointer. A pool thread
+// then plans the blocks: a header block (id, persona, state without
+// memories), then the memories, split into blocks by key hash. Nothing is
+// written yet.
+//
+// Blocks are written, hashed (as raw JSON) and compressed one at a time,
+// each once the one before it has finished uploading, so only one block's
+// bytes are held at once; the export keeps just the hashes of the rest.
+// Blocks the endpoint already holds from an earlier export are skipped
+// before compression. The rest go up in fixed-size chunks, one request at a
+// time. A chunk the endpoint didn't take is retried from the offset it
+// reports. An export that runs out of attempts, or fails to write a block,
+// stops, and Resume picks it up where it left off.
+//
+// A commit then lists every block in order. An endpoint may have dropped
+// blocks an earlier export left it; the commit reply names those, and they
+// are written again from the plan, uploaded and the commit repeated.
+//
+// Wire format (JSON, one route):
+//   chunk:  {"op": "chunk", "exportId", "block", "rawSize", "size",
+//            "offset", "data": base64 zlib bytes}
+//           -> {"received": bytes of the block held}
+//   commit: {"op": "commit", "exportId", "agentId", "persona",
+//            "compression": "zlib", "blocks": [{"block", "rawSize"}, ...]}
+//           -> {"txId"}, or {"missing": [block, ...]} if it lacks blocks
+// block is the CityHash64, as 16 hex digits, of the block's UTF-8 JSON:
+// {"agentId", "persona", "state"} or {"memories": {...}}.
+
+struct FSoulSnapshot {
+  FString AgentId;
+  FString Persona;
+  // The agent's state. Memories are the map under "memories".
+  State::FAgentStateObject State;
+};
+
+// A snapshot split into blocks, none of them written yet. Block 0 is the
+// header; block N > 0 is MemoryBlocks[N - 1].
+struct FSoulBlockPlan {
+  using FMemoryRef = TPair<FName, const State::FAgentStateValue *>;
+
+  // Holds the tree the memory refs point into
+  FSoulSnapshot Snapshot;
+  // Each memory block's memories, in key order. Empty blocks are left out.
+  TArray<TArray<FMemoryRef>> MemoryBlocks;
+};
+
+struct FSoulExportConfig {
+  // Memories per block, on average. The block count is rounded up to a
+  // power of two, so most memories keep their block as others come and go.
+  int32 MemoriesPerBlock = 256;
+  // Compressed bytes per upload request
+  int32 ChunkBytes = 64 * 1024;
+  // Tries per request, and commits answered with missing blocks, before the
+  // export stops (see SoulExportOps::Resume)
+  int32 MaxAttempts = 3;
+#if WITH_FORBOCAI_STUB_SERVER
+  // Block writes to fail as if compression had, once WriteFailuresAfter
+  // blocks are written. For specs.
+  int32 WriteFailures = 0;
+  int32 WriteFailuresAfter = 0;
+#endif
+};
+
+struct FSoulBlock {
+  uint64 Hash = 0;
+  // Size of the block's JSON, in UTF-8 bytes
+  int32 RawSize = 0;
+  // The endpoint already holds this block. Data is left empty.
+  bool bKnown = false;
+  // zlib-compressed JSON
+  TArray<uint8> Data;
+};
+
+// Blocks an endpoint is known to hold, shared by exports to it. Game thread.
+struct FSoulBlockCache {
+  TSet<uint64> Uploaded;
+};
+
+using FSoulBlockCachePtr = TSharedPtr<FSoulBlockCache, ESPMode::ThreadSafe>;
+
+struct FSoulExportProgress {
+  int32 Blocks = 0;
+  // Blocks written so far that the endpoint already held, not uploaded
+  int32 BlocksSkipped = 0;
+  // Size of the Soul's JSON written so far, in UTF-8 bytes
+  int64 RawBytes = 0;
+  // Compressed bytes written to upload so far, and acknowledged. Grows as
+  // blocks are written.
+  int64 BytesTotal = 0;
+  int64 BytesSent = 0;
+};
+
+using FSoulExportProgressCallback =
+    TFunction<void(const FSoulExportProgress &Progress)>;
+
+// TxId is empty unless bOk.
+using FSoulExportCallback = TFunction<void(bool bOk, const FString &TxId)>;
+
+// One export. Only one thread touches it at a time: the pool thread writing
+// a block, then the thread completing its one request in flight, and so on;
+// once it has stopped, the game thread calling Resume.
+struct FSoulExport {
+  FString Url;
+  FString ExportId;
+  FString AgentId;
+  FString Persona;
+  FSoulExportConfig Config;
+  FSoulBlockCachePtr Cache;
+  FSoulExportProgressCallback OnProgress;
+  FSoulExportCallback OnComplete;
+
+  FSoulBlockPlan Plan;
+  // Hashes of the blocks the endpoint held when the export started
+  TSet<uint64> Known;
+  // The blocks written so far, in plan order. Only the one uploading holds
+  // Data; an uploaded block is marked bKnown.
+  TArray<FSoulBlock> Blocks;
+  // Where the upload is: the block, and the offset into its Data
+  int32 NextBlock = 0;
+  int32 NextOffset = 0;
+  // Failed tries of the current request
+  int32 Attempts = 0;
+  // Commits answered with missing blocks
+  int32 Recoveries = 0;
+  // Out of attempts, waiting for Resume
+  bool bStopped = false;
+  FSoulExportProgress Progress;
+};
+
+using FSoulExportPtr = TSharedPtr<FSoulExport, ESPMode::ThreadSafe>;
+
+namespace SoulExportOps {
+
+// Splits Snapshot into blocks without writing any. Any thread.
+void PlanBlocks(FSoulSnapshot Snapshot, const FSoulExportConfig &Config,
+                FSoulBlockPlan &OutPlan);
+
+inline int32 NumBlocks(const FSoulBlockPlan &Plan) {
+  return 1 + Plan.MemoryBlocks.Num();
+}
+
+// Writes block Index of Plan. A block whose hash is in Known comes back
+// marked bKnown, uncompressed. Any thread.
+bool WriteBlock(const FSoulBlockPlan &Plan, int32 Index,
+                const TSet<uint64> &Known, FSoulBlock &OutBlock);
+
+// Plans and writes every block of Snapshot at once, the header first.
+bool WriteBlocks(const FSoulSnapshot &Snapshot, const TSet<uint64> &Known,
+                 const FSoulExportConfig &Config,
+                 TArray<FSoulBlock> &OutBlocks);
+
+// Decompresses Block's JSON. Fails for a known block, which has no data.
+bool ReadBlock(const FSoulBlock &Block, FString &OutJson);
+
+// Hash as it goes on the wire.
+FString BlockName(uint64 Hash);
+
+// The request for the chunk at Export's upload position.
+FString BuildChunkBody(const FSoulExport &Export);
+
+FString BuildCommitBody(const FSoulExport &Export);
+
+// Exports Snapshot to Url, skipping the blocks Cache says it holds (Cache
+// may be null). Blocks are written off the game thread. OnProgress and
+// OnComplete run on the game thread. Blocks the endpoint reports missing
+// are dropped from Cache, and a successful export adds its blocks to Cache
+// before OnComplete. Game thread.
+FSoulExportPtr Start(const FString &Url, FSoulSnapshot Snapshot,
+                     FSoulBlockCachePtr Cache, const FSoulExportConfig &Config,
+                     FSoulExportProgressCallback OnProgress,
+                     FSoulExportCallback OnComplete);
+
+// Restarts a stopped export from the last offset the endpoint acknowledged.
+// Call it after OnComplete reports failure. Returns false if Export isn't
+// stopped. Game thread.
+bool Resume(const FSoulExportPtr &Export);
+
+} // namespace SoulExportOps
+
+} // namespace Soul
+} // namespace ForbocAI
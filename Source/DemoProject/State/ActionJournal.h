@@ -0,0 +1,544 @@
+#pragma once
+
+#include "Actions.h"
+#include "BotState.h"
+#include "CoreMinimal.h"
+#include "Reducers.h"
+
+namespace ForbocAI {
+namespace State {
+
+// ── Action Journal ──
+// A record of every action dispatched to one bot. Because the reducer is
+// pure, a kept state plus what followed it reproduces every later state
+// exactly, offline and bit for bit.
+//
+// Heartbeats are identical for every bot of an LOD tier, so they aren't
+// copied into each journal: the owner appends one FHeartbeatPass per tier
+// pass to a shared FHeartbeatLog, each journal records its own actions and
+// the tier it is in, and replay merges the two.
+//
+// Entry encoding (little-endian):
+//   Type(u8: variant index, or TierEntry) PassDelta(varint) Payload
+// PassDelta is the log's pass count when the entry was recorded minus the
+// previous entry's; the entry comes after every pass before it. A
+// TierEntry's payload (u8) is the tier whose passes apply from there on.
+// Actor pointers (damage source, attack target) aren't recorded and replay
+// as nullptr; the reducer never reads them.
+//
+// Every KeyframeInterval entries (and whenever the owner calls AddKeyframe)
+// the journal keeps a copy of the state, so seeking replays only from the
+// nearest one. Past MaxKeyframes the oldest are dropped along with the
+// entries before them, which bounds the journal; replay then starts at the
+// oldest one kept.
+
+struct FHeartbeatPass {
+  uint8 Tier = 0;
+  FActionTick Heartbeat;
+};
+
+struct FHeartbeatLog {
+  // Passes[i] is pass number First + i; earlier ones were trimmed
+  TArray<FHeartbeatPass> Passes;
+  uint64 First = 0;
+};
+
+struct FJournalCursor {
+  int32 Offset = 0;
+  // Action entries read (tier entries and heartbeats aren't counted)
+  int32 Entry = 0;
+  // Pass the last entry read was recorded at, the base of the next delta
+  uint64 EntryPass = 0;
+  // Next heartbeat pass to look at, and the tier whose passes apply
+  uint64 Pass = 0;
+  uint8 Tier = MAX_uint8;
+};
+
+struct FJournalKeyframe {
+  FJournalCursor Cursor;
+  FBotState State;
+};
+
+struct FActionJournal {
+  // The state at Keyframes[0], where replay starts
+  FBotState Initial;
+  TArray<uint8> Bytes;
+  int32 KeyframeInterval = 256;
+  // Keyframes kept at most (0 = all)
+  int32 MaxKeyframes = 0;
+
+  TArray<FJournalKeyframe> Keyframes;
+
+  // Where the next entry goes
+  FJournalCursor End;
+
+  // The heartbeats merged in on replay; null if every tick is an entry
+  TSharedPtr<const FHeartbeatLog> Heartbeats;
+};
+
+namespace JournalOps {
+
+constexpr uint32 FileMagic = 0x4E524A46; // "FJRN"
+constexpr uint16 FileVersion = 2;
+
+// Stands for "no tier" in FJournalCursor::Tier, so no pass applies.
+constexpr uint8 NoTier = MAX_uint8;
+
+static_assert(std::variant_size_v<FBotAction> == 6,
+              "New action type: give it an encoding below and bump "
+              "FileVersion");
+
+namespace Detail {
+
+constexpr uint8 TierEntry = 0xFF;
+
+template <typename ValueType>
+void Append(TArray<uint8> &Out, const ValueType &Value) {
+  const int32 Start = Out.AddUninitialized(sizeof(ValueType));
+  ::FMemory::Memcpy(Out.GetData() + Start, &Value, sizeof(ValueType));
+}
+
+inline void AppendVarint(TArray<uint8> &Out, uint64 Value) {
+  while (Value >= 0x80) {
+    Out.Add((uint8)(Value | 0x80));
+    Value >>= 7;
+  }
+  Out.Add((uint8)Value);
+}
+
+// Bounds-checked reads; a read past the end fails the whole decode.
+struct FReader {
+  TArrayView<const uint8> Data;
+  int32 Offset = 0;
+  bool bOk = true;
+
+  template <typename ValueType> ValueType Read() {
+    ValueType Value{};
+    if (Offset + (int32)sizeof(ValueType) > Data.Num()) {
+      bOk = false;
+      return Value;
+    }
+    ::FMemory::Memcpy(&Value, Data.GetData() + Offset, sizeof(ValueType));
+    Offset += sizeof(ValueType);
+    return Value;
+  }
+
+  uint64 ReadVarint() {
+    uint64 Value = 0;
+    for (int32 Shift = 0; Shift < 64; Shift += 7) {
+      const uint8 Byte = Read<uint8>();
+      Value |= (uint64)(Byte & 0x7F) << Shift;
+      if (!bOk || !(Byte & 0x80)) {
+        return Value;
+      }
+    }
+    bOk = false;
+    return Value;
+  }
+};
+
+struct FEncodeVisitor {
+  TArray<uint8> &Out;
+
+  void operator()(const FActionTick &Action) const {
+    Append(Out, Action.DeltaTime);
+    Append(Out, Action.Steps);
+  }
+  void operator()(const FActionMove &Action) const {
+    Append(Out, Action.TargetLocation);
+    Append(Out, Action.Speed);
+  }
+  void operator()(const FActionTakeDamage &Action) const {
+    Append(Out, Action.Amount);
+  }
+  void operator()(const FActionSpotEnemy &Action) const {
+    Append(Out, Action.EnemyLocation);
+  }
+  void operator()(const FActionAttack &) const {}
+  void operator()(const FActionFlee &Action) const {
+    Append(Out, Action.AwayFrom);
+  }
+};
+
+// A state, field by field: nothing of FBotState's in-memory layout (its
+// padding included) reaches the file. The name is written separately.
+inline void AppendState(TArray<uint8> &Out, const FBotState &State) {
+  Append(Out, State.Id.A);
+  Append(Out, State.Id.B);
+  Append(Out, State.Id.C);
+  Append(Out, State.Id.D);
+  Append(Out, State.Position);
+  Append(Out, State.Rotation);
+  Append(Out, State.Stats.Health);
+  Append(Out, State.Stats.MaxHealth);
+  Append(Out, State.Stats.Mana);
+  Append(Out, State.Stats.MaxMana);
+  Append(Out, State.Stats.Stamina);
+  Append(Out, State.Stats.MaxStamina);
+  Append(Out, State.Memory.LastKnownPlayerPos);
+  Append(Out, State.Memory.TimeSinceLastSeenPlayer);
+  Append(Out, (uint8)(State.Memory.bHasAggro ? 1 : 0));
+  Append(Out, (uint8)State.Phase);
+  Append(Out, State.TickCount);
+}
+
+inline FBotState ReadState(FReader &Reader) {
+  FBotState State;
+  State.Id.A = Reader.Read<uint32>();
+  State.Id.B = Reader.Read<uint32>();
+  State.Id.C = Reader.Read<uint32>();
+  State.Id.D = Reader.Read<uint32>();
+  State.Position = Reader.Read<FVector>();
+  State.Rotation = Reader.Read<FRotator>();
+  State.Stats.Health = Reader.Read<float>();
+  State.Stats.MaxHealth = Reader.Read<float>();
+  State.Stats.Mana = Reader.Read<float>();
+  State.Stats.MaxMana = Reader.Read<float>();
+  State.Stats.Stamina = Reader.Read<float>();
+  State.Stats.MaxStamina = Reader.Read<float>();
+  State.Memory.LastKnownPlayerPos = Reader.Read<FVector>();
+  State.Memory.TimeSinceLastSeenPlayer = Reader.Read<float>();
+  State.Memory.bHasAggro = Reader.Read<uint8>() != 0;
+  const uint8 Phase = Reader.Read<uint8>();
+  if (Phase > (uint8)EBotPhase::Search) {
+    Reader.bOk = false;
+  }
+  State.Phase = (EBotPhase)Phase;
+  State.TickCount = Reader.Read<uint64>();
+  return State;
+}
+
+inline bool Decode(FReader &Reader, uint8 Type, FBotAction &Out) {
+  switch (Type) {
+  case ActionIndex<FActionTick>: {
+    FActionTick Tick;
+    Tick.DeltaTime = Reader.Read<float>();
+    Tick.Steps = Reader.Read<uint32>();
+    Out = Tick;
+    break;
+  }
+  case ActionIndex<FActionMove>: {
+    FActionMove Move;
+    Move.TargetLocation = Reader.Read<FVector>();
+    Move.Speed = Reader.Read<float>();
+    Out = Move;
+    break;
+  }
+  case ActionIndex<FActionTakeDamage>: {
+    FActionTakeDamage Damage;
+    Damage.Amount = Reader.Read<float>();
+    Damage.Source = nullptr;
+    Out = Damage;
+    break;
+  }
+  case ActionIndex<FActionSpotEnemy>:
+    Out = FActionSpotEnemy{Reader.Read<FVector>()};
+    break;
+  case ActionIndex<FActionAttack>:
+    Out = FActionAttack{nullptr};
+    break;
+  case ActionIndex<FActionFlee>:
+    Out = FActionFlee{Reader.Read<FVector>()};
+    break;
+  default:
+    return false;
+  }
+  return Reader.bOk;
+}
+
+} // namespace Detail
+
+// ── Heartbeat Log ──
+
+// Number of passes ever appended (trimmed ones included).
+inline uint64 PassEnd(const FHeartbeatLog *Log) {
+  return Log ? Log->First + Log->Passes.Num() : 0;
+}
+
+inline void AppendPass(FHeartbeatLog &Log, int32 Tier,
+                       const FActionTick &Heartbeat) {
+  Log.Passes.Add({(uint8)Tier, Heartbeat});
+}
+
+// Drops every pass before Pass.
+inline void TrimLog(FHeartbeatLog &Log, uint64 Pass) {
+  const int32 Count =
+      (int32)FMath::Min<uint64>(Pass - FMath::Min(Pass, Log.First),
+                                (uint64)Log.Passes.Num());
+  Log.Passes.RemoveAt(0, Count, EAllowShrinking::No);
+  Log.First += Count;
+}
+
+// ── Recording ──
+
+// Starts an empty journal whose first state is Initial. With Heartbeats,
+// its passes are merged in for whichever tier RecordTier last named.
+inline void Begin(FActionJournal &Journal, const FBotState &Initial,
+                  int32 KeyframeInterval = 256,
+                  TSharedPtr<const FHeartbeatLog> Heartbeats = nullptr) {
+  Journal.Initial = Initial;
+  Journal.Bytes.Reset();
+  Journal.KeyframeInterval = FMath::Max(1, KeyframeInterval);
+  Journal.Heartbeats = MoveTemp(Heartbeats);
+  const uint64 Pass = PassEnd(Journal.Heartbeats.Get());
+  Journal.End = {0, 0, Pass, Pass, NoTier};
+  Journal.Keyframes.Reset();
+  Journal.Keyframes.Add({Journal.End, Initial});
+}
+
+inline int32 Num(const FActionJournal &Journal) { return Journal.End.Entry; }
+
+// The first heartbeat pass replay can still need; the log may drop the
+// ones before it.
+inline uint64 OldestPass(const FActionJournal &Journal) {
+  return Journal.Keyframes[0].Cursor.Pass;
+}
+
+// Drops the oldest keyframes past MaxKeyframes and the entries before the
+// oldest one left.
+inline void Trim(FActionJournal &Journal) {
+  const int32 Excess = Journal.MaxKeyframes > 0
+                           ? Journal.Keyframes.Num() - Journal.MaxKeyframes
+                           : 0;
+  if (Excess <= 0) {
+    return;
+  }
+  Journal.Keyframes.RemoveAt(0, Excess, EAllowShrinking::No);
+  Journal.Initial = Journal.Keyframes[0].State;
+
+  const int32 Cut = Journal.Keyframes[0].Cursor.Offset;
+  Journal.Bytes.RemoveAt(0, Cut, EAllowShrinking::No);
+  for (FJournalKeyframe &Keyframe : Journal.Keyframes) {
+    Keyframe.Cursor.Offset -= Cut;
+  }
+  Journal.End.Offset -= Cut;
+}
+
+// Keeps State, the bot's state now, as a keyframe.
+inline void AddKeyframe(FActionJournal &Journal, const FBotState &State) {
+  FJournalCursor Now = Journal.End;
+  Now.Pass = PassEnd(Journal.Heartbeats.Get());
+  Journal.Keyframes.Add({Now, State});
+  Trim(Journal);
+}
+
+namespace Detail {
+
+// Type and PassDelta of a new entry, moving End past every pass so far.
+inline void BeginEntry(FActionJournal &Journal, uint8 Type) {
+  const uint64 Pass = PassEnd(Journal.Heartbeats.Get());
+  Append(Journal.Bytes, Type);
+  AppendVarint(Journal.Bytes, Pass - Journal.End.EntryPass);
+  Journal.End.EntryPass = Pass;
+  Journal.End.Pass = Pass;
+}
+
+} // namespace Detail
+
+// Appends Action, given the state the bot reduced to (what Dispatch
+// returned).
+inline void Record(FActionJournal &Journal, const FBotAction &Action,
+                   const FBotState &After) {
+  Detail::BeginEntry(Journal, (uint8)Action.index());
+  std::visit(Detail::FEncodeVisitor{Journal.Bytes}, Action);
+
+  Journal.End.Offset = Journal.Bytes.Num();
+  if (++Journal.End.Entry % Journal.KeyframeInterval == 0) {
+    Journal.Keyframes.Add({Journal.End, After});
+    Trim(Journal);
+  }
+}
+
+// From now on the bot gets the heartbeats of Tier.
+inline void RecordTier(FActionJournal &Journal, int32 Tier) {
+  Detail::BeginEntry(Journal, Detail::TierEntry);
+  Detail::Append(Journal.Bytes, (uint8)Tier);
+  Journal.End.Offset = Journal.Bytes.Num();
+  Journal.End.Tier = (uint8)Tier;
+}
+
+// ── Reading ──
+
+// Decodes the next action at Cursor, entry or merged heartbeat, and
+// advances past it. Past the last entry, heartbeats run to the log's end.
+inline bool Next(const FActionJournal &Journal, FJournalCursor &Cursor,
+                 FBotAction &OutAction) {
+  const FHeartbeatLog *Log = Journal.Heartbeats.Get();
+  for (;;) {
+    Detail::FReader Reader{Journal.Bytes, Cursor.Offset};
+    const bool bEntry = Cursor.Offset < Journal.Bytes.Num();
+    uint8 Type = 0;
+    uint64 EntryPass = PassEnd(Log);
+    if (bEntry) {
+      Type = Reader.Read<uint8>();
+      EntryPass = Cursor.EntryPass + Reader.ReadVarint();
+      if (!Reader.bOk || EntryPass > PassEnd(Log)) {
+        return false;
+      }
+    }
+
+    // The bot's heartbeats that came before the entry
+    for (; Log && Cursor.Pass < EntryPass; ++Cursor.Pass) {
+      if (Cursor.Pass < Log->First) {
+        return false; // trimmed away under the journal
+      }
+      const FHeartbeatPass &Pass = Log->Passes[Cursor.Pass - Log->First];
+      if (Pass.Tier == Cursor.Tier) {
+        ++Cursor.Pass;
+        OutAction = Pass.Heartbeat;
+        return true;
+      }
+    }
+    if (!bEntry) {
+      return false;
+    }
+
+    if (Type == Detail::TierEntry) {
+      const uint8 Tier = Reader.Read<uint8>();
+      if (!Reader.bOk) {
+        return false;
+      }
+      Cursor = {Reader.Offset, Cursor.Entry, EntryPass, EntryPass, Tier};
+      continue;
+    }
+    if (!Detail::Decode(Reader, Type, OutAction)) {
+      return false;
+    }
+    Cursor = {Reader.Offset, Cursor.Entry + 1, EntryPass, EntryPass,
+              Cursor.Tier};
+    return true;
+  }
+}
+
+// Calls Fn(Action) for every action from the oldest keyframe on.
+template <typename FnType>
+void ForEach(const FActionJournal &Journal, FnType &&Fn) {
+  FJournalCursor Cursor = Journal.Keyframes[0].Cursor;
+  FBotAction Action;
+  while (Next(Journal, Cursor, Action)) {
+    Fn(Action);
+  }
+}
+
+// ── Replay ──
+
+// The state right after the first Entry entries (or the oldest kept one).
+inline FBotState StateAtEntry(const FActionJournal &Journal, int32 Entry) {
+  Entry = FMath::Clamp(Entry, Journal.Keyframes[0].Cursor.Entry,
+                       Num(Journal));
+
+  // The last keyframe before the entry; a keyframe taken at it may already
+  // hold the heartbeats that followed
+  int32 First = 0;
+  int32 Last = Journal.Keyframes.Num() - 1;
+  while (First < Last) {
+    const int32 Middle = (First + Last + 1) / 2;
+    if (Journal.Keyframes[Middle].Cursor.Entry < Entry) {
+      First = Middle;
+    } else {
+      Last = Middle - 1;
+    }
+  }
+
+  FBotState State = Journal.Keyframes[First].State;
+  FJournalCursor Cursor = Journal.Keyframes[First].Cursor;
+  FBotAction Action;
+  while (Cursor.Entry < Entry && Next(Journal, Cursor, Action)) {
+    ReduceInPlace(State, Action);
+  }
+  return State;
+}
+
+// The state once the bot's TickCount reached Tick: every action dispatched
+// before the heartbeat that took it past Tick (or the oldest kept state).
+inline FBotState StateAtTick(const FActionJournal &Journal, uint64 Tick) {
+  // Keyframe ticks only grow, so the last one not past Tick is the start
+  int32 First = 0;
+  int32 Last = Journal.Keyframes.Num() - 1;
+  while (First < Last) {
+    const int32 Middle = (First + Last + 1) / 2;
+    if (Journal.Keyframes[Middle].State.TickCount <= Tick) {
+      First = Middle;
+    } else {
+      Last = Middle - 1;
+    }
+  }
+
+  FBotState State = Journal.Keyframes[First].State;
+  FJournalCursor Cursor = Journal.Keyframes[First].Cursor;
+  FBotAction Action;
+  while (Next(Journal, Cursor, Action)) {
+    const FActionTick *Heartbeat = std::get_if<FActionTick>(&Action);
+    if (State.TickCount + (Heartbeat ? Heartbeat->Steps : 0) > Tick) {
+      break;
+    }
+    ReduceInPlace(State, Action);
+  }
+  return State;
+}
+
+// ── Files ──
+// Magic(u32) Version(u16) KeyframeInterval(i32) NameLength(i32)
+// Name(UTF-8) Initial(see Detail::AppendState) Entries...
+// Initial is the oldest kept state. A file stands alone: heartbeats are
+// written as entries of their own and every PassDelta is 0. Keyframes
+// aren't stored; Load rebuilds them with one replay.
+
+inline void Save(const FActionJournal &Journal, TArray<uint8> &Out) {
+  const FTCHARToUTF8 Name(*Journal.Initial.Name.ToString());
+
+  Out.Reset();
+  Detail::Append(Out, FileMagic);
+  Detail::Append(Out, FileVersion);
+  Detail::Append(Out, Journal.KeyframeInterval);
+  Detail::Append(Out, (int32)Name.Length());
+  Out.Append((const uint8 *)Name.Get(), Name.Length());
+  Detail::AppendState(Out, Journal.Initial);
+  ForEach(Journal, [&Out](const FBotAction &Action) {
+    Detail::Append(Out, (uint8)Action.index());
+    Detail::AppendVarint(Out, 0);
+    std::visit(Detail::FEncodeVisitor{Out}, Action);
+  });
+}
+
+inline bool Load(TArrayView<const uint8> Data, FActionJournal &Out) {
+  Detail::FReader Reader{Data};
+  const uint32 Magic = Reader.Read<uint32>();
+  const uint16 Version = Reader.Read<uint16>();
+  const int32 KeyframeInterval = Reader.Read<int32>();
+  const int32 NameLength = Reader.Read<int32>();
+  if (!Reader.bOk || Magic != FileMagic || Version != FileVersion ||
+      NameLength < 0 || Reader.Offset + NameLength > Data.Num()) {
+    return false;
+  }
+
+  const FUTF8ToTCHAR Name((const ANSICHAR *)Data.GetData() + Reader.Offset,
+                          NameLength);
+  Reader.Offset += NameLength;
+  FBotState Initial = Detail::ReadState(Reader);
+  if (!Reader.bOk) {
+    return false;
+  }
+  Initial.Name = FName(Name.Length(), Name.Get());
+
+  Begin(Out, Initial, KeyframeInterval);
+  Out.Bytes.Append(Data.GetData() + Reader.Offset, Data.Num() - Reader.Offset);
+
+  // One pass to validate every entry and lay the keyframes back down
+  FBotState State = Initial;
+  FJournalCursor Cursor = Out.End;
+  FBotAction Action;
+  while (Next(Out, Cursor, Action)) {
+    ReduceInPlace(State, Action);
+    if (Cursor.Entry % Out.KeyframeInterval == 0) {
+      Out.Keyframes.Add({Cursor, State});
+    }
+  }
+  Out.End = Cursor;
+  return Cursor.Offset == Out.Bytes.Num();
+}
+
+} // namespace JournalOps
+
+} // namespace State
+} // namespace ForbocAI
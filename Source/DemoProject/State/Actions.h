@@ -1,6 +1,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include <type_traits>
 #include <variant>
 
 namespace ForbocAI {
@@ -10,6 +11,8 @@ namespace State {
 
 struct FActionTick {
   float DeltaTime;
+  // Heartbeats folded into this one (see QueueOps::Drain coalescing)
+  uint32 Steps = 1;
 };
 
 struct FActionMove {
@@ -34,11 +37,43 @@ struct FActionFlee {
   FVector AwayFrom;
 };
 
+// ── Action Registry ──
+// Every action type, in variant order. A new action is added here only:
+// FBotAction, ActionIndex and the reducer's jump table are generated from
+// this list, and the build fails until the reducer has a handler for it.
+
+template <typename... ActionTypes> struct TActionList {
+  using Variant = std::variant<ActionTypes...>;
+  static constexpr int32 Num = sizeof...(ActionTypes);
+};
+
+using FBotActionList =
+    TActionList<FActionTick, FActionMove, FActionTakeDamage, FActionSpotEnemy,
+                FActionAttack, FActionFlee>;
+
 // ── Action Variant (Sum Type) ──
 
 // The set of all possible actions the reducer can handle
-using FBotAction = std::variant<FActionTick, FActionMove, FActionTakeDamage,
-                                FActionSpotEnemy, FActionAttack, FActionFlee>;
+using FBotAction = FBotActionList::Variant;
+
+namespace Detail {
+
+template <typename ActionType, typename... ActionTypes>
+constexpr int32 IndexOf(TActionList<ActionTypes...>) {
+  const bool bMatches[] = {std::is_same_v<ActionType, ActionTypes>...};
+  for (int32 Index = 0; Index < (int32)sizeof...(ActionTypes); ++Index) {
+    if (bMatches[Index]) {
+      return Index;
+    }
+  }
+  return INDEX_NONE;
+}
+
+} // namespace Detail
+
+// Variant index of ActionType (FBotAction::index()), usable as a case label.
+template <typename ActionType>
+constexpr int32 ActionIndex = Detail::IndexOf<ActionType>(FBotActionList{});
 
 } // namespace State
 } // namespace ForbocAI
@@ -0,0 +1,503 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
+#include <variant>
+
+namespace ForbocAI {
+namespace State {
+
+// ── Agent State Tree ──
+// An agent's state as a persistent map of names to values. Maps nest, so
+// a memory set is a map under "memories". Nothing is changed in place:
+// updating returns a new map that shares every node off the changed path
+// with the old one. A change under a map of N keys allocates about
+// log32(N) nodes of at most 32 slots each, with no deep copy.
+//
+// Each map is a hash trie (CHAMP layout). A node has 32 slots indexed by 5
+// bits of the key's hash. Each slot holds nothing, an entry or a child
+// node, and keys whose hashes agree on every bit share a collision node.
+// Strings are shared too, so copying a node copies pointers only.
+//
+// Updates are typed FAgentStatePatch ops, and the SDK's JSON form is only
+// written when something reads it (ToJson, with proper escaping).
+
+struct FAgentStateNode;
+using FAgentStateNodePtr =
+    TSharedPtr<const FAgentStateNode, ESPMode::ThreadSafe>;
+
+// A map of names to values (names compare case-insensitively).
+struct FAgentStateObject {
+  FAgentStateNodePtr Root;
+  int32 Num = 0;
+};
+
+using FAgentStateString = TSharedRef<const FString, ESPMode::ThreadSafe>;
+
+using FAgentStateValue =
+    std::variant<bool, double, FAgentStateString, FAgentStateObject>;
+
+struct FAgentStateEntry {
+  FName Key;
+  FAgentStateValue Value;
+};
+
+struct FAgentStateNode {
+  // Slots holding an entry / a child node, one bit per slot
+  uint32 EntryMap = 0;
+  uint32 NodeMap = 0;
+  // In slot order. A collision node has its entries here, maps unused.
+  TArray<FAgentStateEntry> Entries;
+  TArray<FAgentStateNodePtr> Nodes;
+};
+
+// Changes to apply in order. An op without a Value removes its path.
+struct FAgentStatePatch {
+  struct FOp {
+    TArray<FName> Path;
+    TOptional<FAgentStateValue> Value;
+  };
+  TArray<FOp> Ops;
+};
+
+namespace AgentStateOps {
+
+namespace Detail {
+
+constexpr uint32 BitsPerLevel = 5;
+// Past this shift the hash is used up and nodes are collision nodes
+constexpr uint32 MaxShift = 30;
+
+using FMutableNode = TSharedRef<FAgentStateNode, ESPMode::ThreadSafe>;
+
+inline uint32 HashOf(FName Key) { return GetTypeHash(Key); }
+
+inline uint32 BitOf(uint32 Hash, uint32 Shift) {
+  return 1u << ((Hash >> Shift) & 31u);
+}
+
+// Position of Bit's slot among the used slots in Map
+inline int32 IndexOf(uint32 Map, uint32 Bit) {
+  return (int32)FPlatformMath::CountBits(Map & (Bit - 1));
+}
+
+inline FMutableNode CopyOf(const FAgentStateNode *Node) {
+  return Node ? MakeShared<FAgentStateNode, ESPMode::ThreadSafe>(*Node)
+              : MakeShared<FAgentStateNode, ESPMode::ThreadSafe>();
+}
+
+// A node holding A and B, whose hashes agree below Shift
+inline FAgentStateNodePtr MergePair(FAgentStateEntry &&A, uint32 HashA,
+                                    FAgentStateEntry &&B, uint32 HashB,
+                                    uint32 Shift) {
+  FMutableNode Node = MakeShared<FAgentStateNode, ESPMode::ThreadSafe>();
+  if (Shift > MaxShift) {
+    Node->Entries.Add(MoveTemp(A));
+    Node->Entries.Add(MoveTemp(B));
+    return Node;
+  }
+
+  const uint32 BitA = BitOf(HashA, Shift);
+  const uint32 BitB = BitOf(HashB, Shift);
+  if (BitA == BitB) {
+    Node->NodeMap = BitA;
+    Node->Nodes.Add(MergePair(MoveTemp(A), HashA, MoveTemp(B), HashB,
+                              Shift + BitsPerLevel));
+    return Node;
+  }
+
+  Node->EntryMap = BitA | BitB;
+  if (BitA < BitB) {
+    Node->Entries.Add(MoveTemp(A));
+    Node->Entries.Add(MoveTemp(B));
+  } else {
+    Node->Entries.Add(MoveTemp(B));
+    Node->Entries.Add(MoveTemp(A));
+  }
+  return Node;
+}
+
+inline const FAgentStateValue *Find(const FAgentStateNode *Node, FName Key,
+                                    uint32 Hash) {
+  for (uint32 Shift = 0; Node; Shift += BitsPerLevel) {
+    if (Shift > MaxShift) {
+      for (const FAgentStateEntry &Entry : Node->Entries) {
+        if (Entry.Key == Key) {
+          return &Entry.Value;
+        }
+      }
+      return nullptr;
+    }
+
+    const uint32 Bit = BitOf(Hash, Shift);
+    if (Node->EntryMap & Bit) {
+      const FAgentStateEntry &Entry =
+          Node->Entries[IndexOf(Node->EntryMap, Bit)];
+      return Entry.Key == Key ? &Entry.Value : nullptr;
+    }
+    if (!(Node->NodeMap & Bit)) {
+      return nullptr;
+    }
+    Node = Node->Nodes[IndexOf(Node->NodeMap, Bit)].Get();
+  }
+  return nullptr;
+}
+
+// Node with Entry set, copying only the nodes on its path
+inline FAgentStateNodePtr Set(const FAgentStateNode *Node,
+                              FAgentStateEntry &&Entry, uint32 Hash,
+                              uint32 Shift, bool &bAdded) {
+  FMutableNode New = CopyOf(Node);
+  if (Shift > MaxShift) {
+    for (FAgentStateEntry &Existing : New->Entries) {
+      if (Existing.Key == Entry.Key) {
+        Existing.Value = MoveTemp(Entry.Value);
+        return New;
+      }
+    }
+    New->Entries.Add(MoveTemp(Entry));
+    bAdded = true;
+    return New;
+  }
+
+  const uint32 Bit = BitOf(Hash, Shift);
+  if (New->EntryMap & Bit) {
+    const int32 Index = IndexOf(New->EntryMap, Bit);
+    if (New->Entries[Index].Key == Entry.Key) {
+      New->Entries[Index].Value = MoveTemp(Entry.Value);
+      return New;
+    }
+
+    // Two keys in one slot: both move down a level
+    FAgentStateEntry Existing = MoveTemp(New->Entries[Index]);
+    const uint32 ExistingHash = HashOf(Existing.Key);
+    New->Entries.RemoveAt(Index);
+    New->EntryMap &= ~Bit;
+    New->NodeMap |= Bit;
+    New->Nodes.Insert(MergePair(MoveTemp(Existing), ExistingHash,
+                                MoveTemp(Entry), Hash, Shift + BitsPerLevel),
+                      IndexOf(New->NodeMap, Bit));
+    bAdded = true;
+    return New;
+  }
+
+  if (New->NodeMap & Bit) {
+    FAgentStateNodePtr &Child = New->Nodes[IndexOf(New->NodeMap, Bit)];
+    Child = Set(Child.Get(), MoveTemp(Entry), Hash, Shift + BitsPerLevel,
+                bAdded);
+    return New;
+  }
+
+  New->EntryMap |= Bit;
+  New->Entries.Insert(MoveTemp(Entry), IndexOf(New->EntryMap, Bit));
+  bAdded = true;
+  return New;
+}
+
+// Node without Key (Node itself if Key isn't there, null once empty)
+inline FAgentStateNodePtr Remove(const FAgentStateNodePtr &Node, FName Key,
+                                 uint32 Hash, uint32 Shift, bool &bRemoved) {
+  if (!Node.IsValid()) {
+    return Node;
+  }
+
+  if (Shift > MaxShift) {
+    const int32 Index = Node->Entries.IndexOfByPredicate(
+        [Key](const FAgentStateEntry &Entry) { return Entry.Key == Key; });
+    if (Index == INDEX_NONE) {
+      return Node;
+    }
+    bRemoved = true;
+    if (Node->Entries.Num() == 1) {
+      return nullptr;
+    }
+    FMutableNode New = CopyOf(Node.Get());
+    New->Entries.RemoveAtSwap(Index);
+    return New;
+  }
+
+  const uint32 Bit = BitOf(Hash, Shift);
+  if (Node->EntryMap & Bit) {
+    const int32 Index = IndexOf(Node->EntryMap, Bit);
+    if (Node->Entries[Index].Key != Key) {
+      return Node;
+    }
+    bRemoved = true;
+    if (Node->Entries.Num() == 1 && Node->NodeMap == 0) {
+      return nullptr;
+    }
+    FMutableNode New = CopyOf(Node.Get());
+    New->Entries.RemoveAt(Index);
+    New->EntryMap &= ~Bit;
+    return New;
+  }
+
+  if (!(Node->NodeMap & Bit)) {
+    return Node;
+  }
+  const int32 Index = IndexOf(Node->NodeMap, Bit);
+  FAgentStateNodePtr Child =
+      Remove(Node->Nodes[Index], Key, Hash, Shift + BitsPerLevel, bRemoved);
+  if (!bRemoved) {
+    return Node;
+  }
+
+  FMutableNode New = CopyOf(Node.Get());
+  if (Child.IsValid() &&
+      (Child->NodeMap != 0 || Child->Entries.Num() > 1)) {
+    New->Nodes[Index] = MoveTemp(Child);
+    return New;
+  }
+
+  // An emptied child goes; a child down to one entry is pulled up into
+  // this slot, keeping the trie as shallow as its keys allow
+  New->Nodes.RemoveAt(Index);
+  New->NodeMap &= ~Bit;
+  if (Child.IsValid()) {
+    New->EntryMap |= Bit;
+    New->Entries.Insert(Child->Entries[0], IndexOf(New->EntryMap, Bit));
+  }
+  if (New->EntryMap == 0 && New->NodeMap == 0) {
+    return nullptr;
+  }
+  return New;
+}
+
+template <typename FnType>
+void ForEach(const FAgentStateNode *Node, FnType &Fn) {
+  if (!Node) {
+    return;
+  }
+  for (const FAgentStateEntry &Entry : Node->Entries) {
+    Fn(Entry.Key, Entry.Value);
+  }
+  for (const FAgentStateNodePtr &Child : Node->Nodes) {
+    ForEach(Child.Get(), Fn);
+  }
+}
+
+} // namespace Detail
+
+// ── Values ──
+
+inline FAgentStateValue MakeValue(const FString &Value) {
+  return FAgentStateString(
+      MakeShared<const FString, ESPMode::ThreadSafe>(Value));
+}
+
+// Without these, literals and ints would convert to bool
+inline FAgentStateValue MakeValue(const TCHAR *Value) {
+  return MakeValue(FString(Value));
+}
+inline FAgentStateValue MakeValue(int32 Value) { return (double)Value; }
+
+inline FAgentStateValue MakeValue(double Value) { return Value; }
+inline FAgentStateValue MakeValue(bool Value) { return Value; }
+inline FAgentStateValue MakeValue(FAgentStateObject Value) {
+  return MoveTemp(Value);
+}
+
+// ── Lookup ──
+
+inline const FAgentStateValue *Find(const FAgentStateObject &Object,
+                                    FName Key) {
+  return Detail::Find(Object.Root.Get(), Key, Detail::HashOf(Key));
+}
+
+// The value at Path, through nested maps.
+inline const FAgentStateValue *Find(const FAgentStateObject &Object,
+                                    TArrayView<const FName> Path) {
+  const FAgentStateObject *Current = &Object;
+  const FAgentStateValue *Value = nullptr;
+  for (const FName Key : Path) {
+    if (!Current) {
+      return nullptr;
+    }
+    Value = Find(*Current, Key);
+    if (!Value) {
+      return nullptr;
+    }
+    Current = std::get_if<FAgentStateObject>(Value);
+  }
+  return Value;
+}
+
+inline const FString *FindString(const FAgentStateObject &Object,
+                                 TArrayView<const FName> Path) {
+  const FAgentStateValue *Value = Find(Object, Path);
+  const FAgentStateString *String =
+      Value ? std::get_if<FAgentStateString>(Value) : nullptr;
+  return String ? &String->Get() : nullptr;
+}
+
+inline const double *FindNumber(const FAgentStateObject &Object,
+                                TArrayView<const FName> Path) {
+  const FAgentStateValue *Value = Find(Object, Path);
+  return Value ? std::get_if<double>(Value) : nullptr;
+}
+
+inline const bool *FindBool(const FAgentStateObject &Object,
+                            TArrayView<const FName> Path) {
+  const FAgentStateValue *Value = Find(Object, Path);
+  return Value ? std::get_if<bool>(Value) : nullptr;
+}
+
+inline const FAgentStateObject *FindObject(const FAgentStateObject &Object,
+                                           TArrayView<const FName> Path) {
+  const FAgentStateValue *Value = Find(Object, Path);
+  return Value ? std::get_if<FAgentStateObject>(Value) : nullptr;
+}
+
+// Calls Fn(FName Key, const FAgentStateValue &Value) for every key of
+// Object (not nested maps' keys), in no particular order.
+template <typename FnType>
+void ForEach(const FAgentStateObject &Object, FnType &&Fn) {
+  Detail::ForEach(Object.Root.Get(), Fn);
+}
+
+// ── Updates ──
+
+inline FAgentStateObject With(const FAgentStateObject &Object, FName Key,
+                              FAgentStateValue Value) {
+  bool bAdded = false;
+  const uint32 Hash = Detail::HashOf(Key);
+  FAgentStateObject Out;
+  Out.Root = Detail::Set(Object.Root.Get(), {Key, MoveTemp(Value)}, Hash, 0,
+                         bAdded);
+  Out.Num = Object.Num + (bAdded ? 1 : 0);
+  return Out;
+}
+
+inline FAgentStateObject Without(const FAgentStateObject &Object, FName Key) {
+  bool bRemoved = false;
+  FAgentStateObject Out;
+  Out.Root =
+      Detail::Remove(Object.Root, Key, Detail::HashOf(Key), 0, bRemoved);
+  Out.Num = Object.Num - (bRemoved ? 1 : 0);
+  return Out;
+}
+
+// Object with Value at Path, creating (or replacing non-map values with)
+// maps on the way.
+inline FAgentStateObject WithPath(const FAgentStateObject &Object,
+                                  TArrayView<const FName> Path,
+                                  FAgentStateValue Value) {
+  if (Path.Num() == 0) {
+    return Object;
+  }
+  if (Path.Num() == 1) {
+    return With(Object, Path[0], MoveTemp(Value));
+  }
+
+  const FAgentStateValue *Existing = Find(Object, Path[0]);
+  const FAgentStateObject *Child =
+      Existing ? std::get_if<FAgentStateObject>(Existing) : nullptr;
+  return With(Object, Path[0],
+              WithPath(Child ? *Child : FAgentStateObject(),
+                       Path.Slice(1, Path.Num() - 1), MoveTemp(Value)));
+}
+
+// Object without the value at Path (Object itself if there's none).
+inline FAgentStateObject WithoutPath(const FAgentStateObject &Object,
+                                     TArrayView<const FName> Path) {
+  if (Path.Num() == 0) {
+    return Object;
+  }
+  if (Path.Num() == 1) {
+    return Without(Object, Path[0]);
+  }
+
+  const FAgentStateValue *Existing = Find(Object, Path[0]);
+  const FAgentStateObject *Child =
+      Existing ? std::get_if<FAgentStateObject>(Existing) : nullptr;
+  if (!Child) {
+    return Object;
+  }
+  FAgentStateObject Changed =
+      WithoutPath(*Child, Path.Slice(1, Path.Num() - 1));
+  if (Changed.Root == Child->Root) {
+    return Object;
+  }
+  return With(Object, Path[0], MoveTemp(Changed));
+}
+
+// ── Patches ──
+
+template <typename ValueType>
+void Set(FAgentStatePatch &Patch, TArrayView<const FName> Path,
+         ValueType &&Value) {
+  FAgentStatePatch::FOp &Op = Patch.Ops.AddDefaulted_GetRef();
+  Op.Path.Append(Path.GetData(), Path.Num());
+  Op.Value = MakeValue(Forward<ValueType>(Value));
+}
+
+inline void Remove(FAgentStatePatch &Patch, TArrayView<const FName> Path) {
+  Patch.Ops.AddDefaulted_GetRef().Path.Append(Path.GetData(), Path.Num());
+}
+
+inline FAgentStateObject Apply(const FAgentStateObject &Object,
+                               const FAgentStatePatch &Patch) {
+  FAgentStateObject Out = Object;
+  for (const FAgentStatePatch::FOp &Op : Patch.Ops) {
+    Out = Op.Value.IsSet() ? WithPath(Out, Op.Path, Op.Value.GetValue())
+                           : WithoutPath(Out, Op.Path);
+  }
+  return Out;
+}
+
+// ── JSON ──
+
+using FAgentStateJsonWriter =
+    TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>;
+
+// Writes Object as a JSON object (the value of Key, if given).
+inline void WriteJson(FAgentStateJsonWriter &Writer,
+                      const FAgentStateObject &Object,
+                      const FString *Key = nullptr);
+
+// Writes Value as the field Field of the object being written.
+inline void WriteValue(FAgentStateJsonWriter &Writer, const FString &Field,
+                       const FAgentStateValue &Value) {
+  if (const bool *Bool = std::get_if<bool>(&Value)) {
+    Writer.WriteValue(Field, *Bool);
+  } else if (const double *Number = std::get_if<double>(&Value)) {
+    Writer.WriteValue(Field, *Number);
+  } else if (const FAgentStateString *String =
+                 std::get_if<FAgentStateString>(&Value)) {
+    Writer.WriteValue(Field, String->Get());
+  } else {
+    WriteJson(Writer, std::get<FAgentStateObject>(Value), &Field);
+  }
+}
+
+inline void WriteJson(FAgentStateJsonWriter &Writer,
+                      const FAgentStateObject &Object, const FString *Key) {
+  if (Key) {
+    Writer.WriteObjectStart(*Key);
+  } else {
+    Writer.WriteObjectStart();
+  }
+
+  ForEach(Object, [&Writer](FName Name, const FAgentStateValue &Value) {
+    WriteValue(Writer, Name.ToString(), Value);
+  });
+
+  Writer.WriteObjectEnd();
+}
+
+// Object as the JSON TypeFactory::AgentState reads.
+inline FString ToJson(const FAgentStateObject &Object) {
+  FString Json;
+  TSharedRef<FAgentStateJsonWriter> Writer =
+      TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(
+          &Json);
+  WriteJson(*Writer, Object);
+  Writer->Close();
+  return Json;
+}
+
+} // namespace AgentStateOps
+
+} // namespace State
+} // namespace ForbocAI
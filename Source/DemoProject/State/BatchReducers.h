@@ -0,0 +1,143 @@
+#pragma once
+
+#include "BotState.h"
+#include "CoreMinimal.h"
+#include "Reducers.h"
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS && PLATFORM_ALWAYS_HAS_AVX
+#include <immintrin.h>
+#endif
+
+namespace ForbocAI {
+namespace State {
+namespace Batch {
+
+// ── Batch Kernels ──
+// Apply one action type to N bots laid out as arrays (see FBotStateTable).
+// Each kernel has a scalar reference built on the same helper the visitor
+// uses (ApplyTick / ApplyTakeDamage) and a vector path that reproduces it
+// lane for lane: only IEEE add/sub/mul/compare, no reassociation, no FMA.
+//
+// Vector width: 8 lanes with AVX when the target guarantees it, otherwise
+// UE's 4-wide VectorRegister (SSE / NEON). Builds without vector intrinsics
+// and loop tails use the scalar reference.
+
+// ── Tick ──
+
+inline void TickScalar(int32 Begin, int32 End, uint64 *TickCounts,
+                       float *TimeSince, bool *bHasAggro, float DeltaTime,
+                       uint32 Steps = 1) {
+  for (int32 Index = Begin; Index < End; ++Index) {
+    ApplyTick(TickCounts[Index], TimeSince[Index], bHasAggro[Index],
+              DeltaTime, Steps);
+  }
+}
+
+inline void Tick(int32 Count, uint64 *TickCounts, float *TimeSince,
+                 bool *bHasAggro, float DeltaTime, uint32 Steps = 1) {
+  int32 Index = 0;
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS
+#if PLATFORM_ALWAYS_HAS_AVX
+  const __m256 Delta8 = _mm256_set1_ps(DeltaTime);
+  const __m256 Timeout8 = _mm256_set1_ps(AggroTimeout);
+  for (; Index + 8 <= Count; Index += 8) {
+    const __m256 Time =
+        _mm256_add_ps(_mm256_loadu_ps(TimeSince + Index), Delta8);
+    _mm256_storeu_ps(TimeSince + Index, Time);
+
+    int32 Expired = _mm256_movemask_ps(_mm256_cmp_ps(Time, Timeout8, _CMP_GT_OQ));
+    while (Expired) {
+      bHasAggro[Index + FMath::CountTrailingZeros(Expired)] = false;
+      Expired &= Expired - 1;
+    }
+  }
+#endif
+
+  const VectorRegister4Float Delta = VectorSetFloat1(DeltaTime);
+  const VectorRegister4Float Timeout = VectorSetFloat1(AggroTimeout);
+  for (; Index + 4 <= Count; Index += 4) {
+    const VectorRegister4Float Time =
+        VectorAdd(VectorLoad(TimeSince + Index), Delta);
+    VectorStore(Time, TimeSince + Index);
+
+    int32 Expired = VectorMaskBits(VectorCompareGT(Time, Timeout));
+    while (Expired) {
+      bHasAggro[Index + FMath::CountTrailingZeros(Expired)] = false;
+      Expired &= Expired - 1;
+    }
+  }
+
+  // Counters are integer adds; the compiler vectorizes this loop on its own.
+  for (int32 Counter = 0; Counter < Index; ++Counter) {
+    TickCounts[Counter] += Steps;
+  }
+#endif
+
+  TickScalar(Index, Count, TickCounts, TimeSince, bHasAggro, DeltaTime,
+             Steps);
+}
+
+// ── Take Damage ──
+// Rows[i] receives Amounts[i]. Rows may repeat (a bot hit twice in one
+// batch); hits on the same row are applied in array order.
+
+inline void TakeDamageScalar(int32 Begin, int32 End, const int32 *Rows,
+                             const float *Amounts, FStats *Stats,
+                             EBotPhase *Phases) {
+  for (int32 Index = Begin; Index < End; ++Index) {
+    const int32 Row = Rows[Index];
+    ApplyTakeDamage(Stats[Row].Health, Stats[Row].MaxHealth, Phases[Row],
+                    Amounts[Index]);
+  }
+}
+
+inline void TakeDamage(int32 Count, const int32 *Rows, const float *Amounts,
+                       FStats *Stats, EBotPhase *Phases) {
+  int32 Index = 0;
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS
+  const VectorRegister4Float Zero = VectorZeroFloat();
+  const VectorRegister4Float Fraction = VectorSetFloat1(FleeHealthFraction);
+
+  for (; Index + 4 <= Count; Index += 4) {
+    const int32 *Lane = Rows + Index;
+
+    // Repeated rows inside one group would lose the earlier hit when the
+    // lanes are scattered back; keep sequential semantics for that group.
+    if (Lane[0] == Lane[1] || Lane[0] == Lane[2] || Lane[0] == Lane[3] ||
+        Lane[1] == Lane[2] || Lane[1] == Lane[3] || Lane[2] == Lane[3]) {
+      TakeDamageScalar(Index, Index + 4, Rows, Amounts, Stats, Phases);
+      continue;
+    }
+
+    const VectorRegister4Float Health =
+        MakeVectorRegisterFloat(Stats[Lane[0]].Health, Stats[Lane[1]].Health,
+                                Stats[Lane[2]].Health, Stats[Lane[3]].Health);
+    const VectorRegister4Float MaxHealth = MakeVectorRegisterFloat(
+        Stats[Lane[0]].MaxHealth, Stats[Lane[1]].MaxHealth,
+        Stats[Lane[2]].MaxHealth, Stats[Lane[3]].MaxHealth);
+
+    const VectorRegister4Float Damaged =
+        VectorSubtract(Health, VectorLoad(Amounts + Index));
+    const VectorRegister4Float Clamped =
+        VectorSelect(VectorCompareGT(Damaged, Zero), Damaged, Zero);
+    const int32 Fleeing = VectorMaskBits(
+        VectorCompareLT(Clamped, VectorMultiply(MaxHealth, Fraction)));
+
+    alignas(16) float Out[4];
+    VectorStoreAligned(Clamped, Out);
+    for (int32 L = 0; L < 4; ++L) {
+      Stats[Lane[L]].Health = Out[L];
+      Phases[Lane[L]] =
+          (Fleeing & (1 << L)) ? EBotPhase::Flee : EBotPhase::Combat;
+    }
+  }
+#endif
+
+  TakeDamageScalar(Index, Count, Rows, Amounts, Stats, Phases);
+}
+
+} // namespace Batch
+} // namespace State
+} // namespace ForbocAI
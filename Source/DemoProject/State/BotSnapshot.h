@@ -0,0 +1,323 @@
+#pragma once
+
+#include "BotState.h"
+#include "BotStateTable.h"
+#include "CoreMinimal.h"
+
+namespace ForbocAI {
+namespace State {
+
+// ── Table Snapshots ──
+// A snapshot is the table's columns dumped as-is behind a fixed header:
+//
+//   FBotSnapshotHeader
+//   column 0 .. NumColumns-1, each NumRows elements, 16-byte aligned
+//
+// Columns are written in ForEachColumn order in native (little-endian)
+// layout, so loading one is a memcpy per column and a mapped file can be
+// read in place. Any change to the columns or their types bumps Version.
+// Names are not stored (FName indices are per process); loaded rows get
+// NAME_None until their bot is registered.
+//
+// An incremental snapshot holds only the rows dirtied since the previous
+// snapshot, in the same layout. The heartbeat (tick count, aggro timer)
+// changes every row every tick without dirtying it, so an incremental
+// snapshot follows the rows with a heartbeat section: those columns, plus
+// Ids to match them by, for every row of the table.
+//
+//   heartbeat column 0 .. HeartbeatColumns-1, each NumHeartbeatRows
+//   elements, 16-byte aligned
+
+struct FBotSnapshotHeader {
+  static constexpr uint32 MagicValue = 0x4E534246; // "FBSN"
+  static constexpr uint16 CurrentVersion = 2;
+  static constexpr int32 MaxColumns = 9;
+  static constexpr int32 HeartbeatColumns = 4;
+
+  enum EFlags : uint16 {
+    Incremental = 1 << 0,
+  };
+
+  uint32 Magic = MagicValue;
+  uint16 Version = CurrentVersion;
+  uint16 Flags = 0;
+  int32 NumRows = 0;
+  int32 NumColumns = MaxColumns;
+  // Rows in the heartbeat section; 0 for a full snapshot
+  int32 NumHeartbeatRows = 0;
+  int32 Reserved = 0;
+  uint64 ColumnOffsets[MaxColumns] = {};
+  uint64 HeartbeatOffsets[HeartbeatColumns] = {};
+};
+
+// The element layouts the format is written against
+static_assert(sizeof(FBotSnapshotHeader) == 128, "Snapshot header layout");
+static_assert(sizeof(FGuid) == 16 && sizeof(FVector) == 24 &&
+                  sizeof(FRotator) == 24 && sizeof(FStats) == 24 &&
+                  sizeof(EBotPhase) == 4 && sizeof(bool) == 1,
+              "Snapshot column layout changed; bump CurrentVersion");
+
+// A validated snapshot. Points into the bytes it was parsed from, which
+// must outlive it.
+struct FBotSnapshotView {
+  const FBotSnapshotHeader *Header = nullptr;
+  const uint8 *Data = nullptr;
+
+  int32 Num() const { return Header ? Header->NumRows : 0; }
+  bool IsIncremental() const {
+    return Header && (Header->Flags & FBotSnapshotHeader::Incremental);
+  }
+};
+
+namespace SnapshotOps {
+
+constexpr int32 ColumnAlignment = 16;
+
+namespace Detail {
+
+template <typename ArrayType> constexpr uint64 ElementSize(const ArrayType &) {
+  return sizeof(typename ArrayType::ElementType);
+}
+
+template <typename ArrayType>
+constexpr uint64 ElementAlignment(const ArrayType &) {
+  return alignof(typename ArrayType::ElementType);
+}
+
+// Whether Count elements of Values' type fit at Offset of Data, aligned for
+// reading in place. Overflow-safe for any Offset and Count.
+template <typename ArrayType>
+bool ColumnFits(TArrayView<const uint8> Data, uint64 Offset, int32 Count,
+                const ArrayType &Values) {
+  const uint64 Size = (uint64)Data.Num();
+  return Offset <= Size &&
+         (uint64)Count <= (Size - Offset) / ElementSize(Values) &&
+         IsAligned(Data.GetData() + Offset, ElementAlignment(Values));
+}
+
+} // namespace Detail
+
+// Calls Fn on every snapshotted column of Table, in format order.
+template <typename TableType, typename FnType>
+void ForEachColumn(TableType &Table, FnType &&Fn) {
+  Fn(Table.Ids);
+  Fn(Table.Positions);
+  Fn(Table.Rotations);
+  Fn(Table.LastKnownPlayerPositions);
+  Fn(Table.Stats);
+  Fn(Table.TimeSinceLastSeenPlayer);
+  Fn(Table.bHasAggro);
+  Fn(Table.Phases);
+  Fn(Table.TickCounts);
+}
+
+// Calls Fn on every column of the heartbeat section, Ids first.
+template <typename TableType, typename FnType>
+void ForEachHeartbeatColumn(TableType &Table, FnType &&Fn) {
+  Fn(Table.Ids);
+  Fn(Table.TimeSinceLastSeenPlayer);
+  Fn(Table.bHasAggro);
+  Fn(Table.TickCounts);
+}
+
+// Writes the table (or only its dirty rows) to Out and clears every dirty
+// flag, making this snapshot the base of the next incremental one.
+inline void Write(FBotStateTable &Table, TArray<uint8> &Out,
+                  bool bDirtyOnly = false) {
+  TArray<int32> Rows;
+  const int32 NumRows = TableOps::Num(Table);
+  if (bDirtyOnly) {
+    for (int32 Row = 0; Row < NumRows; ++Row) {
+      if (Table.Dirty[Row]) {
+        Rows.Add(Row);
+      }
+    }
+  }
+
+  FBotSnapshotHeader Header;
+  Header.Flags = bDirtyOnly ? FBotSnapshotHeader::Incremental : 0;
+  Header.NumRows = bDirtyOnly ? Rows.Num() : NumRows;
+  Header.NumHeartbeatRows = bDirtyOnly ? NumRows : 0;
+
+  // Lay the columns out first so Out is sized once
+  uint64 Size = Align(sizeof(FBotSnapshotHeader), ColumnAlignment);
+  int32 Column = 0;
+  ForEachColumn(Table, [&](const auto &Values) {
+    Header.ColumnOffsets[Column++] = Size;
+    Size = Align(Size + Detail::ElementSize(Values) * Header.NumRows,
+                 ColumnAlignment);
+  });
+  Column = 0;
+  ForEachHeartbeatColumn(Table, [&](const auto &Values) {
+    Header.HeartbeatOffsets[Column++] = Size;
+    Size = Align(Size + Detail::ElementSize(Values) * Header.NumHeartbeatRows,
+                 ColumnAlignment);
+  });
+
+  Out.Reset();
+  Out.AddZeroed((int32)Size);
+  ::FMemory::Memcpy(Out.GetData(), &Header, sizeof(Header));
+
+  Column = 0;
+  ForEachColumn(Table, [&](const auto &Values) {
+    const uint64 Stride = Detail::ElementSize(Values);
+    uint8 *Dest = Out.GetData() + Header.ColumnOffsets[Column++];
+    if (!bDirtyOnly) {
+      ::FMemory::Memcpy(Dest, Values.GetData(), Stride * NumRows);
+      return;
+    }
+    for (const int32 Row : Rows) {
+      ::FMemory::Memcpy(Dest, &Values[Row], Stride);
+      Dest += Stride;
+    }
+  });
+
+  Column = 0;
+  ForEachHeartbeatColumn(Table, [&](const auto &Values) {
+    ::FMemory::Memcpy(Out.GetData() + Header.HeartbeatOffsets[Column++],
+                      Values.GetData(),
+                      Detail::ElementSize(Values) * Header.NumHeartbeatRows);
+  });
+
+  ::FMemory::Memzero(Table.Dirty.GetData(), sizeof(bool) * NumRows);
+}
+
+// Validates Data as a snapshot this build can read. Checks the header and
+// that every column fits and is aligned for reading in place; touches none
+// of the rows.
+inline bool Parse(TArrayView<const uint8> Data, FBotSnapshotView &Out) {
+  Out = FBotSnapshotView();
+  if (Data.Num() < (int32)sizeof(FBotSnapshotHeader) ||
+      !IsAligned(Data.GetData(), alignof(FBotSnapshotHeader))) {
+    return false;
+  }
+
+  const FBotSnapshotHeader *Header =
+      reinterpret_cast<const FBotSnapshotHeader *>(Data.GetData());
+  if (Header->Magic != FBotSnapshotHeader::MagicValue ||
+      Header->Version != FBotSnapshotHeader::CurrentVersion ||
+      Header->NumColumns != FBotSnapshotHeader::MaxColumns ||
+      Header->NumRows < 0 || Header->NumHeartbeatRows < 0) {
+    return false;
+  }
+
+  const FBotStateTable Layout;
+  bool bFits = true;
+  int32 Column = 0;
+  ForEachColumn(Layout, [&](const auto &Values) {
+    bFits &= Detail::ColumnFits(Data, Header->ColumnOffsets[Column++],
+                                Header->NumRows, Values);
+  });
+  Column = 0;
+  ForEachHeartbeatColumn(Layout, [&](const auto &Values) {
+    bFits &= Detail::ColumnFits(Data, Header->HeartbeatOffsets[Column++],
+                                Header->NumHeartbeatRows, Values);
+  });
+  if (!bFits) {
+    return false;
+  }
+
+  Out.Header = Header;
+  Out.Data = Data.GetData();
+  return true;
+}
+
+// Replaces Table's contents with a full snapshot: one bulk copy per
+// column, no per-row work. Every loaded row starts clean.
+inline bool Load(FBotStateTable &Table, const FBotSnapshotView &Snapshot) {
+  if (!Snapshot.Header || Snapshot.IsIncremental()) {
+    return false;
+  }
+
+  const int32 NumRows = Snapshot.Num();
+  int32 Column = 0;
+  ForEachColumn(Table, [&](auto &Values) {
+    Values.SetNumUninitialized(NumRows, EAllowShrinking::No);
+    const uint8 *Source =
+        Snapshot.Data + Snapshot.Header->ColumnOffsets[Column++];
+    ::FMemory::Memcpy(Values.GetData(), Source,
+                      Detail::ElementSize(Values) * NumRows);
+  });
+  Table.Names.SetNumZeroed(NumRows, EAllowShrinking::No);
+  Table.Dirty.SetNumZeroed(NumRows, EAllowShrinking::No);
+  return true;
+}
+
+// Writes every snapshot row into the table row with the same Id and
+// returns how many matched; names and unmatched rows are left alone. A
+// full snapshot of the table's exact population takes the bulk-copy path.
+// An incremental snapshot's heartbeat then goes to every row it names.
+inline int32 Apply(FBotStateTable &Table, const FBotSnapshotView &Snapshot) {
+  if (!Snapshot.Header) {
+    return 0;
+  }
+
+  const int32 NumRows = Snapshot.Num();
+  const FGuid *SnapshotIds = reinterpret_cast<const FGuid *>(
+      Snapshot.Data + Snapshot.Header->ColumnOffsets[0]);
+  const bool bSameRows = NumRows == TableOps::Num(Table) &&
+                         ::FMemory::Memcmp(SnapshotIds, Table.Ids.GetData(),
+                                           sizeof(FGuid) * NumRows) == 0;
+
+  if (bSameRows) {
+    int32 Column = 0;
+    ForEachColumn(Table, [&](auto &Values) {
+      const uint8 *Source =
+          Snapshot.Data + Snapshot.Header->ColumnOffsets[Column++];
+      ::FMemory::Memcpy(Values.GetData(), Source,
+                        Detail::ElementSize(Values) * NumRows);
+    });
+    ::FMemory::Memzero(Table.Dirty.GetData(), sizeof(bool) * NumRows);
+    if (!Snapshot.IsIncremental()) {
+      return NumRows;
+    }
+  }
+
+  TMap<FGuid, int32> RowsById;
+  RowsById.Reserve(TableOps::Num(Table));
+  for (int32 Row = 0; Row < TableOps::Num(Table); ++Row) {
+    RowsById.Add(Table.Ids[Row], Row);
+  }
+
+  // Copies each of Count rows of the section at Offsets, whose first column
+  // is Ids, into the table row with the same Id; bClean marks it clean
+  auto ApplyRows = [&](const uint64 *Offsets, int32 Count, auto &&ForEach,
+                       bool bClean) {
+    const FGuid *Ids =
+        reinterpret_cast<const FGuid *>(Snapshot.Data + Offsets[0]);
+    int32 Matched = 0;
+    for (int32 Index = 0; Index < Count; ++Index) {
+      FGuid Id;
+      ::FMemory::Memcpy(&Id, Ids + Index, sizeof(FGuid));
+      const int32 *Row = RowsById.Find(Id);
+      if (!Row) {
+        continue;
+      }
+
+      int32 Column = 0;
+      ForEach(Table, [&](auto &Values) {
+        const uint64 Stride = Detail::ElementSize(Values);
+        const uint8 *Source = Snapshot.Data + Offsets[Column++];
+        ::FMemory::Memcpy(&Values[*Row], Source + Stride * Index, Stride);
+      });
+      Table.Dirty[*Row] = Table.Dirty[*Row] && !bClean;
+      ++Matched;
+    }
+    return Matched;
+  };
+
+  const int32 Applied =
+      bSameRows ? NumRows
+                : ApplyRows(
+                      Snapshot.Header->ColumnOffsets, NumRows,
+                      [](auto &T, auto &&Fn) { ForEachColumn(T, Fn); }, true);
+  ApplyRows(
+      Snapshot.Header->HeartbeatOffsets, Snapshot.Header->NumHeartbeatRows,
+      [](auto &T, auto &&Fn) { ForEachHeartbeatColumn(T, Fn); }, false);
+  return Applied;
+}
+
+} // namespace SnapshotOps
+
+} // namespace State
+} // namespace ForbocAI
@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "functional_core.hpp"
+#include <type_traits>
 
 namespace ForbocAI {
 namespace State {
@@ -28,9 +29,11 @@ enum class EBotPhase { Idle, Patrol, Combat, Flee, Search };
 
 // ── Main State ──
 
+// Plain data all the way down: the name is interned, so copying a state is a
+// memcpy and states can live in pooled or table storage without owning heap.
 struct FBotState {
   FGuid Id;
-  FString Name;
+  FName Name;
 
   FVector Position;
   FRotator Rotation;
@@ -44,16 +47,23 @@ struct FBotState {
   uint64 TickCount = 0;
 };
 
+static_assert(std::is_trivially_copyable_v<FBotState>,
+              "FBotState must stay trivially copyable");
+
 // ── Initial State Factory ──
 
-inline FBotState CreateInitialState(FString InName) {
+inline FBotState CreateInitialState(FName InName, const FGuid &InId) {
   FBotState State;
-  State.Id = FGuid::NewGuid();
+  State.Id = InId;
   State.Name = InName;
   State.Position = FVector::ZeroVector;
   State.Rotation = FRotator::ZeroRotator;
   return State;
 }
 
+inline FBotState CreateInitialState(FName InName) {
+  return CreateInitialState(InName, FGuid::NewGuid());
+}
+
 } // namespace State
 } // namespace ForbocAI
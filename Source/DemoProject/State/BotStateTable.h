@@ -0,0 +1,177 @@
+#pragma once
+
+#include "BatchReducers.h"
+#include "BotState.h"
+#include "CoreMinimal.h"
+#include "Reducers.h"
+
+namespace ForbocAI {
+namespace State {
+
+// ── State Table (Structure of Arrays) ──
+// Every registered bot owns one dense row. Fields touched on every tick live
+// in their own contiguous arrays so a batch reducer streams through memory
+// instead of calling through one closure per bot. All arrays always have the
+// same length; a row index is the bot's position in the table, which can
+// change when another row is swap-removed.
+
+struct FBotStateTable {
+  // Cold: identity and transform
+  TArray<FGuid> Ids;
+  TArray<FName> Names;
+  TArray<FVector> Positions;
+  TArray<FRotator> Rotations;
+  TArray<FVector> LastKnownPlayerPositions;
+
+  // Hot: read or written by ReduceTick / damage every frame
+  TArray<FStats> Stats;
+  TArray<float> TimeSinceLastSeenPlayer;
+  TArray<bool> bHasAggro;
+  TArray<EBotPhase> Phases;
+  TArray<uint64> TickCounts;
+
+  // Set when an action is reduced into the row (not by the per-frame
+  // heartbeat); cleared by SnapshotOps::Write
+  TArray<bool> Dirty;
+};
+
+namespace TableOps {
+
+inline int32 Num(const FBotStateTable &Table) { return Table.Ids.Num(); }
+
+inline bool IsValidRow(const FBotStateTable &Table, int32 Row) {
+  return Row >= 0 && Row < Num(Table);
+}
+
+inline void Reserve(FBotStateTable &Table, int32 Capacity) {
+  Table.Ids.Reserve(Capacity);
+  Table.Names.Reserve(Capacity);
+  Table.Positions.Reserve(Capacity);
+  Table.Rotations.Reserve(Capacity);
+  Table.LastKnownPlayerPositions.Reserve(Capacity);
+  Table.Stats.Reserve(Capacity);
+  Table.TimeSinceLastSeenPlayer.Reserve(Capacity);
+  Table.bHasAggro.Reserve(Capacity);
+  Table.Phases.Reserve(Capacity);
+  Table.TickCounts.Reserve(Capacity);
+  Table.Dirty.Reserve(Capacity);
+}
+
+// Appends a bot and returns its row.
+inline int32 AddRow(FBotStateTable &Table, const FBotState &State) {
+  Table.Ids.Add(State.Id);
+  Table.Names.Add(State.Name);
+  Table.Positions.Add(State.Position);
+  Table.Rotations.Add(State.Rotation);
+  Table.LastKnownPlayerPositions.Add(State.Memory.LastKnownPlayerPos);
+  Table.Stats.Add(State.Stats);
+  Table.TimeSinceLastSeenPlayer.Add(State.Memory.TimeSinceLastSeenPlayer);
+  Table.bHasAggro.Add(State.Memory.bHasAggro);
+  Table.Phases.Add(State.Phase);
+  Table.Dirty.Add(true);
+  return Table.TickCounts.Add(State.TickCount);
+}
+
+// Gathers one row into an existing FBotState. Never allocates.
+inline void ReadRow(const FBotStateTable &Table, int32 Row, FBotState &Out) {
+  check(IsValidRow(Table, Row));
+  Out.Id = Table.Ids[Row];
+  Out.Name = Table.Names[Row];
+  Out.Position = Table.Positions[Row];
+  Out.Rotation = Table.Rotations[Row];
+  Out.Stats = Table.Stats[Row];
+  Out.Memory.LastKnownPlayerPos = Table.LastKnownPlayerPositions[Row];
+  Out.Memory.TimeSinceLastSeenPlayer = Table.TimeSinceLastSeenPlayer[Row];
+  Out.Memory.bHasAggro = Table.bHasAggro[Row];
+  Out.Phase = Table.Phases[Row];
+  Out.TickCount = Table.TickCounts[Row];
+}
+
+// Gathers one row back into the AoS FBotState the reducers work on.
+inline FBotState ReadRow(const FBotStateTable &Table, int32 Row) {
+  FBotState State;
+  ReadRow(Table, Row, State);
+  return State;
+}
+
+// Scatters a reduced FBotState into its row and marks it dirty. Identity
+// (Id, Name) is fixed at AddRow and never written back.
+inline void WriteRow(FBotStateTable &Table, int32 Row, const FBotState &State) {
+  check(IsValidRow(Table, Row));
+  Table.Positions[Row] = State.Position;
+  Table.Rotations[Row] = State.Rotation;
+  Table.Stats[Row] = State.Stats;
+  Table.LastKnownPlayerPositions[Row] = State.Memory.LastKnownPlayerPos;
+  Table.TimeSinceLastSeenPlayer[Row] = State.Memory.TimeSinceLastSeenPlayer;
+  Table.bHasAggro[Row] = State.Memory.bHasAggro;
+  Table.Phases[Row] = State.Phase;
+  Table.TickCounts[Row] = State.TickCount;
+  Table.Dirty[Row] = true;
+}
+
+// Removes a row by moving the last row into it, so rows stay dense. Returns
+// true if a row was moved (the old last row now lives at Row).
+inline bool RemoveRowSwap(FBotStateTable &Table, int32 Row) {
+  check(IsValidRow(Table, Row));
+  const bool bMoved = Row != Num(Table) - 1;
+  Table.Ids.RemoveAtSwap(Row, 1, EAllowShrinking::No);
+  Table.Names.RemoveAtSwap(Row, 1, EAllowShrinking::No);
+  Table.Positions.RemoveAtSwap(Row, 1, EAllowShrinking::No);
+  Table.Rotations.RemoveAtSwap(Row, 1, EAllowShrinking::No);
+  Table.LastKnownPlayerPositions.RemoveAtSwap(Row, 1, EAllowShrinking::No);
+  Table.Stats.RemoveAtSwap(Row, 1, EAllowShrinking::No);
+  Table.TimeSinceLastSeenPlayer.RemoveAtSwap(Row, 1, EAllowShrinking::No);
+  Table.bHasAggro.RemoveAtSwap(Row, 1, EAllowShrinking::No);
+  Table.Phases.RemoveAtSwap(Row, 1, EAllowShrinking::No);
+  Table.TickCounts.RemoveAtSwap(Row, 1, EAllowShrinking::No);
+  Table.Dirty.RemoveAtSwap(Row, 1, EAllowShrinking::No);
+  return bMoved;
+}
+
+// Exchanges two rows in every column. Used to keep rows grouped (e.g. awake
+// bots first); the caller mirrors the swap wherever it tracks rows.
+inline void SwapRows(FBotStateTable &Table, int32 A, int32 B) {
+  check(IsValidRow(Table, A) && IsValidRow(Table, B));
+  if (A == B) {
+    return;
+  }
+  Table.Ids.Swap(A, B);
+  Table.Names.Swap(A, B);
+  Table.Positions.Swap(A, B);
+  Table.Rotations.Swap(A, B);
+  Table.LastKnownPlayerPositions.Swap(A, B);
+  Table.Stats.Swap(A, B);
+  Table.TimeSinceLastSeenPlayer.Swap(A, B);
+  Table.bHasAggro.Swap(A, B);
+  Table.Phases.Swap(A, B);
+  Table.TickCounts.Swap(A, B);
+  Table.Dirty.Swap(A, B);
+}
+
+// ── Batch Reducers ──
+
+// Applies FActionTick to every row. Equivalent to dispatching the same
+// FActionTick through Reduce() once per bot.
+inline void ReduceTick(FBotStateTable &Table, float DeltaTime) {
+  Batch::Tick(Num(Table), Table.TickCounts.GetData(),
+              Table.TimeSinceLastSeenPlayer.GetData(),
+              Table.bHasAggro.GetData(), DeltaTime);
+}
+
+// Applies FActionTakeDamage{Amounts[i]} to Rows[i]. Equivalent to
+// dispatching each hit through Reduce() in array order.
+inline void ReduceTakeDamage(FBotStateTable &Table,
+                             TArrayView<const int32> Rows,
+                             TArrayView<const float> Amounts) {
+  check(Rows.Num() == Amounts.Num());
+  Batch::TakeDamage(Rows.Num(), Rows.GetData(), Amounts.GetData(),
+                    Table.Stats.GetData(), Table.Phases.GetData());
+  for (const int32 Row : Rows) {
+    Table.Dirty[Row] = true;
+  }
+}
+
+} // namespace TableOps
+
+} // namespace State
+} // namespace ForbocAI
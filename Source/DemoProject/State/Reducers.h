@@ -3,85 +3,183 @@
 #include "Actions.h"
 #include "BotState.h"
 #include "Core/functional_core.hpp"
+#include <array>
 
 namespace ForbocAI {
 namespace State {
 
-// ── Reducer Helpers ──
+// ── Tick Kernel ──
 
-// Handler for specific actions (Overload pattern)
-// We use a struct with operator() because C++ templated lambdas in std::visit
-// can be verbose.
+// Seconds without sighting the player before a bot drops aggro.
+constexpr float AggroTimeout = 10.0f;
 
-struct ReducerVisitor {
-  const FBotState &CurrentState;
+// The heartbeat step on raw fields. Shared by the per-bot visitor and the
+// batch table reducer so both paths produce bit-identical results.
+inline void ApplyTick(uint64 &TickCount, float &TimeSinceLastSeenPlayer,
+                      bool &bHasAggro, float DeltaTime, uint32 Steps = 1) {
+  TickCount += Steps;
 
-  // 1. Tick
-  FBotState operator()(const FActionTick &Action) const {
-    FBotState Next = CurrentState;
-    Next.TickCount++;
+  // Memory Decay
+  TimeSinceLastSeenPlayer += DeltaTime;
+  if (TimeSinceLastSeenPlayer > AggroTimeout) {
+    bHasAggro = false; // Lost aggro
+  }
+}
 
-    // Memory Decay
-    Next.Memory.TimeSinceLastSeenPlayer += Action.DeltaTime;
-    if (Next.Memory.TimeSinceLastSeenPlayer > 10.0f) {
-      Next.Memory.bHasAggro = false; // Lost aggro
-    }
+// Health fraction under which a damaged bot flees instead of fighting.
+constexpr float FleeHealthFraction = 0.3f;
 
-    return Next;
-  }
+// The damage step on raw fields. Written as a plain compare/select so the
+// SIMD batch kernel can reproduce it lane for lane (also clamps NaN to 0).
+inline void ApplyTakeDamage(float &Health, float MaxHealth, EBotPhase &Phase,
+                            float Amount) {
+  const float Damaged = Health - Amount;
+  Health = Damaged > 0.0f ? Damaged : 0.0f;
 
-  // 2. Move
-  FBotState operator()(const FActionMove &Action) const {
-    FBotState Next = CurrentState;
-    // In a pure reducer, we just update the *intent* or physical state if we
-    // are the authority. Here we assume the Actuator will actually move the
-    // pawn, and we update our internal record. Or, if this is the "Brain"
-    // state, we might just set a "Goal" field. For this example, let's assume
-    // we update Position to Target for simulation (or interpolation).
-    Next.Position = Action.TargetLocation;
-    return Next;
-  }
+  // Reaction: If hit, enter combat or flee
+  Phase = Health < MaxHealth * FleeHealthFraction ? EBotPhase::Flee
+                                                  : EBotPhase::Combat;
+}
 
-  // 3. Take Damage
-  FBotState operator()(const FActionTakeDamage &Action) const {
-    FBotState Next = CurrentState;
-    Next.Stats.Health = FMath::Max(0.0f, Next.Stats.Health - Action.Amount);
-
-    // Reaction: If hit, enter combat or flee
-    if (Next.Stats.Health < Next.Stats.MaxHealth * 0.3f) {
-      Next.Phase = EBotPhase::Flee;
-    } else {
-      Next.Phase = EBotPhase::Combat;
-    }
-    return Next;
-  }
+// ── Action Handlers ──
+
+// One overload per action type, each writing straight into the state it is
+// given. Copying is left to the caller: Reduce() copies once up front to
+// stay pure, while stores that own their state reduce in place and never
+// touch the heap.
+//
+// There is deliberately no catch-all overload: an action type without a
+// handler is a build error below, not a silent no-op.
+
+// 1. Tick
+inline void ReduceAction(FBotState &Next, const FActionTick &Action) {
+  ApplyTick(Next.TickCount, Next.Memory.TimeSinceLastSeenPlayer,
+            Next.Memory.bHasAggro, Action.DeltaTime, Action.Steps);
+}
+
+// 2. Move
+inline void ReduceAction(FBotState &Next, const FActionMove &Action) {
+  // In a pure reducer, we just update the *intent* or physical state if we
+  // are the authority. Here we assume the Actuator will actually move the
+  // pawn, and we update our internal record. Or, if this is the "Brain"
+  // state, we might just set a "Goal" field. For this example, let's assume
+  // we update Position to Target for simulation (or interpolation).
+  Next.Position = Action.TargetLocation;
+}
+
+// 3. Take Damage
+inline void ReduceAction(FBotState &Next, const FActionTakeDamage &Action) {
+  ApplyTakeDamage(Next.Stats.Health, Next.Stats.MaxHealth, Next.Phase,
+                  Action.Amount);
+}
 
-  // 4. Spot Enemy
-  FBotState operator()(const FActionSpotEnemy &Action) const {
-    FBotState Next = CurrentState;
-    Next.Memory.LastKnownPlayerPos = Action.EnemyLocation;
-    Next.Memory.TimeSinceLastSeenPlayer = 0.0f;
-    Next.Memory.bHasAggro = true;
-
-    if (Next.Phase != EBotPhase::Flee) {
-      Next.Phase = EBotPhase::Combat;
-    }
-    return Next;
+// 4. Spot Enemy
+inline void ReduceAction(FBotState &Next, const FActionSpotEnemy &Action) {
+  Next.Memory.LastKnownPlayerPos = Action.EnemyLocation;
+  Next.Memory.TimeSinceLastSeenPlayer = 0.0f;
+  Next.Memory.bHasAggro = true;
+
+  if (Next.Phase != EBotPhase::Flee) {
+    Next.Phase = EBotPhase::Combat;
   }
+}
+
+// 5. Attack / Flee: carried out by the actuator, no state change yet
+inline void ReduceAction(FBotState &, const FActionAttack &) {}
+inline void ReduceAction(FBotState &, const FActionFlee &) {}
+
+// ── Dispatch Table ──
+// Generated from FBotActionList: entry I reduces the variant's I-th type,
+// so dispatch is one indexed call instead of std::visit.
+
+namespace Detail {
+
+template <typename ActionType, typename = void>
+struct THasHandler : std::false_type {};
+
+template <typename ActionType>
+struct THasHandler<ActionType,
+                   std::void_t<decltype(ReduceAction(
+                       std::declval<FBotState &>(),
+                       std::declval<const ActionType &>()))>>
+    : std::true_type {};
+
+template <typename ActionType> constexpr bool RequireHandler() {
+  static_assert(THasHandler<ActionType>::value,
+                "FBotActionList has an action without a ReduceAction "
+                "overload");
+  return true;
+}
+
+template <typename... ActionTypes>
+constexpr bool AllHandled(TActionList<ActionTypes...>) {
+  return (RequireHandler<ActionTypes>() && ...);
+}
+
+static_assert(AllHandled(FBotActionList{}));
+
+using FReduceFn = void (*)(FBotState &, const FBotAction &);
+
+template <typename ActionType>
+void ReduceEntry(FBotState &State, const FBotAction &Action) {
+  ReduceAction(State, *std::get_if<ActionType>(&Action));
+}
+
+template <typename... ActionTypes>
+constexpr std::array<FReduceFn, sizeof...(ActionTypes)>
+MakeDispatchTable(TActionList<ActionTypes...>) {
+  return {&ReduceEntry<ActionTypes>...};
+}
+
+inline constexpr auto DispatchTable = MakeDispatchTable(FBotActionList{});
+
+} // namespace Detail
 
-  // 5. Default / Others
-  template <typename T> FBotState operator()(const T &Action) const {
-    return CurrentState; // No change for unhandled actions
+// std::visit form of ReduceInPlace. Same handlers; kept as the reference
+// the dispatch benchmark measures the table against.
+struct ReducerVisitor {
+  FBotState &Next;
+
+  template <typename ActionType>
+  void operator()(const ActionType &Action) const {
+    ReduceAction(Next, Action);
   }
 };
 
-// ── Main Reducer Function ──
+// ── Main Reducer Functions ──
+
+// Reduces into State itself. Same result as State = Reduce(State, Action),
+// minus the copy.
+inline void ReduceInPlace(FBotState &State, const FBotAction &Action) {
+  Detail::DispatchTable[Action.index()](State, Action);
+}
 
 inline FBotState Reduce(const FBotState &State, const FBotAction &Action) {
-  // We visit the action variant with our visitor.
-  // The visitor MUST implement operator() for every type in the variant,
-  // OR have a generic template operator().
-  return std::visit(ReducerVisitor{State}, Action);
+  FBotState Next = State;
+  ReduceInPlace(Next, Action);
+  return Next;
+}
+
+// ── Typed Batch Dispatch ──
+// For streams already split by action type: no variant and no per-action
+// dispatch, just the handler in a loop the compiler can inline.
+
+// Reduces every action into one state, in order.
+template <typename ActionType>
+void ReduceBatch(FBotState &State, TArrayView<const ActionType> Actions) {
+  for (const ActionType &Action : Actions) {
+    ReduceAction(State, Action);
+  }
+}
+
+// Reduces Actions[i] into States[i].
+template <typename ActionType>
+void ReduceBatch(TArrayView<FBotState> States,
+                 TArrayView<const ActionType> Actions) {
+  check(States.Num() == Actions.Num());
+  for (int32 Index = 0; Index < States.Num(); ++Index) {
+    ReduceAction(States[Index], Actions[Index]);
+  }
 }
 
 } // namespace State
@@ -0,0 +1,174 @@
+#include "DemoProject/Bot/ActionHandlers.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+
+using namespace ForbocAI;
+
+DEFINE_SPEC(FActionHandlersSpec, "ForbocAI.Bot.ActionHandlers",
+            EAutomationTestFlags::ProductFilter |
+                EAutomationTestFlags::ApplicationContextMask)
+
+namespace {
+
+constexpr int32 NumTypes = 64;
+
+FString TypeName(int32 Index) {
+  return FString::Printf(TEXT("ACTION_%02d"), Index);
+}
+
+// NumTypes designer types, each a FLEE away from its own index
+void RegisterMany(Bot::FActionHandlerTable &Table) {
+  for (int32 Index = 0; Index < NumTypes; ++Index) {
+    Bot::ActionHandlerOps::Register(
+        Table, FName(*TypeName(Index)),
+        [Index](const Bot::FActionArgs &, const Bot::FActionSubject &,
+                State::FBotAction &Out) {
+          Out = State::FActionFlee{FVector((double)Index, 0.0, 0.0)};
+          return true;
+        });
+  }
+}
+
+Bot::FParsedAction ParseType(const FString &Type) {
+  FAgentAction Action;
+  Action.Type = Type;
+  return Bot::ActionHandlerOps::Parse(Action);
+}
+
+} // namespace
+
+void FActionHandlersSpec::Define() {
+  Describe("Defaults", [this]() {
+    It("Should move ahead, or to the payload location", [this]() {
+      Bot::FActionHandlerTable Table;
+      Bot::ActionHandlerOps::RegisterDefaults(Table);
+      Bot::FActionSubject Subject;
+      Subject.Location = FVector(10.0, 20.0, 0.0);
+
+      State::FBotAction Out;
+      TestTrue("Built", Bot::ActionHandlerOps::Build(
+                            Table, ParseType(TEXT("move")), Subject, Out));
+      const State::FActionMove *Move = std::get_if<State::FActionMove>(&Out);
+      if (!TestNotNull("Move", Move)) {
+        return;
+      }
+      TestEqual("Ahead", Move->TargetLocation, FVector(510.0, 20.0, 0.0));
+      TestEqual("Default speed", Move->Speed, 100.0f);
+
+      Bot::FParsedAction Aimed = ParseType(TEXT("MOVE"));
+      Aimed.Args.Location = FVector(1.0, 2.0, 3.0);
+      Aimed.Args.Speed = 40.0f;
+      Bot::ActionHandlerOps::Build(Table, Aimed, Subject, Out);
+      Move = std::get_if<State::FActionMove>(&Out);
+      TestTrue("To payload", Move && Move->TargetLocation ==
+                                         FVector(1.0, 2.0, 3.0) &&
+                                 Move->Speed == 40.0f);
+
+      TestTrue("Attack", Bot::ActionHandlerOps::Build(
+                             Table, ParseType(TEXT("ATTACK")), Subject, Out) &&
+                             std::holds_alternative<State::FActionAttack>(Out));
+      TestEqual("Built count", Table.Stats.Built, (uint64)3);
+    });
+
+    It("Should count unhandled types instead of dropping them", [this]() {
+      Bot::FActionHandlerTable Table;
+      Bot::ActionHandlerOps::RegisterDefaults(Table);
+      State::FBotAction Out;
+      // A name something already interned, and two no one ever did
+      const FName Dance(TEXT("DANCE"));
+      const FString Never = FGuid::NewGuid().ToString();
+      const FString Nor = FGuid::NewGuid().ToString();
+      for (const FString &Type : {FString(TEXT("DANCE")),
+                                  FString(TEXT("dance")), Never, Nor}) {
+        TestFalse(Type, Bot::ActionHandlerOps::Build(Table, ParseType(Type),
+                                                     {}, Out));
+      }
+
+      TestEqual("Unhandled", Table.Stats.Unhandled, (uint64)4);
+      TestEqual("Per type", Table.Unhandled.FindRef(Dance), (uint64)2);
+      TestEqual("Unknown", Table.Unhandled.FindRef(
+                               Bot::ActionHandlerOps::UnknownType()),
+                (uint64)2);
+      TestEqual("Keys", Table.Unhandled.Num(), 2);
+      TestTrue("Not interned",
+               FName(*Never, FNAME_Find).IsNone() &&
+                   FName(*Nor, FNAME_Find).IsNone());
+    });
+  });
+
+  Describe("Payload", [this]() {
+    It("Should read the optional target and payload fields", [this]() {
+      TSharedRef<FJsonObject> Json = MakeShared<FJsonObject>();
+      Json->SetStringField(TEXT("target"), TEXT("Player"));
+      TSharedRef<FJsonObject> Payload = MakeShared<FJsonObject>();
+      Payload->SetArrayField(
+          TEXT("location"),
+          {MakeShared<FJsonValueNumber>(1.0), MakeShared<FJsonValueNumber>(2.0),
+           MakeShared<FJsonValueNumber>(3.0)});
+      Payload->SetNumberField(TEXT("speed"), 75.0);
+      Json->SetObjectField(TEXT("payload"), Payload);
+
+      const Bot::FActionArgs Args = Bot::ActionHandlerOps::ParseArgs(*Json);
+      TestEqual("Target", Args.Target, FString(TEXT("Player")));
+      TestEqual("Location", Args.Location.Get(FVector::ZeroVector),
+                FVector(1.0, 2.0, 3.0));
+      TestEqual("Speed", Args.Speed.Get(0.0f), 75.0f);
+
+      Payload->SetArrayField(TEXT("location"),
+                             {MakeShared<FJsonValueNumber>(1.0)});
+      TestFalse("Short location ignored",
+                Bot::ActionHandlerOps::ParseArgs(*Json).Location.IsSet());
+    });
+  });
+
+  Describe("Performance", [this]() {
+    It("Should report lookup cost with dozens of types registered", [this]() {
+      Bot::FActionHandlerTable Table;
+      RegisterMany(Table);
+
+      TArray<FString> Registered;
+      for (int32 Index = 0; Index < NumTypes; ++Index) {
+        Registered.Add(TypeName(Index));
+      }
+      TArray<FString> TypeNames;
+      TArray<Bot::FParsedAction> Actions;
+      FRandomStream Random(NumTypes);
+      for (int32 Index = 0; Index < 200000; ++Index) {
+        TypeNames.Add(Registered[Random.RandHelper(NumTypes)]);
+        Actions.Add(ParseType(TypeNames.Last()));
+      }
+
+      // The chain of string compares this table replaces
+      int32 Matched = 0;
+      double Start = FPlatformTime::Seconds();
+      for (const FString &Type : TypeNames) {
+        for (const FString &Candidate : Registered) {
+          if (Type == Candidate) {
+            ++Matched;
+            break;
+          }
+        }
+      }
+      const double ChainNs =
+          (FPlatformTime::Seconds() - Start) * 1e9 / TypeNames.Num();
+
+      State::FBotAction Out;
+      double Sum = 0.0;
+      Start = FPlatformTime::Seconds();
+      for (const Bot::FParsedAction &Action : Actions) {
+        Bot::ActionHandlerOps::Build(Table, Action, {}, Out);
+        Sum += std::get<State::FActionFlee>(Out).AwayFrom.X;
+      }
+      const double TableNs =
+          (FPlatformTime::Seconds() - Start) * 1e9 / Actions.Num();
+
+      TestEqual("Every type found", Matched, TypeNames.Num());
+      TestEqual("Every action built", Table.Stats.Built,
+                (uint64)Actions.Num());
+      AddInfo(FString::Printf(
+          TEXT("%d types: string compares %.1f ns, table %.1f ns per action "
+               "(checksum %.0f)"),
+          NumTypes, ChainNs, TableNs, Sum));
+    });
+  });
+}
@@ -0,0 +1,312 @@
+#include "DemoProject/State/ActionJournal.h"
+#include "DemoProject/State/Actions.h"
+#include "DemoProject/State/BotState.h"
+#include "DemoProject/State/Reducers.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+using namespace ForbocAI;
+
+DEFINE_SPEC(FActionJournalSpec, "ForbocAI.State.Journal",
+            EAutomationTestFlags::ProductFilter |
+                EAutomationTestFlags::ApplicationContextMask)
+
+namespace {
+
+State::FBotAction RandomAction(FRandomStream &Random) {
+  switch (Random.RandRange(0, 5)) {
+  case 0: {
+    State::FActionTick Tick;
+    Tick.DeltaTime = Random.FRandRange(0.0f, 0.2f);
+    return Tick;
+  }
+  case 1:
+    return State::FActionMove{FVector(Random.FRandRange(-1e4f, 1e4f),
+                                      Random.FRandRange(-1e4f, 1e4f), 0.0f),
+                              100.0f};
+  case 2:
+    return State::FActionTakeDamage{Random.FRandRange(0.0f, 15.0f), nullptr};
+  case 3:
+    return State::FActionSpotEnemy{FVector(1.0f, 2.0f, 3.0f)};
+  case 4:
+    return State::FActionAttack{nullptr};
+  default:
+    return State::FActionFlee{FVector(3.0f, 2.0f, 1.0f)};
+  }
+}
+
+// Records Count random actions; Live[i] is the state after i of them.
+State::FActionJournal RecordSession(int32 Count,
+                                    TArray<State::FBotState> &Live) {
+  FRandomStream Random(Count);
+  State::FBotState Bot = State::CreateInitialState(TEXT("Journaled"));
+  State::FActionJournal Journal;
+  State::JournalOps::Begin(Journal, Bot, 64);
+
+  Live.Reset();
+  Live.Add(Bot);
+  for (int32 Index = 0; Index < Count; ++Index) {
+    const State::FBotAction Action = RandomAction(Random);
+    State::ReduceInPlace(Bot, Action);
+    State::JournalOps::Record(Journal, Action, Bot);
+    Live.Add(Bot);
+  }
+  return Journal;
+}
+
+// Bots sharing one heartbeat log the way ABotOrchestrator runs them: tier 0
+// ticks every frame, tier 1 every fourth, and bots now and then take an
+// action or change tier. Keyframed and trimmed every 50 frames.
+struct FTieredSession {
+  TSharedPtr<State::FHeartbeatLog> Log = MakeShared<State::FHeartbeatLog>();
+  TArray<State::FBotState> Live;
+  TArray<State::FActionJournal> Journals;
+  TArray<int32> Tiers;
+  int32 MaxLogPasses = 0;
+  int32 MaxBytes = 0;
+
+  FTieredSession(int32 NumBots, int32 MaxKeyframes) {
+    for (int32 Bot = 0; Bot < NumBots; ++Bot) {
+      Live.Add(State::CreateInitialState(TEXT("Tiered")));
+      State::FActionJournal &Journal = Journals.AddDefaulted_GetRef();
+      State::JournalOps::Begin(Journal, Live[Bot], 16, Log);
+      Journal.MaxKeyframes = MaxKeyframes;
+      Tiers.Add(Bot % 2);
+      State::JournalOps::RecordTier(Journal, Tiers[Bot]);
+    }
+  }
+
+  void Run(int32 Frames) {
+    FRandomStream Random(Frames);
+    State::FActionTick Slow{0.0f, 0};
+    for (int32 Frame = 1; Frame <= Frames; ++Frame) {
+      for (int32 Bot = 0; Bot < Live.Num(); ++Bot) {
+        if (Random.RandRange(0, 9) == 0) {
+          Dispatch(Bot, RandomAction(Random));
+        }
+      }
+
+      const State::FActionTick Fast{0.016f};
+      State::JournalOps::AppendPass(*Log, 0, Fast);
+      Slow.DeltaTime += Fast.DeltaTime;
+      Slow.Steps += Fast.Steps;
+      const bool bSlowPass = Frame % 4 == 0;
+      if (bSlowPass) {
+        State::JournalOps::AppendPass(*Log, 1, Slow);
+      }
+      for (int32 Bot = 0; Bot < Live.Num(); ++Bot) {
+        if (Tiers[Bot] == 0) {
+          State::ReduceInPlace(Live[Bot], Fast);
+        } else if (bSlowPass) {
+          State::ReduceInPlace(Live[Bot], Slow);
+        }
+      }
+      if (bSlowPass) {
+        Slow = State::FActionTick{0.0f, 0};
+        const int32 Bot = Random.RandRange(0, Live.Num() - 1);
+        Tiers[Bot] = 1 - Tiers[Bot];
+        State::JournalOps::RecordTier(Journals[Bot], Tiers[Bot]);
+      }
+
+      if (Frame % 50 == 0) {
+        uint64 Oldest = State::JournalOps::PassEnd(Log.Get());
+        for (int32 Bot = 0; Bot < Live.Num(); ++Bot) {
+          State::JournalOps::AddKeyframe(Journals[Bot], Live[Bot]);
+          Oldest = FMath::Min(Oldest,
+                              State::JournalOps::OldestPass(Journals[Bot]));
+        }
+        State::JournalOps::TrimLog(*Log, Oldest);
+      }
+      for (const State::FActionJournal &Journal : Journals) {
+        MaxBytes = FMath::Max(MaxBytes, Journal.Bytes.Num());
+      }
+      MaxLogPasses = FMath::Max(MaxLogPasses, Log->Passes.Num());
+    }
+  }
+
+  void Dispatch(int32 Bot, const State::FBotAction &Action) {
+    State::ReduceInPlace(Live[Bot], Action);
+    State::JournalOps::Record(Journals[Bot], Action, Live[Bot]);
+  }
+
+  State::FBotState Replay(const State::FActionJournal &Journal) const {
+    State::FBotState Bot = Journal.Initial;
+    State::JournalOps::ForEach(Journal, [&Bot](const State::FBotAction &A) {
+      State::ReduceInPlace(Bot, A);
+    });
+    return Bot;
+  }
+};
+
+bool SameState(const State::FBotState &A, const State::FBotState &B) {
+  return A.Id == B.Id && A.Position == B.Position &&
+         A.Stats.Health == B.Stats.Health && A.Phase == B.Phase &&
+         A.Memory.TimeSinceLastSeenPlayer ==
+             B.Memory.TimeSinceLastSeenPlayer &&
+         A.Memory.bHasAggro == B.Memory.bHasAggro &&
+         A.TickCount == B.TickCount;
+}
+
+} // namespace
+
+void FActionJournalSpec::Define() {
+  Describe("Replay", [this]() {
+    It("Should rebuild the state after every entry", [this]() {
+      TArray<State::FBotState> Live;
+      const State::FActionJournal Journal = RecordSession(1000, Live);
+
+      TestEqual("Entries", State::JournalOps::Num(Journal), 1000);
+      for (int32 Entry = 0; Entry <= 1000; ++Entry) {
+        if (!TestTrue("Replayed",
+                      SameState(State::JournalOps::StateAtEntry(Journal, Entry),
+                                Live[Entry]))) {
+          return;
+        }
+      }
+    });
+
+    It("Should seek by tick", [this]() {
+      TArray<State::FBotState> Live;
+      const State::FActionJournal Journal = RecordSession(1000, Live);
+
+      // Expected: the latest live state that hadn't ticked past Tick
+      int32 Entry = 0;
+      for (uint64 Tick = 0; Tick <= Live.Last().TickCount; ++Tick) {
+        while (Entry + 1 < Live.Num() && Live[Entry + 1].TickCount <= Tick) {
+          ++Entry;
+        }
+        if (!TestTrue("At tick",
+                      SameState(State::JournalOps::StateAtTick(Journal, Tick),
+                                Live[Entry]))) {
+          return;
+        }
+      }
+    });
+  });
+
+  Describe("Heartbeat log", [this]() {
+    It("Should merge the shared tier passes into replay", [this]() {
+      FTieredSession Session(4, 0);
+      Session.Run(2000);
+
+      for (int32 Bot = 0; Bot < Session.Live.Num(); ++Bot) {
+        TestTrue("Replayed", SameState(Session.Replay(Session.Journals[Bot]),
+                                       Session.Live[Bot]));
+        TestEqual("Initial", Session.Journals[Bot].Initial.TickCount,
+                  (uint64)0);
+      }
+    });
+
+    It("Should bound the journals and the log", [this]() {
+      FTieredSession Short(4, 4);
+      Short.Run(1000);
+      FTieredSession Long(4, 4);
+      Long.Run(10000);
+
+      for (int32 Bot = 0; Bot < Long.Live.Num(); ++Bot) {
+        TestTrue("Keyframes", Long.Journals[Bot].Keyframes.Num() <= 4);
+        TestTrue("Replayed",
+                 SameState(Long.Replay(Long.Journals[Bot]), Long.Live[Bot]));
+      }
+      TestTrue("Bytes", Long.MaxBytes <= 2 * Short.MaxBytes);
+      TestTrue("Log", Long.MaxLogPasses <= 2 * Short.MaxLogPasses);
+
+      TArray<uint8> Bytes;
+      State::JournalOps::Save(Long.Journals[0], Bytes);
+      State::FActionJournal Loaded;
+      TestTrue("Loads", State::JournalOps::Load(Bytes, Loaded));
+      TestTrue("Standalone",
+               SameState(Long.Replay(Loaded), Long.Live[0]));
+    });
+  });
+
+  Describe("Files", [this]() {
+    It("Should round-trip through Save/Load", [this]() {
+      TArray<State::FBotState> Live;
+      const State::FActionJournal Journal = RecordSession(500, Live);
+
+      TArray<uint8> Bytes;
+      State::JournalOps::Save(Journal, Bytes);
+
+      State::FActionJournal Loaded;
+      TestTrue("Loads", State::JournalOps::Load(Bytes, Loaded));
+      TestEqual("Entries", State::JournalOps::Num(Loaded), 500);
+      TestEqual("Keyframes", Loaded.Keyframes.Num(), Journal.Keyframes.Num());
+      TestTrue("Name", Loaded.Initial.Name == Journal.Initial.Name);
+      TestTrue("Final state",
+               SameState(State::JournalOps::StateAtEntry(Loaded, 500),
+                         Live.Last()));
+
+      TestFalse("Truncated", State::JournalOps::Load(
+                                 TArrayView<const uint8>(Bytes).LeftChop(2),
+                                 Loaded));
+    });
+
+    It("Should store every field of the initial state", [this]() {
+      State::FBotState Bot = State::CreateInitialState(TEXT("Fields"));
+      Bot.Rotation = FRotator(10.0, 20.0, 30.0);
+      Bot.Stats.Mana = 12.0f;
+      Bot.Stats.MaxStamina = 80.0f;
+      Bot.Memory.LastKnownPlayerPos = FVector(4.0, 5.0, 6.0);
+      Bot.Memory.bHasAggro = true;
+      Bot.Phase = State::EBotPhase::Search;
+      Bot.TickCount = 1234;
+
+      State::FActionJournal Journal;
+      State::JournalOps::Begin(Journal, Bot);
+      TArray<uint8> Bytes;
+      State::JournalOps::Save(Journal, Bytes);
+
+      State::FActionJournal Loaded;
+      if (!TestTrue("Loads", State::JournalOps::Load(Bytes, Loaded))) {
+        return;
+      }
+      const State::FBotState &Read = Loaded.Initial;
+      TestTrue("Same", SameState(Read, Bot));
+      TestTrue("Rotation", Read.Rotation == Bot.Rotation);
+      TestEqual("Mana", Read.Stats.Mana, Bot.Stats.Mana);
+      TestEqual("MaxStamina", Read.Stats.MaxStamina, Bot.Stats.MaxStamina);
+      TestTrue("Last seen", Read.Memory.LastKnownPlayerPos ==
+                                Bot.Memory.LastKnownPlayerPos);
+    });
+  });
+
+  Describe("Performance", [this]() {
+    It("Should report reducer throughput on recorded traffic", [this]() {
+      // Drop a journal saved by ABotOrchestrator::SaveBotJournal here to
+      // bench on real traffic; otherwise a synthetic session is used.
+      const FString Path = FPaths::ProjectSavedDir() /
+                           TEXT("ForbocAI/ReplayBenchmark.journal");
+      State::FActionJournal Journal;
+      TArray<uint8> Bytes;
+      TArray<State::FBotState> Live;
+      if (!FFileHelper::LoadFileToArray(Bytes, *Path, FILEREAD_Silent) ||
+          !State::JournalOps::Load(Bytes, Journal)) {
+        Journal = RecordSession(100000, Live);
+      }
+
+      TArray<State::FBotAction> Actions;
+      Actions.Reserve(State::JournalOps::Num(Journal));
+      State::JournalOps::ForEach(
+          Journal,
+          [&Actions](const State::FBotAction &Action) { Actions.Add(Action); });
+
+      const double Start = FPlatformTime::Seconds();
+      State::FBotState Bot = Journal.Initial;
+      for (const State::FBotAction &Action : Actions) {
+        State::ReduceInPlace(Bot, Action);
+      }
+      const double Seconds = FPlatformTime::Seconds() - Start;
+
+      TestTrue("Replays to the end",
+               SameState(Bot, State::JournalOps::StateAtEntry(
+                                  Journal, State::JournalOps::Num(Journal))));
+      AddInfo(FString::Printf(
+          TEXT("%d recorded actions (%d bytes): %.1f M reductions/s"),
+          Actions.Num(), Journal.Bytes.Num(),
+          Actions.Num() / FMath::Max(Seconds, 1e-9) / 1e6));
+    });
+  });
+}
@@ -0,0 +1,97 @@
+#include "Async/ParallelFor.h"
+#include "DemoProject/Bot/ActionQueue.h"
+#include "DemoProject/State/Actions.h"
+#include "Misc/AutomationTest.h"
+
+using namespace ForbocAI;
+
+DEFINE_SPEC(FActionQueueSpec, "ForbocAI.Bot.ActionQueue",
+            EAutomationTestFlags::ProductFilter |
+                EAutomationTestFlags::ApplicationContextMask)
+
+void FActionQueueSpec::Define() {
+  // Stand-in handles; the queue never resolves them
+  const Bot::FBotHandle BotA = {0, 1};
+  const Bot::FBotHandle BotB = {1, 1};
+
+  Describe("Drain", [this, BotA, BotB]() {
+    It("Should preserve enqueue order", [this, BotA, BotB]() {
+      Bot::FBotActionQueue Queue;
+      State::FActionMove Move;
+      Move.TargetLocation = FVector(1, 0, 0);
+      Move.Speed = 1.0f;
+      State::FActionSpotEnemy Spot;
+      Spot.EnemyLocation = FVector::ZeroVector;
+
+      Queue.Enqueue({BotA, Move});
+      Queue.Enqueue({BotB, Spot});
+      Queue.Enqueue({BotA, Spot});
+
+      TArray<Bot::FQueuedBotAction> Out;
+      TestEqual("Drained", Bot::QueueOps::Drain(Queue, Out, true), 3);
+      TestTrue("0 is A/Move", Out[0].Bot == BotA &&
+                                  std::holds_alternative<State::FActionMove>(
+                                      Out[0].Action));
+      TestTrue("1 is B/Spot", Out[1].Bot == BotB);
+      TestTrue("2 is A/Spot", Out[2].Bot == BotA &&
+                                  std::holds_alternative<
+                                      State::FActionSpotEnemy>(Out[2].Action));
+      TestTrue("Queue empty", Queue.IsEmpty());
+    });
+
+    It("Should coalesce consecutive ticks for the same bot", [this, BotA,
+                                                              BotB]() {
+      Bot::FBotActionQueue Queue;
+      State::FActionTick Tick;
+      Tick.DeltaTime = 0.25f;
+
+      Queue.Enqueue({BotA, Tick});
+      Queue.Enqueue({BotA, Tick});
+      Queue.Enqueue({BotA, Tick});
+      Queue.Enqueue({BotB, Tick});
+      Queue.Enqueue({BotA, Tick});
+
+      TArray<Bot::FQueuedBotAction> Out;
+      TestEqual("Drained", Bot::QueueOps::Drain(Queue, Out, true), 3);
+
+      const State::FActionTick &Merged =
+          std::get<State::FActionTick>(Out[0].Action);
+      TestEqual("Merged DeltaTime", Merged.DeltaTime, 0.75f);
+      TestEqual("Merged Steps", Merged.Steps, (uint32)3);
+      TestEqual("B keeps its own tick",
+                std::get<State::FActionTick>(Out[1].Action).Steps, (uint32)1);
+    });
+
+    It("Should not coalesce when disabled", [this, BotA]() {
+      Bot::FBotActionQueue Queue;
+      State::FActionTick Tick;
+      Tick.DeltaTime = 0.25f;
+      Queue.Enqueue({BotA, Tick});
+      Queue.Enqueue({BotA, Tick});
+
+      TArray<Bot::FQueuedBotAction> Out;
+      TestEqual("Drained", Bot::QueueOps::Drain(Queue, Out, false), 2);
+    });
+  });
+
+  Describe("Producers", [this, BotA]() {
+    It("Should accept actions from many threads at once", [this, BotA]() {
+      constexpr int32 Producers = 8;
+      constexpr int32 PerProducer = 1000;
+
+      Bot::FBotActionQueue Queue;
+      ParallelFor(Producers, [&Queue, BotA](int32 Producer) {
+        State::FActionTakeDamage Damage;
+        Damage.Source = nullptr;
+        for (int32 Index = 0; Index < PerProducer; ++Index) {
+          Damage.Amount = (float)Producer;
+          Queue.Enqueue({BotA, Damage});
+        }
+      });
+
+      TArray<Bot::FQueuedBotAction> Out;
+      TestEqual("Drained", Bot::QueueOps::Drain(Queue, Out, true),
+                Producers * PerProducer);
+    });
+  });
+}
@@ -0,0 +1,164 @@
+#include "DemoProject/Bot/AgentBatch.h"
+#include "DemoProject/Tests/StubHttpServer.h"
+#include "Dom/JsonObject.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+using namespace ForbocAI;
+
+DEFINE_SPEC(FAgentBatchSpec, "ForbocAI.Bot.AgentBatch",
+            EAutomationTestFlags::ProductFilter |
+                EAutomationTestFlags::ApplicationContextMask)
+
+namespace {
+
+TArray<Bot::FAgentBatchItem> MakeItems(int32 Count) {
+  TArray<Bot::FAgentBatchItem> Items;
+  for (int32 Index = 0; Index < Count; ++Index) {
+    Bot::FAgentBatchItem &Item = Items.AddDefaulted_GetRef();
+    Item.Bot = {Index, 1};
+    Item.AgentId = FString::Printf(TEXT("agent-%d"), Index);
+    Item.Persona = TEXT("Guard");
+    Item.Observation = FString::Printf(TEXT("Health: %d"), Index);
+  }
+  return Items;
+}
+
+// Answers every request entry with a MOVE, agentIds echoed in order
+FString EchoBatch(const FString &RequestBody) {
+  TSharedPtr<FJsonObject> Root;
+  const TArray<TSharedPtr<FJsonValue>> *Requests = nullptr;
+  if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(RequestBody),
+                                    Root) ||
+      !Root->TryGetArrayField(TEXT("requests"), Requests)) {
+    return FString();
+  }
+
+  FString Body = TEXT("{\"responses\":[");
+  for (int32 Index = 0; Index < Requests->Num(); ++Index) {
+    const FString AgentId =
+        (*Requests)[Index]->AsObject()->GetStringField(TEXT("agentId"));
+    Body += FString::Printf(
+        TEXT("%s{\"agentId\":\"%s\",\"dialogue\":\"ok\","
+             "\"action\":{\"type\":\"MOVE\"}}"),
+        Index > 0 ? TEXT(",") : TEXT(""), *AgentId);
+  }
+  return Body + TEXT("]}");
+}
+
+} // namespace
+
+void FAgentBatchSpec::Define() {
+  Describe("Wire format", [this]() {
+    It("Should parse a response aligned with the request", [this]() {
+      const TArray<Bot::FAgentBatchItem> Items = MakeItems(3);
+      const FString Body = Bot::AgentBatchOps::BuildRequestBody(Items);
+      TestTrue("Has every agent", Body.Contains(TEXT("agent-2")));
+
+      TArray<FAgentResponse> Responses;
+      TestTrue("Parsed", Bot::AgentBatchOps::ParseResponseBody(
+                             EchoBatch(Body), Items, Responses));
+      TestEqual("One response per item", Responses.Num(), 3);
+      TestEqual("Action", Responses[1].Action.Type, FString(TEXT("MOVE")));
+    });
+
+    It("Should parse action arguments alongside the responses", [this]() {
+      // Types are looked up, not interned; a handler would have done that
+      const FName Move(TEXT("MOVE"));
+      const TArray<Bot::FAgentBatchItem> Items = MakeItems(2);
+      TArray<FAgentResponse> Responses;
+      TArray<Bot::FParsedAction> Actions;
+      TestTrue("Parsed",
+               Bot::AgentBatchOps::ParseResponseBody(
+                   TEXT("{\"responses\":[{\"agentId\":\"agent-0\","
+                        "\"action\":{\"type\":\"MOVE\",\"payload\":"
+                        "{\"location\":[1,2,3],\"speed\":250}}},"
+                        "{\"agentId\":\"agent-1\"}]}"),
+                   Items, Responses, &Actions));
+      if (!TestEqual("One action per item", Actions.Num(), 2)) {
+        return;
+      }
+      TestEqual("Type", Actions[0].Type, Move);
+      TestEqual("Location", Actions[0].Args.Location.Get(FVector::ZeroVector),
+                FVector(1.0, 2.0, 3.0));
+      TestEqual("Speed", Actions[0].Args.Speed.Get(0.0f), 250.0f);
+      TestTrue("No action", Actions[1].Type.IsNone());
+    });
+
+    It("Should reject a response that doesn't line up", [this]() {
+      const TArray<Bot::FAgentBatchItem> Items = MakeItems(2);
+      TArray<FAgentResponse> Responses;
+
+      TestFalse("Short", Bot::AgentBatchOps::ParseResponseBody(
+                             EchoBatch(Bot::AgentBatchOps::BuildRequestBody(
+                                 MakeItems(1))),
+                             Items, Responses));
+      TestFalse("Reordered",
+                Bot::AgentBatchOps::ParseResponseBody(
+                    TEXT("{\"responses\":[{\"agentId\":\"agent-1\"},"
+                         "{\"agentId\":\"agent-0\"}]}"),
+                    Items, Responses));
+      TestFalse("Garbage", Bot::AgentBatchOps::ParseResponseBody(
+                               TEXT("not json"), Items, Responses));
+    });
+  });
+
+#if WITH_FORBOCAI_STUB_SERVER
+  Describe("Stub server", [this]() {
+    LatentIt("Should resolve a whole batch in one round trip",
+             FTimespan::FromSeconds(10),
+             [this](const FDoneDelegate &Done) {
+               const FName Move(TEXT("MOVE"));
+               TSharedRef<Tests::FStubHttpServer> Server =
+                   MakeShared<Tests::FStubHttpServer>();
+               if (!Server->Start(TEXT("/agents/process/batch"), &EchoBatch)) {
+                 AddError(TEXT("Could not bind stub route"));
+                 Done.Execute();
+                 return;
+               }
+
+               Bot::AgentBatchOps::Send(
+                   Server->BaseUrl() + TEXT("/agents/process/batch"),
+                   MakeItems(16),
+                   [this, Server, Move,
+                    Done](bool bOk, const TArray<Bot::FAgentBatchItem> &,
+                          TArray<FAgentResponse> Responses,
+                          TArray<Bot::FParsedAction> Actions) {
+                     TestTrue("Batch ok", bOk);
+                     TestTrue("On the game thread", IsInGameThread());
+                     TestEqual("Responses", Responses.Num(), 16);
+                     TestEqual("Actions", Actions.Num(), 16);
+                     TestTrue("Parsed",
+                              Actions.Num() > 0 && Actions[0].Type == Move);
+                     TestEqual("Round trips", Server->NumRequests, 1);
+                     Done.Execute();
+                   });
+             });
+
+    LatentIt("Should report failure so callers can fall back",
+             FTimespan::FromSeconds(10),
+             [this](const FDoneDelegate &Done) {
+               TSharedRef<Tests::FStubHttpServer> Server =
+                   MakeShared<Tests::FStubHttpServer>();
+               Server->Start(TEXT("/agents/process/batch"),
+                             [](const FString &) { return FString(); });
+
+               Bot::AgentBatchOps::Send(
+                   Server->BaseUrl() + TEXT("/agents/process/batch"),
+                   MakeItems(4),
+                   [this, Server, Done](bool bOk,
+                                        const TArray<Bot::FAgentBatchItem>
+                                            &Items,
+                                        TArray<FAgentResponse> Responses,
+                                        TArray<Bot::FParsedAction> Actions) {
+                     TestFalse("Batch failed", bOk);
+                     TestEqual("Items handed back", Items.Num(), 4);
+                     TestEqual("No responses", Responses.Num(), 0);
+                     TestEqual("No actions", Actions.Num(), 0);
+                     Done.Execute();
+                   });
+             });
+  });
+#endif
+}
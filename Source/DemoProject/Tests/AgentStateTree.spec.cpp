@@ -0,0 +1,246 @@
+#include "AgentModule.h"
+#include "DemoProject/State/AgentStateTree.h"
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+using namespace ForbocAI;
+
+DEFINE_SPEC(FAgentStateTreeSpec, "ForbocAI.State.AgentState",
+            EAutomationTestFlags::ProductFilter |
+                EAutomationTestFlags::ApplicationContextMask)
+
+namespace {
+
+namespace StateOps = State::AgentStateOps;
+
+FName MemoryName(int32 Index) {
+  return FName(*FString::Printf(TEXT("memory-%d"), Index));
+}
+
+// An agent state with Count memories of about 200 characters each
+State::FAgentStateObject WithMemories(int32 Count) {
+  State::FAgentStateObject Memories;
+  for (int32 Index = 0; Index < Count; ++Index) {
+    Memories = StateOps::With(
+        Memories, MemoryName(Index),
+        StateOps::MakeValue(FString::Printf(
+            TEXT("Saw the player near the %d-th crate, carrying %s"), Index,
+            *FString::ChrN(150, TEXT('x')))));
+  }
+
+  State::FAgentStatePatch Patch;
+  StateOps::Set(Patch, {TEXT("description")}, TEXT("Guarding the gate"));
+  StateOps::Set(Patch, {TEXT("memories")}, Memories);
+  return StateOps::Apply({}, Patch);
+}
+
+void CollectNodes(const State::FAgentStateObject &Object,
+                  TSet<const State::FAgentStateNode *> &Out);
+
+void CollectNodes(const State::FAgentStateNode *Node,
+                  TSet<const State::FAgentStateNode *> &Out) {
+  if (!Node) {
+    return;
+  }
+  Out.Add(Node);
+  for (const State::FAgentStateEntry &Entry : Node->Entries) {
+    if (const State::FAgentStateObject *Child =
+            std::get_if<State::FAgentStateObject>(&Entry.Value)) {
+      CollectNodes(*Child, Out);
+    }
+  }
+  for (const State::FAgentStateNodePtr &Child : Node->Nodes) {
+    CollectNodes(Child.Get(), Out);
+  }
+}
+
+void CollectNodes(const State::FAgentStateObject &Object,
+                  TSet<const State::FAgentStateNode *> &Out) {
+  CollectNodes(Object.Root.Get(), Out);
+}
+
+// Bytes of the nodes in After that Before doesn't share
+SIZE_T NewBytes(const State::FAgentStateObject &Before,
+                const State::FAgentStateObject &After) {
+  TSet<const State::FAgentStateNode *> Old;
+  TSet<const State::FAgentStateNode *> New;
+  CollectNodes(Before, Old);
+  CollectNodes(After, New);
+
+  SIZE_T Bytes = 0;
+  for (const State::FAgentStateNode *Node : New) {
+    if (!Old.Contains(Node)) {
+      Bytes += sizeof(*Node) + Node->Entries.GetAllocatedSize() +
+               Node->Nodes.GetAllocatedSize();
+    }
+  }
+  return Bytes;
+}
+
+} // namespace
+
+void FAgentStateTreeSpec::Define() {
+  Describe("Updates", [this]() {
+    It("Should find what was set, through nested maps", [this]() {
+      State::FAgentStatePatch Patch;
+      StateOps::Set(Patch, {TEXT("mood")}, TEXT("calm"));
+      StateOps::Set(Patch, {TEXT("stats"), TEXT("hp")}, 42);
+      StateOps::Set(Patch, {TEXT("stats"), TEXT("aggro")}, true);
+      const State::FAgentStateObject Agent = StateOps::Apply({}, Patch);
+
+      const FString *Mood = StateOps::FindString(Agent, {TEXT("MOOD")});
+      TestTrue("Case-insensitive", Mood && *Mood == TEXT("calm"));
+      const double *Hp = StateOps::FindNumber(Agent, {TEXT("stats"),
+                                                      TEXT("hp")});
+      TestTrue("Nested number", Hp && *Hp == 42.0);
+      const bool *Aggro =
+          StateOps::FindBool(Agent, {TEXT("stats"), TEXT("aggro")});
+      TestTrue("Nested bool", Aggro && *Aggro);
+      TestEqual("Keys", Agent.Num, 2);
+      TestNull("Wrong type", StateOps::FindNumber(Agent, {TEXT("mood")}));
+
+      State::FAgentStatePatch Remove;
+      StateOps::Remove(Remove, {TEXT("stats"), TEXT("hp")});
+      StateOps::Remove(Remove, {TEXT("missing")});
+      const State::FAgentStateObject Removed = StateOps::Apply(Agent, Remove);
+      TestNull("Removed", StateOps::Find(Removed, {TEXT("stats"), TEXT("hp")}));
+      TestNotNull("Old version untouched",
+                  StateOps::Find(Agent, {TEXT("stats"), TEXT("hp")}));
+    });
+
+    It("Should keep every key through many inserts and removals", [this]() {
+      constexpr int32 Count = 20000;
+      State::FAgentStateObject Object;
+      for (int32 Index = 0; Index < Count; ++Index) {
+        Object = StateOps::With(Object, MemoryName(Index),
+                                StateOps::MakeValue(Index));
+      }
+      TestEqual("Inserted", Object.Num, Count);
+
+      for (int32 Index = 0; Index < Count; Index += 2) {
+        Object = StateOps::Without(Object, MemoryName(Index));
+      }
+      TestEqual("Half removed", Object.Num, Count / 2);
+      for (int32 Index = 0; Index < Count; ++Index) {
+        const State::FAgentStateValue *Value =
+            StateOps::Find(Object, MemoryName(Index));
+        const double *Number = Value ? std::get_if<double>(Value) : nullptr;
+        const bool bExpected = Index % 2 == 1;
+        if (!TestTrue("Present", (Value != nullptr) == bExpected) ||
+            (bExpected && !TestTrue("Value", *Number == Index))) {
+          return;
+        }
+      }
+
+      for (int32 Index = 1; Index < Count; Index += 2) {
+        Object = StateOps::Without(Object, MemoryName(Index));
+      }
+      TestEqual("Empty", Object.Num, 0);
+      TestFalse("No nodes left", Object.Root.IsValid());
+    });
+
+    It("Should only allocate the changed path", [this]() {
+      const State::FAgentStateObject Agent = WithMemories(10000);
+
+      State::FAgentStatePatch Patch;
+      StateOps::Set(Patch, {TEXT("memories"), MemoryName(1234)},
+                    TEXT("Forgot about the crate"));
+      const State::FAgentStateObject Changed = StateOps::Apply(Agent, Patch);
+
+      TSet<const State::FAgentStateNode *> Old;
+      TSet<const State::FAgentStateNode *> New;
+      CollectNodes(Agent, Old);
+      CollectNodes(Changed, New);
+      int32 Fresh = 0;
+      for (const State::FAgentStateNode *Node : New) {
+        Fresh += Old.Contains(Node) ? 0 : 1;
+      }
+
+      // The root, then the memory map's root and one node per level
+      TestTrue("Path only", Fresh <= 5);
+      TestEqual("Same nodes otherwise", New.Num(), Old.Num());
+      const FString *Memory = StateOps::FindString(
+          Agent, {TEXT("memories"), MemoryName(1234)});
+      TestTrue("Old version untouched",
+               Memory && Memory->StartsWith(TEXT("Saw the player")));
+    });
+  });
+
+  Describe("JSON", [this]() {
+    It("Should escape what it writes", [this]() {
+      const FString Tricky = TEXT("He said \"halt\"\\\n{\"x\": 1}");
+      State::FAgentStatePatch Patch;
+      StateOps::Set(Patch, {TEXT("description")}, Tricky);
+      StateOps::Set(Patch, {TEXT("stats"), TEXT("hp")}, 7);
+      const FString Json = StateOps::ToJson(StateOps::Apply({}, Patch));
+
+      TSharedPtr<FJsonObject> Root;
+      if (!TestTrue("Valid JSON",
+                    FJsonSerializer::Deserialize(
+                        TJsonReaderFactory<>::Create(Json), Root) &&
+                        Root.IsValid())) {
+        return;
+      }
+      TestEqual("Round trip", Root->GetStringField(TEXT("description")),
+                Tricky);
+      const TSharedPtr<FJsonObject> *Stats = nullptr;
+      TestTrue("Nested", Root->TryGetObjectField(TEXT("stats"), Stats) &&
+                             (*Stats)->GetNumberField(TEXT("hp")) == 7.0);
+    });
+  });
+
+  Describe("Performance", [this]() {
+    It("Should report update cost with a large memory set", [this]() {
+      constexpr int32 Memories = 10000;
+      constexpr int32 Updates = 200;
+      State::FAgentStateObject Tree = WithMemories(Memories);
+
+      // Before: the whole state rebuilt as JSON and handed to WithState on
+      // every change
+      FAgentConfig Config;
+      Config.Persona = TEXT("Guard");
+      Config.ApiUrl = TEXT("http://localhost");
+      TSharedPtr<const FAgent> Agent =
+          MakeShared<const FAgent>(AgentFactory::Create(Config));
+      SIZE_T RebuildBytes = 0;
+      double Start = FPlatformTime::Seconds();
+      for (int32 Update = 0; Update < Updates; ++Update) {
+        const FString Json = StateOps::ToJson(Tree);
+        RebuildBytes += Json.GetAllocatedSize();
+        Agent = MakeShared<const FAgent>(
+            AgentOps::WithState(*Agent, TypeFactory::AgentState(Json)));
+      }
+      const double RebuildUs =
+          (FPlatformTime::Seconds() - Start) * 1e6 / Updates;
+
+      // After: a patch per change, sharing the rest of the tree
+      SIZE_T PatchBytes = 0;
+      double PatchSeconds = 0.0;
+      for (int32 Update = 0; Update < Updates; ++Update) {
+        State::FAgentStatePatch Patch;
+        StateOps::Set(Patch, {TEXT("mood")},
+                      Update % 2 ? TEXT("calm") : TEXT("alert"));
+        StateOps::Set(Patch, {TEXT("memories"), MemoryName(Update)},
+                      TEXT("Updated"));
+        Start = FPlatformTime::Seconds();
+        const State::FAgentStateObject Next = StateOps::Apply(Tree, Patch);
+        PatchSeconds += FPlatformTime::Seconds() - Start;
+        PatchBytes += NewBytes(Tree, Next);
+        Tree = Next;
+      }
+      const double PatchUs = PatchSeconds * 1e6 / Updates;
+
+      TestEqual("Memories kept",
+                StateOps::FindObject(Tree, {TEXT("memories")})->Num,
+                Memories);
+      AddInfo(FString::Printf(
+          TEXT("%d memories: JSON + WithState %.1f us, %llu bytes of JSON; "
+               "patch %.2f us, %llu new bytes per update"),
+          Memories, RebuildUs, (uint64)(RebuildBytes / Updates), PatchUs,
+          (uint64)(PatchBytes / Updates)));
+    });
+  });
+}
@@ -0,0 +1,125 @@
+#include "DemoProject/State/Actions.h"
+#include "DemoProject/State/BatchReducers.h"
+#include "DemoProject/State/BotState.h"
+#include "DemoProject/State/BotStateTable.h"
+#include "DemoProject/State/Reducers.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+
+using namespace ForbocAI;
+
+DEFINE_SPEC(FBatchReducersSpec, "ForbocAI.State.BatchReducers",
+            EAutomationTestFlags::ProductFilter |
+                EAutomationTestFlags::ApplicationContextMask)
+
+namespace {
+
+State::FBotState MakeRandomBot(FRandomStream &Random) {
+  State::FBotState Bot = State::CreateInitialState(TEXT("Fuzz"));
+  Bot.Stats.MaxHealth = Random.FRandRange(1.0f, 200.0f);
+  Bot.Stats.Health = Random.FRandRange(0.0f, Bot.Stats.MaxHealth);
+  Bot.Memory.TimeSinceLastSeenPlayer = Random.FRandRange(0.0f, 15.0f);
+  Bot.Memory.bHasAggro = Random.RandRange(0, 1) == 1;
+  Bot.Phase = (State::EBotPhase)Random.RandRange(0, 4);
+  Bot.TickCount = Random.RandRange(0, 1 << 20);
+  return Bot;
+}
+
+bool BitEqual(float A, float B) { return FMemory::Memcmp(&A, &B, 4) == 0; }
+
+} // namespace
+
+void FBatchReducersSpec::Define() {
+  Describe("Fuzz against scalar Reduce", [this]() {
+    It("Should match tick and damage bit for bit", [this]() {
+      FRandomStream Random(0xF0B0C);
+
+      for (int32 Round = 0; Round < 64; ++Round) {
+        // Odd sizes exercise the vector body and the scalar tail together
+        const int32 Count = Random.RandRange(1, 300);
+
+        State::FBotStateTable Table;
+        TArray<State::FBotState> Reference;
+        for (int32 Index = 0; Index < Count; ++Index) {
+          Reference.Add(MakeRandomBot(Random));
+          State::TableOps::AddRow(Table, Reference.Last());
+        }
+
+        State::FActionTick Tick;
+        Tick.DeltaTime = Random.FRandRange(0.0f, 3.0f);
+        State::TableOps::ReduceTick(Table, Tick.DeltaTime);
+        for (State::FBotState &Bot : Reference) {
+          Bot = State::Reduce(Bot, Tick);
+        }
+
+        // Hits land on random rows, including repeats
+        TArray<int32> Rows;
+        TArray<float> Amounts;
+        const int32 Hits = Random.RandRange(0, Count * 2);
+        for (int32 Hit = 0; Hit < Hits; ++Hit) {
+          Rows.Add(Random.RandRange(0, Count - 1));
+          Amounts.Add(Random.FRandRange(-5.0f, 60.0f));
+        }
+        State::TableOps::ReduceTakeDamage(Table, Rows, Amounts);
+        for (int32 Hit = 0; Hit < Hits; ++Hit) {
+          State::FActionTakeDamage Damage;
+          Damage.Amount = Amounts[Hit];
+          Damage.Source = nullptr;
+          Reference[Rows[Hit]] = State::Reduce(Reference[Rows[Hit]], Damage);
+        }
+
+        for (int32 Row = 0; Row < Count; ++Row) {
+          const State::FBotState &Expected = Reference[Row];
+          const bool bMatch =
+              BitEqual(Table.TimeSinceLastSeenPlayer[Row],
+                       Expected.Memory.TimeSinceLastSeenPlayer) &&
+              BitEqual(Table.Stats[Row].Health, Expected.Stats.Health) &&
+              Table.bHasAggro[Row] == Expected.Memory.bHasAggro &&
+              Table.Phases[Row] == Expected.Phase &&
+              Table.TickCounts[Row] == Expected.TickCount;
+          if (!bMatch) {
+            AddError(FString::Printf(TEXT("Round %d row %d diverged"), Round,
+                                     Row));
+            return;
+          }
+        }
+      }
+    });
+  });
+
+  Describe("Throughput", [this]() {
+    It("Should reduce 10k bots well inside a frame", [this]() {
+      constexpr int32 Count = 10000;
+      constexpr int32 Frames = 200;
+      constexpr double TargetMs = 0.1;
+
+      FRandomStream Random(7);
+      State::FBotStateTable Table;
+      State::TableOps::Reserve(Table, Count);
+      for (int32 Index = 0; Index < Count; ++Index) {
+        State::TableOps::AddRow(Table, MakeRandomBot(Random));
+      }
+
+      TArray<int32> Rows;
+      TArray<float> Amounts;
+      for (int32 Hit = 0; Hit < Count; ++Hit) {
+        Rows.Add(Hit);
+        Amounts.Add(0.001f);
+      }
+
+      const double Start = FPlatformTime::Seconds();
+      for (int32 Frame = 0; Frame < Frames; ++Frame) {
+        State::TableOps::ReduceTick(Table, 1.0f / 60.0f);
+        State::TableOps::ReduceTakeDamage(Table, Rows, Amounts);
+      }
+      const double PerFrameMs =
+          (FPlatformTime::Seconds() - Start) * 1000.0 / Frames;
+
+      AddInfo(FString::Printf(TEXT("%d bots: %.4f ms per frame (tick+damage)"),
+                              Count, PerFrameMs));
+      if (PerFrameMs > TargetMs) {
+        AddWarning(FString::Printf(TEXT("Above %.2f ms target"), TargetMs));
+      }
+    });
+  });
+}
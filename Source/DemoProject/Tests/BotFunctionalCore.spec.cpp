@@ -3,9 +3,77 @@
 #include "DemoProject/State/Actions.h"
 #include "DemoProject/State/Reducers.h"
 #include "DemoProject/Bot/Factories/BotFactory.h"
+#include "DemoProject/State/BotStateTable.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformTLS.h"
+#include <atomic>
 
 using namespace ForbocAI;
 
+namespace
+{
+    // Forwards to the real allocator and counts Malloc/Realloc calls made by
+    // the installing thread, so background threads don't skew the result.
+    class FCountingMalloc final : public FMalloc
+    {
+    public:
+        explicit FCountingMalloc(FMalloc* InInner)
+            : Inner(InInner), OwnerThread(FPlatformTLS::GetCurrentThreadId())
+        {
+        }
+
+        virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+        {
+            Record();
+            return Inner->Malloc(Count, Alignment);
+        }
+
+        virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+        {
+            Record();
+            return Inner->Realloc(Original, Count, Alignment);
+        }
+
+        virtual void Free(void* Original) override { Inner->Free(Original); }
+
+        virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override
+        {
+            return Inner->GetAllocationSize(Original, SizeOut);
+        }
+
+        virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+
+        virtual const TCHAR* GetDescriptiveName() override { return TEXT("CountingMalloc"); }
+
+        int32 Num() const { return Allocations.load(); }
+
+    private:
+        void Record()
+        {
+            if (FPlatformTLS::GetCurrentThreadId() == OwnerThread)
+            {
+                Allocations++;
+            }
+        }
+
+        FMalloc* Inner;
+        uint32 OwnerThread;
+        std::atomic<int32> Allocations{0};
+    };
+
+    // Swaps GMalloc for a counter for the lifetime of the scope.
+    struct FScopedAllocationCounter
+    {
+        FMalloc* Previous;
+        FCountingMalloc Counter;
+
+        FScopedAllocationCounter() : Previous(GMalloc), Counter(GMalloc) { GMalloc = &Counter; }
+        ~FScopedAllocationCounter() { GMalloc = Previous; }
+
+        int32 Num() const { return Counter.Num(); }
+    };
+}
+
 DEFINE_SPEC(FBotFunctionalCoreSpec, "ForbocAI.Bot.FunctionalCore", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
 
 void FBotFunctionalCoreSpec::Define()
@@ -17,7 +85,7 @@ void FBotFunctionalCoreSpec::Define()
             auto Store = Bot::Factory::CreateBotStore(TEXT("TestBot"));
             State::FBotState State = Store.GetState();
 
-            TestEqual("Name", State.Name, TEXT("TestBot"));
+            TestEqual("Name", State.Name.ToString(), TEXT("TestBot"));
             TestEqual("Health", State.Stats.Health, 100.0f);
             TestEqual("Phase", State.Phase, State::EBotPhase::Idle);
             TestTrue("ID is valid", State.Id.IsValid());
@@ -139,4 +207,64 @@ void FBotFunctionalCoreSpec::Define()
             });
         });
     });
+
+    Describe("Allocation", [this]()
+    {
+        It("Should dispatch FActionTick without heap allocations", [this]()
+        {
+            auto Store = Bot::Factory::CreateBotStore(TEXT("Frugal"));
+
+            State::FActionTick Tick;
+            Tick.DeltaTime = 0.016f;
+
+            int32 Allocations = 0;
+            {
+                FScopedAllocationCounter Counter;
+                for (int32 Frame = 0; Frame < 100; ++Frame)
+                {
+                    Store.Dispatch(Tick);
+                }
+                const State::FBotState& Read = Store.GetState();
+                Allocations = Counter.Num();
+                TestEqual("TickCount", Read.TickCount, (uint64)100);
+            }
+
+            TestEqual("Heap allocations", Allocations, 0);
+        });
+
+        It("Should dispatch through a table view without heap allocations", [this]()
+        {
+            auto Table = std::make_shared<State::FBotStateTable>();
+            const int32 Row = State::TableOps::AddRow(*Table, State::CreateInitialState(TEXT("Viewed")));
+            auto Store = Bot::Factory::CreateBotStoreView(Table, Row);
+
+            State::FActionTick Tick;
+            Tick.DeltaTime = 0.016f;
+
+            int32 Allocations = 0;
+            {
+                FScopedAllocationCounter Counter;
+                for (int32 Frame = 0; Frame < 100; ++Frame)
+                {
+                    Store.Dispatch(Tick);
+                }
+                Allocations = Counter.Num();
+            }
+
+            TestEqual("Heap allocations", Allocations, 0);
+            TestEqual("Row TickCount", Table->TickCounts[Row], (uint64)100);
+        });
+
+        It("Should keep Reduce pure", [this]()
+        {
+            const State::FBotState Before = State::CreateInitialState(TEXT("Pure"));
+
+            State::FActionTakeDamage Damage;
+            Damage.Amount = 10.0f;
+            const State::FBotState After = State::Reduce(Before, Damage);
+
+            TestEqual("Input untouched", Before.Stats.Health, 100.0f);
+            TestEqual("Output reduced", After.Stats.Health, 90.0f);
+        });
+    });
 }
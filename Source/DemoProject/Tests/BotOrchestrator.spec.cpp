@@ -20,16 +20,190 @@ void FBotOrchestratorSpec::Define() {
       ABotOrchestrator *Orchestrator = World->SpawnActor<ABotOrchestrator>();
 
       Orchestrator->RegisterBot(TestActor, TEXT("TestPersona"));
-
-      // Verification would involve checking internal ActiveBots map,
-      // but it's private. We'd need to expose it for testing or
-      // check for logged output/side effects.
+      TestTrue("Registered", Orchestrator->FindBot(TestActor).IsSet());
 
       TestActor->Destroy();
+      TestFalse("Dropped on destroy",
+                Orchestrator->FindBot(TestActor).IsSet());
+      Orchestrator->Destroy();
+    });
+
+    It("Should keep the other bots reachable after unregistering", [this]() {
+      UWorld *World = GEngine->GetWorldContexts()[0].World();
+      if (!World)
+        return;
+
+      ABotOrchestrator *Orchestrator = World->SpawnActor<ABotOrchestrator>();
+      AActor *First = World->SpawnActor<AActor>();
+      AActor *Second = World->SpawnActor<AActor>();
+      Orchestrator->RegisterBot(First, TEXT("TestPersona"));
+      Orchestrator->RegisterBot(Second, TEXT("TestPersona"));
+
+      const ForbocAI::Bot::FBotHandle FirstHandle =
+          Orchestrator->FindBot(First);
+      const ForbocAI::Bot::FBotHandle SecondHandle =
+          Orchestrator->FindBot(Second);
+
+      // Second is swapped into First's row; its handle must not change
+      Orchestrator->UnregisterBot(First);
+      TestFalse("First gone", Orchestrator->FindBot(First).IsSet());
+      TestTrue("Second unchanged",
+               Orchestrator->FindBot(Second) == SecondHandle);
+
+      // A re-registration must not revive the old handle
+      Orchestrator->RegisterBot(First, TEXT("TestPersona"));
+      TestTrue("New handle", Orchestrator->FindBot(First) != FirstHandle);
+
+      First->Destroy();
+      Second->Destroy();
+      Orchestrator->Destroy();
+    });
+
+    It("Should keep bots registered before BeginPlay scheduled", [this]() {
+      UWorld *World = GEngine->GetWorldContexts()[0].World();
+      if (!World)
+        return;
+
+      ABotOrchestrator *Orchestrator =
+          World->SpawnActorDeferred<ABotOrchestrator>(
+              ABotOrchestrator::StaticClass(), FTransform::Identity);
+      AActor *Early = World->SpawnActor<AActor>();
+      Orchestrator->RegisterBot(Early, TEXT("TestPersona"));
+      TestEqual("Scheduled", Orchestrator->GetScheduledBotCount(), 1);
+
+      Orchestrator->FinishSpawning(FTransform::Identity);
+      if (!Orchestrator->HasActorBegunPlay()) {
+        Orchestrator->DispatchBeginPlay();
+      }
+      TestTrue("Began play", Orchestrator->HasActorBegunPlay());
+      TestTrue("Still registered", Orchestrator->FindBot(Early).IsSet());
+      TestEqual("Still scheduled", Orchestrator->GetScheduledBotCount(), 1);
+
+      Early->Destroy();
       Orchestrator->Destroy();
     });
   });
 
+  Describe("Bulk Registration", [this]() {
+    It("Should register a whole wave when unbudgeted", [this]() {
+      UWorld *World = GEngine->GetWorldContexts()[0].World();
+      if (!World)
+        return;
+
+      ABotOrchestrator *Orchestrator = World->SpawnActor<ABotOrchestrator>();
+      Orchestrator->MaxSpawnMillisecondsPerFrame = 0.0f;
+
+      TArray<AActor *> Wave;
+      for (int32 Index = 0; Index < 200; ++Index) {
+        Wave.Add(World->SpawnActor<AActor>());
+      }
+      Orchestrator->RegisterBots(Wave, TEXT("TestPersona"));
+
+      TestEqual("Nothing pending", Orchestrator->GetPendingSpawnCount(), 0);
+      for (AActor *Actor : Wave) {
+        TestTrue("Registered", Orchestrator->FindBot(Actor).IsSet());
+        Actor->Destroy();
+      }
+      Orchestrator->Destroy();
+    });
+
+    It("Should stream a wave that doesn't fit the budget", [this]() {
+      UWorld *World = GEngine->GetWorldContexts()[0].World();
+      if (!World)
+        return;
+
+      ABotOrchestrator *Orchestrator = World->SpawnActor<ABotOrchestrator>();
+      Orchestrator->SpawnBatchSize = 10;
+      Orchestrator->MaxSpawnMillisecondsPerFrame = 1e-6f;
+
+      TArray<AActor *> Wave;
+      for (int32 Index = 0; Index < 50; ++Index) {
+        Wave.Add(World->SpawnActor<AActor>());
+      }
+      Orchestrator->RegisterBots(Wave, TEXT("TestPersona"));
+
+      // One batch per call once the budget is spent
+      TestEqual("First batch only", Orchestrator->GetPendingSpawnCount(), 40);
+      TestTrue("Head registered", Orchestrator->FindBot(Wave[0]).IsSet());
+      TestFalse("Tail waiting", Orchestrator->FindBot(Wave.Last()).IsSet());
+
+      for (AActor *Actor : Wave) {
+        Actor->Destroy();
+      }
+      Orchestrator->Destroy();
+    });
+
+    It("Should drop a waiting actor from the wave on unregister", [this]() {
+      UWorld *World = GEngine->GetWorldContexts()[0].World();
+      if (!World)
+        return;
+
+      ABotOrchestrator *Orchestrator = World->SpawnActor<ABotOrchestrator>();
+      Orchestrator->SpawnBatchSize = 10;
+      Orchestrator->MaxSpawnMillisecondsPerFrame = 1e-6f;
+
+      TArray<AActor *> Wave;
+      for (int32 Index = 0; Index < 50; ++Index) {
+        Wave.Add(World->SpawnActor<AActor>());
+      }
+      Orchestrator->RegisterBots(Wave, TEXT("TestPersona"));
+
+      Orchestrator->UnregisterBot(Wave.Last());
+      TestEqual("Left the wave", Orchestrator->GetPendingSpawnCount(), 39);
+
+      // Drain the rest of the wave unbudgeted
+      Orchestrator->MaxSpawnMillisecondsPerFrame = 0.0f;
+      Orchestrator->RegisterBots({}, TEXT("TestPersona"));
+      TestEqual("Wave done", Orchestrator->GetPendingSpawnCount(), 0);
+      TestTrue("Others registered", Orchestrator->FindBot(Wave[48]).IsSet());
+      TestFalse("Never registered", Orchestrator->FindBot(Wave.Last()).IsSet());
+
+      for (AActor *Actor : Wave) {
+        Actor->Destroy();
+      }
+      Orchestrator->Destroy();
+    });
+  });
+
+  Describe("Snapshots", [this]() {
+    It("Should restore onto the same actors registered in a new session",
+       [this]() {
+         UWorld *World = GEngine->GetWorldContexts()[0].World();
+         if (!World)
+           return;
+
+         TArray<AActor *> Actors;
+         for (int32 Index = 0; Index < 3; ++Index) {
+           Actors.Add(World->SpawnActor<AActor>());
+         }
+
+         ABotOrchestrator *Saved = World->SpawnActor<ABotOrchestrator>();
+         for (AActor *Actor : Actors) {
+           Saved->RegisterBot(Actor, TEXT("TestPersona"));
+         }
+         TArray<uint8> Snapshot;
+         Saved->WriteBotSnapshot(Snapshot);
+         Saved->Destroy();
+
+         // Next session: the same actors register from scratch
+         ABotOrchestrator *Restored = World->SpawnActor<ABotOrchestrator>();
+         for (AActor *Actor : Actors) {
+           Restored->RegisterBot(Actor, TEXT("TestPersona"));
+         }
+
+         TestEqual("Every bot matched", Restored->ApplyBotSnapshot(Snapshot),
+                   Actors.Num());
+         TArray<uint8> After;
+         Restored->WriteBotSnapshot(After);
+         TestTrue("Saved state restored", After == Snapshot);
+
+         for (AActor *Actor : Actors) {
+           Actor->Destroy();
+         }
+         Restored->Destroy();
+       });
+  });
+
   Describe("Orchestration Cycle", [this]() {
     It("Should respect the observation interval", [this]() {
       // This would test that RequestNextAction is called
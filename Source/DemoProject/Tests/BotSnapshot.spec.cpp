@@ -0,0 +1,170 @@
+#include "DemoProject/State/BotSnapshot.h"
+#include "DemoProject/State/BotState.h"
+#include "DemoProject/State/BotStateTable.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+
+using namespace ForbocAI;
+
+DEFINE_SPEC(FBotSnapshotSpec, "ForbocAI.State.Snapshot",
+            EAutomationTestFlags::ProductFilter |
+                EAutomationTestFlags::ApplicationContextMask)
+
+namespace {
+
+void FillTable(State::FBotStateTable &Table, int32 Count) {
+  FRandomStream Random(Count);
+  State::TableOps::Reserve(Table, Count);
+  for (int32 Index = 0; Index < Count; ++Index) {
+    State::FBotState Bot = State::CreateInitialState(TEXT("Snap"));
+    Bot.Position = FVector(Random.FRandRange(-1e5f, 1e5f),
+                           Random.FRandRange(-1e5f, 1e5f), 0.0f);
+    Bot.Stats.Health = Random.FRandRange(0.0f, 100.0f);
+    Bot.Memory.bHasAggro = Random.RandRange(0, 1) == 1;
+    Bot.Phase = (State::EBotPhase)(Index % 5);
+    Bot.TickCount = Random.RandRange(0, 100000);
+    State::TableOps::AddRow(Table, Bot);
+  }
+}
+
+bool RowsMatch(const State::FBotStateTable &A, int32 RowA,
+               const State::FBotStateTable &B, int32 RowB) {
+  return A.Ids[RowA] == B.Ids[RowB] && A.Positions[RowA] == B.Positions[RowB] &&
+         A.Stats[RowA].Health == B.Stats[RowB].Health &&
+         A.bHasAggro[RowA] == B.bHasAggro[RowB] &&
+         A.Phases[RowA] == B.Phases[RowB] &&
+         A.TickCounts[RowA] == B.TickCounts[RowB];
+}
+
+} // namespace
+
+void FBotSnapshotSpec::Define() {
+  Describe("Full Snapshots", [this]() {
+    It("Should round-trip every row", [this]() {
+      State::FBotStateTable Table;
+      FillTable(Table, 1000);
+
+      TArray<uint8> Bytes;
+      State::SnapshotOps::Write(Table, Bytes);
+
+      State::FBotSnapshotView View;
+      TestTrue("Parses", State::SnapshotOps::Parse(Bytes, View));
+      TestFalse("Full", View.IsIncremental());
+
+      State::FBotStateTable Loaded;
+      TestTrue("Loads", State::SnapshotOps::Load(Loaded, View));
+      TestEqual("Rows", State::TableOps::Num(Loaded), 1000);
+      for (int32 Row = 0; Row < 1000; ++Row) {
+        if (!TestTrue("Row matches", RowsMatch(Table, Row, Loaded, Row))) {
+          return;
+        }
+      }
+    });
+
+    It("Should reject foreign or truncated data", [this]() {
+      State::FBotStateTable Table;
+      FillTable(Table, 10);
+      TArray<uint8> Bytes;
+      State::SnapshotOps::Write(Table, Bytes);
+
+      State::FBotSnapshotView View;
+      TestFalse("Truncated",
+                State::SnapshotOps::Parse(
+                    TArrayView<const uint8>(Bytes).LeftChop(16), View));
+
+      // Shifted off the alignment the columns are read in place at
+      TArray<uint8> Shifted;
+      Shifted.Add(0);
+      Shifted.Append(Bytes);
+      TestFalse("Misaligned",
+                State::SnapshotOps::Parse(
+                    TArrayView<const uint8>(Shifted).RightChop(1), View));
+
+      // An offset that wraps around when the column size is added
+      TArray<uint8> Wrapped = Bytes;
+      reinterpret_cast<State::FBotSnapshotHeader *>(Wrapped.GetData())
+          ->ColumnOffsets[1] = MAX_uint64 - 8;
+      TestFalse("Offset overflow", State::SnapshotOps::Parse(Wrapped, View));
+
+      Bytes[0] ^= 0xFF;
+      TestFalse("Bad magic", State::SnapshotOps::Parse(Bytes, View));
+    });
+  });
+
+  Describe("Incremental Snapshots", [this]() {
+    It("Should carry only rows changed since the last snapshot", [this]() {
+      State::FBotStateTable Table;
+      FillTable(Table, 100);
+      TArray<uint8> Base;
+      State::SnapshotOps::Write(Table, Base);
+
+      State::FBotStateTable Restored;
+      State::FBotSnapshotView View;
+      State::SnapshotOps::Parse(Base, View);
+      State::SnapshotOps::Load(Restored, View);
+
+      // The heartbeat alone doesn't dirty anything, but still goes out
+      State::TableOps::ReduceTick(Table, 0.1f);
+      for (const int32 Row : {3, 42, 99}) {
+        State::FBotState Bot = State::TableOps::ReadRow(Table, Row);
+        Bot.Stats.Health = 1.0f;
+        Bot.Phase = State::EBotPhase::Flee;
+        State::TableOps::WriteRow(Table, Row, Bot);
+      }
+
+      TArray<uint8> Delta;
+      State::SnapshotOps::Write(Table, Delta, true);
+      TestTrue("Parses", State::SnapshotOps::Parse(Delta, View));
+      TestTrue("Incremental", View.IsIncremental());
+      TestEqual("Dirty rows", View.Num(), 3);
+      TestTrue("Smaller", Delta.Num() < Base.Num() / 3);
+
+      TestEqual("Applied", State::SnapshotOps::Apply(Restored, View), 3);
+      for (const int32 Row : {3, 42, 99}) {
+        TestEqual("Health", Restored.Stats[Row].Health, 1.0f);
+        TestEqual("Phase", Restored.Phases[Row], State::EBotPhase::Flee);
+      }
+      for (const int32 Row : {4, 42}) {
+        TestEqual("Heartbeat ticks", Restored.TickCounts[Row],
+                  Table.TickCounts[Row]);
+        TestEqual("Heartbeat timer", Restored.TimeSinceLastSeenPlayer[Row],
+                  Table.TimeSinceLastSeenPlayer[Row]);
+        TestEqual("Heartbeat aggro", Restored.bHasAggro[Row],
+                  Table.bHasAggro[Row]);
+      }
+      TestFalse("Restored clean", Restored.Dirty[4]);
+
+      State::SnapshotOps::Write(Table, Delta, true);
+      State::SnapshotOps::Parse(Delta, View);
+      TestEqual("Flags cleared", View.Num(), 0);
+    });
+  });
+
+  Describe("Performance", [this]() {
+    It("Should report load time for 100k bots", [this]() {
+      State::FBotStateTable Table;
+      FillTable(Table, 100000);
+      TArray<uint8> Bytes;
+      State::SnapshotOps::Write(Table, Bytes);
+
+      State::FBotStateTable Loaded;
+      State::FBotSnapshotView View;
+      const double Start = FPlatformTime::Seconds();
+      const bool bLoaded = State::SnapshotOps::Parse(Bytes, View) &&
+                           State::SnapshotOps::Load(Loaded, View);
+      const double LoadMs = (FPlatformTime::Seconds() - Start) * 1000.0;
+
+      // Same population: the in-place restore path
+      const double ApplyStart = FPlatformTime::Seconds();
+      const int32 Applied = State::SnapshotOps::Apply(Loaded, View);
+      const double ApplyMs = (FPlatformTime::Seconds() - ApplyStart) * 1000.0;
+
+      TestTrue("Loaded", bLoaded);
+      TestEqual("Applied", Applied, 100000);
+      TestTrue("Last row", RowsMatch(Table, 99999, Loaded, 99999));
+      AddInfo(FString::Printf(
+          TEXT("100k bots: %.1f MB, load %.3f ms, apply %.3f ms"),
+          Bytes.Num() / (1024.0 * 1024.0), LoadMs, ApplyMs));
+    });
+  });
+}
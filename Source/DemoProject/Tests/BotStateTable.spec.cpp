@@ -0,0 +1,112 @@
+#include "DemoProject/Bot/Factories/BotFactory.h"
+#include "DemoProject/State/Actions.h"
+#include "DemoProject/State/BotState.h"
+#include "DemoProject/State/BotStateTable.h"
+#include "DemoProject/State/Reducers.h"
+#include "Misc/AutomationTest.h"
+
+using namespace ForbocAI;
+
+DEFINE_SPEC(FBotStateTableSpec, "ForbocAI.State.Table",
+            EAutomationTestFlags::ProductFilter |
+                EAutomationTestFlags::ApplicationContextMask)
+
+void FBotStateTableSpec::Define() {
+  Describe("Rows", [this]() {
+    It("Should round-trip a state through AddRow/ReadRow", [this]() {
+      State::FBotStateTable Table;
+      State::FBotState Initial = State::CreateInitialState(TEXT("RowBot"));
+      Initial.Position = FVector(1, 2, 3);
+      Initial.Stats.Health = 42.0f;
+      Initial.Phase = State::EBotPhase::Patrol;
+
+      const int32 Row = State::TableOps::AddRow(Table, Initial);
+      const State::FBotState Read = State::TableOps::ReadRow(Table, Row);
+
+      TestEqual("Row", Row, 0);
+      TestEqual("Id", Read.Id, Initial.Id);
+      TestTrue("Name", Read.Name == Initial.Name);
+      TestEqual("Position", Read.Position, Initial.Position);
+      TestEqual("Health", Read.Stats.Health, 42.0f);
+      TestEqual("Phase", Read.Phase, State::EBotPhase::Patrol);
+    });
+
+    It("Should move the last row into a removed one", [this]() {
+      State::FBotStateTable Table;
+      State::FBotState Last;
+      for (int32 Index = 0; Index < 3; ++Index) {
+        Last = State::CreateInitialState(
+            FName(*FString::Printf(TEXT("Bot%d"), Index)));
+        Last.Stats.Health = 10.0f * (Index + 1);
+        State::TableOps::AddRow(Table, Last);
+      }
+
+      TestTrue("Moved", State::TableOps::RemoveRowSwap(Table, 0));
+      TestEqual("Rows", State::TableOps::Num(Table), 2);
+
+      const State::FBotState Read = State::TableOps::ReadRow(Table, 0);
+      TestEqual("Id follows", Read.Id, Last.Id);
+      TestEqual("Health follows", Read.Stats.Health, 30.0f);
+
+      TestFalse("Last row moves nothing",
+                State::TableOps::RemoveRowSwap(Table, 1));
+    });
+  });
+
+  Describe("ReduceTick", [this]() {
+    It("Should match the per-bot tick reducer exactly", [this]() {
+      State::FBotStateTable Table;
+      TArray<State::FBotState> Reference;
+
+      FRandomStream Random(1337);
+      for (int32 Index = 0; Index < 257; ++Index) {
+        State::FBotState Bot = State::CreateInitialState(TEXT("Bot"));
+        Bot.Memory.TimeSinceLastSeenPlayer = Random.FRandRange(0.0f, 12.0f);
+        Bot.Memory.bHasAggro = Random.RandRange(0, 1) == 1;
+        Bot.TickCount = Random.RandRange(0, 1000);
+        State::TableOps::AddRow(Table, Bot);
+        Reference.Add(Bot);
+      }
+
+      State::FActionTick Tick;
+      for (int32 Frame = 0; Frame < 16; ++Frame) {
+        Tick.DeltaTime = Random.FRandRange(0.0f, 0.5f);
+        State::TableOps::ReduceTick(Table, Tick.DeltaTime);
+        for (State::FBotState &Bot : Reference) {
+          Bot = State::Reduce(Bot, Tick);
+        }
+      }
+
+      for (int32 Row = 0; Row < Reference.Num(); ++Row) {
+        const State::FBotState Read = State::TableOps::ReadRow(Table, Row);
+        TestEqual("TickCount", Read.TickCount, Reference[Row].TickCount);
+        TestEqual("TimeSinceLastSeenPlayer",
+                  Read.Memory.TimeSinceLastSeenPlayer,
+                  Reference[Row].Memory.TimeSinceLastSeenPlayer);
+        TestEqual("bHasAggro", Read.Memory.bHasAggro,
+                  Reference[Row].Memory.bHasAggro);
+      }
+    });
+  });
+
+  Describe("Store View", [this]() {
+    It("Should dispatch into the table row", [this]() {
+      auto Table = std::make_shared<State::FBotStateTable>();
+      State::TableOps::AddRow(*Table, State::CreateInitialState(TEXT("A")));
+      const int32 Row =
+          State::TableOps::AddRow(*Table, State::CreateInitialState(TEXT("B")));
+
+      auto Store = Bot::Factory::CreateBotStoreView(Table, Row);
+
+      State::FActionTakeDamage Damage;
+      Damage.Amount = 80.0f;
+      Store.Dispatch(Damage);
+
+      TestEqual("Row Health", Table->Stats[Row].Health, 20.0f);
+      TestEqual("Row Phase", Table->Phases[Row], State::EBotPhase::Flee);
+      TestEqual("Other Row Untouched", Table->Stats[0].Health, 100.0f);
+      TestEqual("GetState reads the row", Store.GetState().Name.ToString(),
+                FString(TEXT("B")));
+    });
+  });
+}
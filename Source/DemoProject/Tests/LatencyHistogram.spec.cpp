@@ -0,0 +1,163 @@
+#include "Async/ParallelFor.h"
+#include "DemoProject/Bot/LatencyHistogram.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+
+using namespace ForbocAI;
+
+DEFINE_SPEC(FLatencyHistogramSpec, "ForbocAI.Bot.Latency",
+            EAutomationTestFlags::ProductFilter |
+                EAutomationTestFlags::ApplicationContextMask)
+
+namespace {
+
+// Long-tailed, like network round trips: mostly 5-50 ms, some seconds
+TArray<uint64> RandomLatencies(int32 Count) {
+  FRandomStream Random(Count);
+  TArray<uint64> Values;
+  Values.Reserve(Count);
+  for (int32 Index = 0; Index < Count; ++Index) {
+    const double Exponent = Random.FRandRange(3.7f, 6.5f);
+    Values.Add((uint64)FMath::Pow(10.0, Exponent));
+  }
+  return Values;
+}
+
+} // namespace
+
+void FLatencyHistogramSpec::Define() {
+  Describe("Buckets", [this]() {
+    It("Should keep every value within its bucket's precision", [this]() {
+      for (uint64 Value : {0ull, 1ull, 31ull, 32ull, 33ull, 1000ull,
+                           123456ull, 1ull << 35, (1ull << 36) - 1}) {
+        Bot::FLatencyHistogram Histogram;
+        Bot::LatencyOps::Record(Histogram, Value);
+        const uint64 Found = Bot::LatencyOps::Percentile(Histogram, 1.0);
+        TestEqual("Single value is exact (capped at Max)", Found, Value);
+      }
+
+      for (uint64 Value = 1; Value < (1ull << 36); Value = Value * 3 + 1) {
+        const int32 Bucket = Bot::LatencyOps::BucketOf(Value);
+        const uint64 Low = Bot::LatencyOps::Detail::BucketLow(Bucket);
+        const uint64 High = Bot::LatencyOps::Detail::BucketHigh(Bucket);
+        if (!TestTrue("In bucket", Low <= Value && Value <= High) ||
+            !TestTrue("Precision", (double)(High - Low) <= Value / 31.0)) {
+          return;
+        }
+      }
+      TestEqual("Last bucket",
+                Bot::LatencyOps::BucketOf(~0ull),
+                Bot::FLatencyHistogram::NumBuckets - 1);
+    });
+
+    It("Should match exact percentiles to within 1/SubBuckets", [this]() {
+      TArray<uint64> Values = RandomLatencies(50000);
+      Bot::FLatencyHistogram Histogram;
+      for (uint64 Value : Values) {
+        Bot::LatencyOps::Record(Histogram, Value);
+      }
+      Values.Sort();
+
+      for (double Fraction : {0.5, 0.95, 0.99, 0.999}) {
+        const uint64 Exact =
+            Values[(int32)FMath::CeilToDouble(Fraction * Values.Num()) - 1];
+        const uint64 Found = Bot::LatencyOps::Percentile(Histogram, Fraction);
+        TestTrue(FString::Printf(TEXT("p%g"), Fraction * 100.0),
+                 FMath::Abs((double)Found - (double)Exact) <=
+                     Exact / (double)Bot::FLatencyHistogram::SubBuckets);
+      }
+      TestEqual("Max", Histogram.Max.load(), Values.Last());
+    });
+
+    It("Should count every value recorded from many threads", [this]() {
+      Bot::FLatencyHistogram Histogram;
+      constexpr int32 Writers = 8;
+      constexpr int32 PerWriter = 20000;
+      ParallelFor(Writers, [&Histogram](int32) {
+        for (int32 Index = 0; Index < PerWriter; ++Index) {
+          Bot::LatencyOps::Record(Histogram, Index);
+        }
+      });
+
+      TestEqual("Total", Histogram.Total.load(), (uint64)Writers * PerWriter);
+      TestEqual("Sum", Histogram.Sum.load(),
+                (uint64)Writers * PerWriter * (PerWriter - 1) / 2);
+      TestEqual("Max", Histogram.Max.load(), (uint64)PerWriter - 1);
+    });
+  });
+
+  Describe("Requests", [this]() {
+    It("Should split a request into its stages", [this]() {
+      Bot::FLatencyRecorder Recorder;
+      Bot::FRequestTiming Timing;
+      Timing.Due = 10.0;
+      Timing.Started = 10.5;
+      Timing.Serialized = 10.501;
+      Timing.Sent = 10.6;
+      Bot::LatencyOps::RecordRequest(Recorder, Timing, 11.6, 11.6005,
+                                     TEXT("Guard"), TEXT("MOVE"));
+
+      auto Millis = [&Recorder](Bot::ELatencyStage Stage) {
+        return Bot::LatencyOps::Summarize(Recorder.Stages[(int32)Stage]).P50Ms;
+      };
+      TestEqual("Queue", Millis(Bot::ELatencyStage::Queue), 500.0, 16.0);
+      TestEqual("Serialize", Millis(Bot::ELatencyStage::Serialize), 1.0,
+                0.05);
+      TestEqual("Batch", Millis(Bot::ELatencyStage::Batch), 99.0, 4.0);
+      TestEqual("Protocol", Millis(Bot::ELatencyStage::Protocol), 1000.0,
+                32.0);
+      TestEqual("Dispatch", Millis(Bot::ELatencyStage::Dispatch), 0.5, 0.02);
+      TestEqual("Total", Millis(Bot::ELatencyStage::Total), 1100.5, 35.0);
+
+      TestTrue("By persona", Recorder.ByPersona.Contains(TEXT("Guard")));
+      TestTrue("By action", Recorder.ByAction.Contains(TEXT("MOVE")));
+    });
+
+    It("Should write a CSV row per histogram with values", [this]() {
+      Bot::FLatencyRecorder Recorder;
+      Bot::FRequestTiming Timing;
+      Bot::LatencyOps::RecordRequest(Recorder, Timing, 0.0, 0.01,
+                                     TEXT("Guard, \"old\""), TEXT("MOVE"));
+      Bot::LatencyOps::Reset(Recorder);
+      Bot::LatencyOps::RecordRequest(Recorder, Timing, 0.0, 0.02,
+                                     TEXT("Guard, \"old\""), TEXT("ATTACK"));
+
+      FString Csv;
+      Bot::LatencyOps::WriteCsv(Recorder, 12.0, Csv);
+      TArray<FString> Lines;
+      Csv.ParseIntoArrayLines(Lines);
+
+      // Six stages, one persona, one action with values
+      TestEqual("Rows", Lines.Num(), 8);
+      TestTrue("Quoted", Csv.Contains(TEXT(",\"Guard, \"\"old\"\"\",")));
+      TestFalse("Reset action has no row", Csv.Contains(TEXT(",MOVE,")));
+      TestTrue("Stamped", Lines.Num() > 0 &&
+                              Lines[0].StartsWith(TEXT("12.000,Stage,")));
+    });
+  });
+
+  Describe("Performance", [this]() {
+    It("Should report the cost of one record", [this]() {
+      const TArray<uint64> Values = RandomLatencies(1000000);
+      Bot::FLatencyHistogram Histogram;
+
+      const double Start = FPlatformTime::Seconds();
+      for (uint64 Value : Values) {
+        Bot::LatencyOps::Record(Histogram, Value);
+      }
+      const double Ns =
+          (FPlatformTime::Seconds() - Start) * 1e9 / Values.Num();
+
+      const double PercentileStart = FPlatformTime::Seconds();
+      const Bot::FLatencySummary Summary =
+          Bot::LatencyOps::Summarize(Histogram);
+      const double SummaryUs =
+          (FPlatformTime::Seconds() - PercentileStart) * 1e6;
+
+      TestEqual("Count", Summary.Count, (uint64)Values.Num());
+      AddInfo(FString::Printf(
+          TEXT("Record %.1f ns; summary %.1f us (p50 %.2f ms, p99 %.2f ms)"),
+          Ns, SummaryUs, Summary.P50Ms, Summary.P99Ms));
+    });
+  });
+}
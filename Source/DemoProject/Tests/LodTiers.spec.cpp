@@ -0,0 +1,172 @@
+#include "DemoProject/Bot/LodTiers.h"
+#include "DemoProject/Bot/ParallelTick.h"
+#include "DemoProject/State/BotState.h"
+#include "DemoProject/State/BotStateTable.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+
+using namespace ForbocAI;
+
+DEFINE_SPEC(FLodTiersSpec, "ForbocAI.Bot.Lod",
+            EAutomationTestFlags::ProductFilter |
+                EAutomationTestFlags::ApplicationContextMask)
+
+namespace {
+
+const TArray<Bot::FLodTierConfig> &DefaultTiers() {
+  static const TArray<Bot::FLodTierConfig> Tiers = {
+      {2500.0f, 1, 0.0f}, {8000.0f, 3, 15.0f}, {20000.0f, 16, 30.0f}};
+  return Tiers;
+}
+
+void FillTable(State::FBotStateTable &Table, int32 Count) {
+  State::TableOps::Reserve(Table, Count);
+  for (int32 Index = 0; Index < Count; ++Index) {
+    State::TableOps::AddRow(Table, State::CreateInitialState(TEXT("Lod")));
+  }
+}
+
+} // namespace
+
+void FLodTiersSpec::Define() {
+  Describe("Configuration", [this]() {
+    It("Should add a sleep tier and align the divisors", [this]() {
+      Bot::FLodPartition Lod;
+      Bot::LodOps::Reset(Lod, DefaultTiers(), 10);
+
+      TestEqual("Tiers", Bot::LodOps::NumTiers(Lod), 4);
+      TestEqual("Rounded up", Lod.Tiers[1].Config.TickDivisor, 4);
+      TestEqual("Sleep never ticks", Lod.Tiers[3].Config.TickDivisor, 0);
+      TestEqual("Sync period", Lod.SyncPeriod, 16);
+      TestEqual("All start near", Bot::LodOps::TierEnd(Lod, 0, 10), 10);
+      TestTrue("Matches", Bot::LodOps::Matches(Lod, DefaultTiers()));
+    });
+
+    It("Should pick tiers by distance and phase", [this]() {
+      Bot::FLodPartition Lod;
+      Bot::LodOps::Reset(Lod, DefaultTiers(), 0);
+
+      const double Mid = 3000.0 * 3000.0;
+      const double Beyond = 50000.0 * 50000.0;
+      TestEqual("Mid", Bot::LodOps::PickTier(Lod, State::EBotPhase::Idle,
+                                             true, &Mid, true),
+                1);
+      TestEqual("Past the last distance",
+                Bot::LodOps::PickTier(Lod, State::EBotPhase::Idle, true,
+                                      &Beyond, true),
+                2);
+      TestEqual("Out of range sleeps",
+                Bot::LodOps::PickTier(Lod, State::EBotPhase::Patrol, true,
+                                      nullptr, true),
+                3);
+      TestEqual("Unless sleeping is off",
+                Bot::LodOps::PickTier(Lod, State::EBotPhase::Patrol, true,
+                                      nullptr, false),
+                2);
+      TestEqual("Combat is always near",
+                Bot::LodOps::PickTier(Lod, State::EBotPhase::Combat, true,
+                                      nullptr, true),
+                0);
+      TestEqual("No players", Bot::LodOps::PickTier(
+                                  Lod, State::EBotPhase::Idle, false,
+                                  nullptr, true),
+                0);
+    });
+  });
+
+  Describe("Ticking", [this]() {
+    It("Should keep tiers contiguous and carry skipped time", [this]() {
+      constexpr int32 Count = 1000;
+      Bot::FLodPartition Lod;
+      Bot::LodOps::Reset(Lod, DefaultTiers(), Count);
+
+      // Reference: every bot ticked every frame. Source maps rows back to
+      // it as rows move between tiers.
+      State::FBotStateTable Table, Reference;
+      FillTable(Table, Count);
+      FillTable(Reference, Count);
+      TArray<int32> Source;
+      for (int32 Row = 0; Row < Count; ++Row) {
+        Source.Add(Row);
+      }
+      auto Swap = [&](int32 A, int32 B) {
+        State::TableOps::SwapRows(Table, A, B);
+        Source.Swap(A, B);
+      };
+
+      FRandomStream Random(18);
+      Bot::FParallelTickConfig Config;
+      for (int32 Frame = 0; Frame < 2000; ++Frame) {
+        const float DeltaTime = Random.FRandRange(0.005f, 0.05f);
+        State::TableOps::ReduceTick(Reference, DeltaTime);
+        const bool bSync = Bot::LodOps::Advance(
+            Lod, Count, DeltaTime,
+            [&](int32, int32 Begin, int32 End,
+                const State::FActionTick &Heartbeat) {
+              Bot::ParallelOps::Tick(Table, Begin, End, Heartbeat, Config);
+            });
+        if (!bSync) {
+          continue;
+        }
+
+        // Nothing is owed on a sync frame, so rows may change tier
+        for (int32 Row = 0; Row < Count; ++Row) {
+          if (Table.TickCounts[Row] != Reference.TickCounts[Source[Row]]) {
+            TestEqual("TickCount", Table.TickCounts[Row],
+                      Reference.TickCounts[Source[Row]]);
+            return;
+          }
+        }
+        for (int32 Move = 0; Move < 50; ++Move) {
+          Bot::LodOps::Move(Lod, Random.RandRange(0, Count - 1),
+                            Random.RandRange(0, 2), Swap);
+        }
+      }
+
+      for (int32 Row = 0; Row < Count; ++Row) {
+        TestEqual("Decay", Table.TimeSinceLastSeenPlayer[Row],
+                  Reference.TimeSinceLastSeenPlayer[Source[Row]], 0.05f);
+      }
+    });
+  });
+
+  Describe("Performance", [this]() {
+    It("Should report heartbeat cost with and without tiers", [this]() {
+      constexpr int32 Count = 100000;
+      constexpr int32 Frames = 64;
+      State::FBotStateTable Table;
+      FillTable(Table, Count);
+
+      // A typical spread: 5% near, 15% mid, 30% far, the rest asleep
+      Bot::FLodPartition Lod;
+      Bot::LodOps::Reset(Lod, DefaultTiers(), Count);
+      Lod.Begin = {0, Count / 20, Count / 5, Count / 2};
+
+      Bot::FParallelTickConfig Config;
+      Config.bSingleThread = true;
+      const double FlatStart = FPlatformTime::Seconds();
+      for (int32 Frame = 0; Frame < Frames; ++Frame) {
+        Bot::ParallelOps::Tick(Table, 0.016f, Config);
+      }
+      const double FlatMs =
+          (FPlatformTime::Seconds() - FlatStart) * 1000.0 / Frames;
+
+      const double LodStart = FPlatformTime::Seconds();
+      for (int32 Frame = 0; Frame < Frames; ++Frame) {
+        Bot::LodOps::Advance(Lod, Count, 0.016f,
+                             [&](int32, int32 Begin, int32 End,
+                                 const State::FActionTick &Heartbeat) {
+                               Bot::ParallelOps::Tick(Table, Begin, End,
+                                                      Heartbeat, Config);
+                             });
+      }
+      const double LodMs =
+          (FPlatformTime::Seconds() - LodStart) * 1000.0 / Frames;
+
+      AddInfo(FString::Printf(
+          TEXT("100k bots: every bot every frame %.3f ms/frame, tiered "
+               "%.3f ms/frame (tier 0 %.3f ms)"),
+          FlatMs, LodMs, Lod.Tiers[0].TickSeconds * 1000.0));
+    });
+  });
+}
@@ -0,0 +1,126 @@
+#include "DemoProject/Bot/ObservationScheduler.h"
+#include "Misc/AutomationTest.h"
+
+using namespace ForbocAI;
+
+DEFINE_SPEC(FObservationSchedulerSpec, "ForbocAI.Bot.ObservationScheduler",
+            EAutomationTestFlags::ProductFilter |
+                EAutomationTestFlags::ApplicationContextMask)
+
+void FObservationSchedulerSpec::Define() {
+  Describe("Timing", [this]() {
+    It("Should hand out each key once, no earlier than its delay", [this]() {
+      Bot::TObservationWheel<int32> Wheel;
+      Bot::SchedulerOps::Reset(Wheel, 10.0);
+
+      // Spans inner slots, outer blocks and the overflow list
+      FRandomStream Random(99);
+      TArray<double> DueAt;
+      for (int32 Key = 0; Key < 2000; ++Key) {
+        const double Delay = Random.FRandRange(0.0f, 1000.0f);
+        Bot::SchedulerOps::Schedule(Wheel, Key, Delay);
+        DueAt.Add(10.0 + Delay);
+      }
+
+      TArray<int32> Seen;
+      Seen.Init(0, DueAt.Num());
+      TArray<int32> Due;
+      for (double Now = 10.0; Now < 1020.0; Now += 0.05) {
+        Due.Reset();
+        Bot::SchedulerOps::Advance(Wheel, Now, 0, Due);
+        for (const int32 Key : Due) {
+          Seen[Key]++;
+          // One tick of slack for rounding up to the wheel resolution
+          if (Now + 1e-6 < DueAt[Key] || Now > DueAt[Key] + 0.1) {
+            AddError(FString::Printf(TEXT("Key %d due %.3f, fired %.3f"), Key,
+                                     DueAt[Key], Now));
+            return;
+          }
+        }
+      }
+
+      for (int32 Key = 0; Key < Seen.Num(); ++Key) {
+        TestEqual(*FString::Printf(TEXT("Key %d fired once"), Key), Seen[Key],
+                  1);
+      }
+      TestEqual("Wheel empty", Wheel.Num, 0);
+    });
+
+    It("Should survive a hitch longer than the wheel", [this]() {
+      Bot::TObservationWheel<int32> Wheel;
+      Bot::SchedulerOps::Reset(Wheel, 0.0);
+      Bot::SchedulerOps::Schedule(Wheel, 1, 100.0);
+      Bot::SchedulerOps::Schedule(Wheel, 2, 800.0);
+      Bot::SchedulerOps::Schedule(Wheel, 3, 3000.0);
+
+      TArray<int32> Due;
+      Bot::SchedulerOps::Advance(Wheel, 2000.0, 0, Due);
+      TestEqual("Two due after the hitch", Due.Num(), 2);
+
+      Due.Reset();
+      Bot::SchedulerOps::Advance(Wheel, 3000.1, 0, Due);
+      TestEqual("Last one on time", Due.Num(), 1);
+    });
+
+    It("Should keep keys and their delays when rebased", [this]() {
+      Bot::TObservationWheel<int32> Wheel;
+      Bot::SchedulerOps::Schedule(Wheel, 1, 1.0);
+      Bot::SchedulerOps::Schedule(Wheel, 2, 20.0);
+      Bot::SchedulerOps::Schedule(Wheel, 3, 1000.0);
+
+      // The clock starts at zero; the world was already at 500s
+      Bot::SchedulerOps::Rebase(Wheel, 500.0);
+      TestEqual("Nothing dropped", Wheel.Num, 3);
+
+      TArray<int32> Due;
+      Bot::SchedulerOps::Advance(Wheel, 500.5, 0, Due);
+      TestEqual("None due early", Due.Num(), 0);
+      Bot::SchedulerOps::Advance(Wheel, 501.1, 0, Due);
+      Bot::SchedulerOps::Advance(Wheel, 520.1, 0, Due);
+      TestTrue("Near ones on time", Due == TArray<int32>({1, 2}));
+      Bot::SchedulerOps::Advance(Wheel, 1500.1, 0, Due);
+      TestEqual("Far one on time", Due.Num(), 3);
+    });
+  });
+
+  Describe("Budget", [this]() {
+    It("Should carry over-budget keys to the next frame in order", [this]() {
+      Bot::TObservationWheel<int32> Wheel;
+      Bot::SchedulerOps::Reset(Wheel, 0.0);
+      for (int32 Key = 0; Key < 100; ++Key) {
+        Bot::SchedulerOps::Schedule(Wheel, Key, 1.0);
+      }
+
+      TArray<int32> Due;
+      Bot::SchedulerOps::Advance(Wheel, 2.0, 30, Due);
+      TestEqual("First frame", Due.Num(), 30);
+      TestEqual("Backlog", Bot::SchedulerOps::NumBacklogged(Wheel), 70);
+
+      Due.Reset();
+      Bot::SchedulerOps::Advance(Wheel, 2.1, 30, Due);
+      TestEqual("Second frame starts where the first stopped", Due[0], 30);
+    });
+  });
+
+  Describe("Spread", [this]() {
+    It("Should spread a registration wave across the interval", [this]() {
+      constexpr double Interval = 5.0;
+      constexpr int32 Bots = 500;
+      constexpr int32 Buckets = 10;
+
+      TArray<int32> PerBucket;
+      PerBucket.Init(0, Buckets);
+      for (uint32 Index = 0; Index < Bots; ++Index) {
+        const double Offset =
+            Bot::SchedulerOps::SpreadOffset(Index, Interval);
+        PerBucket[FMath::Min(Buckets - 1,
+                             (int32)(Offset / Interval * Buckets))]++;
+      }
+
+      // Golden-ratio offsets stay within a couple of bots of uniform
+      for (const int32 Count : PerBucket) {
+        TestTrue("Even bucket", FMath::Abs(Count - Bots / Buckets) <= 2);
+      }
+    });
+  });
+}
@@ -0,0 +1,166 @@
+#include "DemoProject/Bot/ObservationWriter.h"
+#include "DemoProject/State/BotState.h"
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+using namespace ForbocAI;
+
+DEFINE_SPEC(FObservationWriterSpec, "ForbocAI.Bot.ObservationWriter",
+            EAutomationTestFlags::ProductFilter |
+                EAutomationTestFlags::ApplicationContextMask)
+
+namespace {
+
+TArray<State::FBotState> MakeStates(int32 Count) {
+  FRandomStream Random(Count);
+  TArray<State::FBotState> States;
+  States.Reserve(Count);
+  for (int32 Index = 0; Index < Count; ++Index) {
+    State::FBotState &Bot = States.Add_GetRef(State::CreateInitialState(
+        FName(*FString::Printf(TEXT("Bot_%d"), Index))));
+    Bot.Stats.Health = Random.FRandRange(0.0f, 100.0f);
+    Bot.Position = FVector(Random.FRandRange(-1e5f, 1e5f),
+                           Random.FRandRange(-1e5f, 1e5f),
+                           Random.FRandRange(-500.0f, 500.0f));
+    Bot.Phase = (State::EBotPhase)(Index % 5);
+  }
+  return States;
+}
+
+// What ABotOrchestrator::GetStateObservation used to do
+FString PrintfObservation(const State::FBotState &Bot) {
+  return FString::Printf(
+      TEXT("Name: %s, Health: %.1f, Position: %s, Phase: %d"),
+      *Bot.Name.ToString(), Bot.Stats.Health, *Bot.Position.ToString(),
+      (int32)Bot.Phase);
+}
+
+} // namespace
+
+void FObservationWriterSpec::Define() {
+  Describe("Formats", [this]() {
+    It("Should match the Printf text exactly", [this]() {
+      Bot::FObservationBuffer Buffer;
+      for (const State::FBotState &Bot : MakeStates(500)) {
+        const Bot::FObservationSpan Span =
+            Bot::ObservationOps::WriteText(Buffer, Bot);
+        const FString Text(Bot::ObservationOps::TextView(Buffer, Span));
+        if (!TestEqual("Text", Text, PrintfObservation(Bot))) {
+          return;
+        }
+      }
+    });
+
+    It("Should write parseable JSON, escaping the name", [this]() {
+      State::FBotState Bot = State::CreateInitialState(TEXT("Say \"hi\"\\"));
+      Bot.Stats.Health = 42.0f;
+      Bot.Phase = State::EBotPhase::Combat;
+
+      Bot::FObservationBuffer Buffer;
+      const FString Json(Bot::ObservationOps::TextView(
+          Buffer, Bot::ObservationOps::WriteJson(Buffer, Bot)));
+
+      TSharedPtr<FJsonObject> Root;
+      TestTrue("Parses", FJsonSerializer::Deserialize(
+                             TJsonReaderFactory<>::Create(Json), Root));
+      if (Root.IsValid()) {
+        TestEqual("Name", Root->GetStringField(TEXT("name")),
+                  Bot.Name.ToString());
+        TestEqual("Health", Root->GetNumberField(TEXT("health")), 42.0);
+        TestEqual("Phase", Root->GetIntegerField(TEXT("phase")),
+                  (int32)State::EBotPhase::Combat);
+      }
+    });
+
+    It("Should write null for non-finite numbers", [this]() {
+      State::FBotState Bot = State::CreateInitialState(TEXT("Broken"));
+      Bot.Stats.Health = NAN;
+      Bot.Position.Y = INFINITY;
+
+      Bot::FObservationBuffer Buffer;
+      const FString Json(Bot::ObservationOps::TextView(
+          Buffer, Bot::ObservationOps::WriteJson(Buffer, Bot)));
+
+      TSharedPtr<FJsonObject> Root;
+      TestTrue("Parses", FJsonSerializer::Deserialize(
+                             TJsonReaderFactory<>::Create(Json), Root));
+      if (Root.IsValid()) {
+        TestTrue("Health null",
+                 Root->HasTypedField<EJson::Null>(TEXT("health")));
+        TestEqual("MaxHealth", Root->GetNumberField(TEXT("maxHealth")),
+                  (double)Bot.Stats.MaxHealth);
+        const TArray<TSharedPtr<FJsonValue>> &Position =
+            Root->GetArrayField(TEXT("position"));
+        TestEqual("Position", Position.Num(), 3);
+        TestTrue("Y null", Position.Num() == 3 && Position[1]->IsNull());
+      }
+    });
+
+    It("Should write fixed-size binary records", [this]() {
+      Bot::FObservationBuffer Buffer;
+      const State::FBotState Bot = State::CreateInitialState(TEXT("Bin"));
+      const Bot::FObservationSpan First =
+          Bot::ObservationOps::WriteBinary(Buffer, Bot);
+      const Bot::FObservationSpan Second =
+          Bot::ObservationOps::WriteBinary(Buffer, Bot);
+
+      TestEqual("Size", First.Length, Bot::ObservationOps::BinarySize);
+      TestEqual("Packed", Second.Offset, Bot::ObservationOps::BinarySize);
+      TestEqual("Version", Bot::ObservationOps::BinaryView(Buffer, First)[0],
+                Bot::ObservationOps::BinaryVersion);
+    });
+  });
+
+  Describe("Performance", [this]() {
+    It("Should report cost against Printf on 10k states", [this]() {
+      const TArray<State::FBotState> States = MakeStates(10000);
+      constexpr int32 Frames = 10;
+
+      double Start = FPlatformTime::Seconds();
+      int32 Sink = 0;
+      for (int32 Frame = 0; Frame < Frames; ++Frame) {
+        for (const State::FBotState &Bot : States) {
+          Sink += PrintfObservation(Bot).Len();
+        }
+      }
+      const double PrintfMs =
+          (FPlatformTime::Seconds() - Start) * 1000.0 / Frames;
+
+      // Warm the pooled buffer, as a running orchestrator would be
+      Bot::FObservationBuffer Buffer;
+      for (const State::FBotState &Bot : States) {
+        Bot::ObservationOps::WriteText(Buffer, Bot);
+        Bot::ObservationOps::WriteBinary(Buffer, Bot);
+      }
+
+      auto Measure = [&](auto &&Write) {
+        const double Begin = FPlatformTime::Seconds();
+        for (int32 Frame = 0; Frame < Frames; ++Frame) {
+          Bot::ObservationOps::Reset(Buffer);
+          for (const State::FBotState &Bot : States) {
+            Sink += Write(Bot).Length;
+          }
+        }
+        return (FPlatformTime::Seconds() - Begin) * 1000.0 / Frames;
+      };
+
+      const double TextMs = Measure([&](const State::FBotState &Bot) {
+        return Bot::ObservationOps::WriteText(Buffer, Bot);
+      });
+      const double JsonMs = Measure([&](const State::FBotState &Bot) {
+        return Bot::ObservationOps::WriteJson(Buffer, Bot);
+      });
+      const double BinaryMs = Measure([&](const State::FBotState &Bot) {
+        return Bot::ObservationOps::WriteBinary(Buffer, Bot);
+      });
+
+      AddInfo(FString::Printf(
+          TEXT("10k observations: Printf %.3f ms, Text %.3f ms, Json %.3f ms, "
+               "Binary %.3f ms (%d)"),
+          PrintfMs, TextMs, JsonMs, BinaryMs, Sink));
+    });
+  });
+}
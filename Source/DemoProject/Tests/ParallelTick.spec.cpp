@@ -0,0 +1,102 @@
+#include "Async/TaskGraphInterfaces.h"
+#include "DemoProject/Bot/ParallelTick.h"
+#include "DemoProject/State/BotState.h"
+#include "DemoProject/State/BotStateTable.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+
+using namespace ForbocAI;
+
+DEFINE_SPEC(FParallelTickSpec, "ForbocAI.Bot.ParallelTick",
+            EAutomationTestFlags::ProductFilter |
+                EAutomationTestFlags::ApplicationContextMask)
+
+namespace {
+
+void FillTable(State::FBotStateTable &Table, int32 Count) {
+  FRandomStream Random(Count);
+  State::TableOps::Reserve(Table, Count);
+  for (int32 Index = 0; Index < Count; ++Index) {
+    State::FBotState Bot = State::CreateInitialState(TEXT("Par"));
+    Bot.Memory.TimeSinceLastSeenPlayer = Random.FRandRange(0.0f, 12.0f);
+    Bot.Memory.bHasAggro = true;
+    State::TableOps::AddRow(Table, Bot);
+  }
+}
+
+// 1, 3, 7 and every worker the machine has, where it has that many: odd
+// counts split the chunks unevenly, which powers of two never do.
+TArray<int32> WorkerCounts() {
+  const int32 MaxWorkers =
+      FMath::Max(1, FTaskGraphInterface::Get().GetNumWorkerThreads());
+  TArray<int32> Counts;
+  for (const int32 Workers : {1, 3, 7, MaxWorkers}) {
+    if (Workers <= MaxWorkers) {
+      Counts.AddUnique(Workers);
+    }
+  }
+  return Counts;
+}
+
+} // namespace
+
+void FParallelTickSpec::Define() {
+  Describe("Determinism", [this]() {
+    It("Should match the single-threaded pass exactly", [this]() {
+      constexpr int32 Count = 5000;
+
+      for (const int32 Workers : WorkerCounts()) {
+        State::FBotStateTable Serial, Parallel;
+        FillTable(Serial, Count);
+        FillTable(Parallel, Count);
+
+        Bot::FParallelTickConfig ParallelConfig;
+        ParallelConfig.ChunkSize = 97; // deliberately ragged
+        ParallelConfig.MaxWorkers = Workers;
+
+        for (int32 Frame = 0; Frame < 30; ++Frame) {
+          State::TableOps::ReduceTick(Serial, 0.2f);
+          Bot::ParallelOps::Tick(Parallel, 0.2f, ParallelConfig);
+        }
+
+        const FString Suffix = FString::Printf(TEXT(" (%d workers)"), Workers);
+        TestTrue(TEXT("TimeSince") + Suffix,
+                 Serial.TimeSinceLastSeenPlayer ==
+                     Parallel.TimeSinceLastSeenPlayer);
+        TestTrue(TEXT("Aggro") + Suffix,
+                 Serial.bHasAggro == Parallel.bHasAggro);
+        TestTrue(TEXT("TickCounts") + Suffix,
+                 Serial.TickCounts == Parallel.TickCounts);
+      }
+    });
+  });
+
+  Describe("Scaling", [this]() {
+    It("Should report heartbeat cost from 1 to N workers", [this]() {
+      constexpr int32 Frames = 50;
+      const TArray<int32> Counts = WorkerCounts();
+
+      for (const int32 Count : {1000, 10000, 50000}) {
+        State::FBotStateTable Table;
+        FillTable(Table, Count);
+
+        for (const int32 Workers : Counts) {
+          Bot::FParallelTickConfig Config;
+          Config.ChunkSize = 1024;
+          Config.MaxWorkers = Workers;
+          Config.bSingleThread = Workers == 1;
+
+          const double Start = FPlatformTime::Seconds();
+          for (int32 Frame = 0; Frame < Frames; ++Frame) {
+            Bot::ParallelOps::Tick(Table, 0.016f, Config);
+          }
+          const double PerFrameMs =
+              (FPlatformTime::Seconds() - Start) * 1000.0 / Frames;
+
+          AddInfo(FString::Printf(TEXT("%6d bots, %2d workers: %.4f ms"),
+                                  Count, Workers, PerFrameMs));
+        }
+      }
+    });
+  });
+}
@@ -0,0 +1,145 @@
+#include "DemoProject/State/Actions.h"
+#include "DemoProject/State/BotState.h"
+#include "DemoProject/State/Reducers.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+
+using namespace ForbocAI;
+
+DEFINE_SPEC(FReducerDispatchSpec, "ForbocAI.State.Dispatch",
+            EAutomationTestFlags::ProductFilter |
+                EAutomationTestFlags::ApplicationContextMask)
+
+namespace {
+
+// Every action type but Flee, in random order
+TArray<State::FBotAction> MixedStream(int32 Count) {
+  FRandomStream Random(Count);
+  TArray<State::FBotAction> Actions;
+  Actions.Reserve(Count);
+  for (int32 Index = 0; Index < Count; ++Index) {
+    switch (Random.RandRange(0, 4)) {
+    case 0:
+      Actions.Add(State::FActionTick{Random.FRandRange(0.0f, 0.1f)});
+      break;
+    case 1:
+      Actions.Add(State::FActionMove{FVector(Index, 0.0f, 0.0f), 100.0f});
+      break;
+    case 2:
+      Actions.Add(State::FActionTakeDamage{0.001f, nullptr});
+      break;
+    case 3:
+      Actions.Add(State::FActionSpotEnemy{FVector(1.0f, 2.0f, 3.0f)});
+      break;
+    default:
+      Actions.Add(State::FActionAttack{nullptr});
+      break;
+    }
+  }
+  return Actions;
+}
+
+bool SameState(const State::FBotState &A, const State::FBotState &B) {
+  return A.Position == B.Position && A.Stats.Health == B.Stats.Health &&
+         A.Phase == B.Phase && A.TickCount == B.TickCount &&
+         A.Memory.TimeSinceLastSeenPlayer ==
+             B.Memory.TimeSinceLastSeenPlayer &&
+         A.Memory.bHasAggro == B.Memory.bHasAggro;
+}
+
+template <typename FnType> double MeasureMs(FnType &&Fn) {
+  const double Start = FPlatformTime::Seconds();
+  Fn();
+  return (FPlatformTime::Seconds() - Start) * 1000.0;
+}
+
+} // namespace
+
+void FReducerDispatchSpec::Define() {
+  Describe("Registry", [this]() {
+    It("Should index actions in variant order", [this]() {
+      TestEqual("Tick", State::ActionIndex<State::FActionTick>, 0);
+      TestEqual("Flee", State::ActionIndex<State::FActionFlee>,
+                State::FBotActionList::Num - 1);
+      TestEqual("Variant", (int32)std::variant_size_v<State::FBotAction>,
+                State::FBotActionList::Num);
+      TestEqual("index()",
+                (int32)State::FBotAction(State::FActionSpotEnemy{}).index(),
+                State::ActionIndex<State::FActionSpotEnemy>);
+    });
+  });
+
+  Describe("Dispatch", [this]() {
+    It("Should match std::visit on every action", [this]() {
+      const State::FBotState Initial = State::CreateInitialState(TEXT("D"));
+      State::FBotState Visited = Initial;
+      State::FBotState Tabled = Initial;
+      for (const State::FBotAction &Action : MixedStream(5000)) {
+        std::visit(State::ReducerVisitor{Visited}, Action);
+        State::ReduceInPlace(Tabled, Action);
+        if (!TestTrue("Same", SameState(Visited, Tabled))) {
+          return;
+        }
+      }
+    });
+
+    It("Should batch homogeneous actions like one-by-one dispatch", [this]() {
+      TArray<State::FActionTakeDamage> Hits;
+      TArray<State::FBotState> Batched;
+      TArray<State::FBotState> Single;
+      for (int32 Index = 0; Index < 64; ++Index) {
+        Hits.Add({(float)Index * 1.5f, nullptr});
+        Batched.Add(State::CreateInitialState(TEXT("B")));
+      }
+      Single = Batched;
+
+      State::ReduceBatch<State::FActionTakeDamage>(Batched, Hits);
+      for (int32 Index = 0; Index < 64; ++Index) {
+        State::ReduceInPlace(Single[Index], Hits[Index]);
+        TestTrue("Same", SameState(Batched[Index], Single[Index]));
+      }
+    });
+  });
+
+  Describe("Performance", [this]() {
+    It("Should report dispatch cost against std::visit", [this]() {
+      constexpr int32 Count = 1000000;
+      const TArray<State::FBotAction> Mixed = MixedStream(Count);
+
+      TArray<State::FBotAction> TickVariants;
+      TArray<State::FActionTick> Ticks;
+      TickVariants.Reserve(Count);
+      Ticks.Reserve(Count);
+      for (int32 Index = 0; Index < Count; ++Index) {
+        Ticks.Add({0.016f});
+        TickVariants.Add(Ticks.Last());
+      }
+
+      const State::FBotState Initial = State::CreateInitialState(TEXT("P"));
+      State::FBotState Bot = Initial;
+      auto Visit = [&Bot](const TArray<State::FBotAction> &Actions) {
+        for (const State::FBotAction &Action : Actions) {
+          std::visit(State::ReducerVisitor{Bot}, Action);
+        }
+      };
+      auto Table = [&Bot](const TArray<State::FBotAction> &Actions) {
+        for (const State::FBotAction &Action : Actions) {
+          State::ReduceInPlace(Bot, Action);
+        }
+      };
+
+      const double MixedVisitMs = MeasureMs([&] { Visit(Mixed); });
+      const double MixedTableMs = MeasureMs([&] { Table(Mixed); });
+      const double TickVisitMs = MeasureMs([&] { Visit(TickVariants); });
+      const double TickTableMs = MeasureMs([&] { Table(TickVariants); });
+      const double TickBatchMs = MeasureMs(
+          [&] { State::ReduceBatch<State::FActionTick>(Bot, Ticks); });
+
+      TestTrue("Reduced", Bot.TickCount > Initial.TickCount);
+      AddInfo(FString::Printf(
+          TEXT("1M actions - mixed: visit %.2f ms, table %.2f ms; "
+               "ticks: visit %.2f ms, table %.2f ms, batch %.2f ms"),
+          MixedVisitMs, MixedTableMs, TickVisitMs, TickTableMs, TickBatchMs));
+    });
+  });
+}
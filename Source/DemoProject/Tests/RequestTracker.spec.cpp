@@ -0,0 +1,80 @@
+#include "DemoProject/Bot/RequestTracker.h"
+#include "Misc/AutomationTest.h"
+
+using namespace ForbocAI;
+
+DEFINE_SPEC(FRequestTrackerSpec, "ForbocAI.Bot.RequestTracker",
+            EAutomationTestFlags::ProductFilter |
+                EAutomationTestFlags::ApplicationContextMask)
+
+void FRequestTrackerSpec::Define() {
+  Describe("Backpressure", [this]() {
+    It("Should cap concurrency and start higher priorities first", [this]() {
+      Bot::TRequestTracker<int32> Tracker;
+      Tracker.MaxInFlight = 2;
+      Bot::RequestOps::Enqueue(Tracker, 1, 0);
+      Bot::RequestOps::Enqueue(Tracker, 2, 0);
+      Bot::RequestOps::Enqueue(Tracker, 3, 2);
+      Bot::RequestOps::Enqueue(Tracker, 4, 1);
+
+      TArray<TPair<int32, uint64>> Started;
+      Bot::RequestOps::Start(Tracker, 0.0, Started);
+      TestEqual("Capped", Started.Num(), 2);
+      TestEqual("Highest first", Started[0].Key, 3);
+      TestEqual("Then next", Started[1].Key, 4);
+      TestEqual("Rest pending", Bot::RequestOps::NumPending(Tracker), 2);
+
+      // A finished request frees its slot for the oldest equal-priority key
+      Bot::RequestOps::Complete(Tracker, 3, Started[0].Value, 1.0);
+      Started.Reset();
+      Bot::RequestOps::Start(Tracker, 1.0, Started);
+      TestEqual("FIFO within a priority", Started[0].Key, 1);
+    });
+
+    It("Should fold a due bot into its outstanding request", [this]() {
+      Bot::TRequestTracker<int32> Tracker;
+      Bot::RequestOps::Enqueue(Tracker, 7, 0);
+      TestFalse("Already pending", Bot::RequestOps::Enqueue(Tracker, 7, 0));
+
+      TArray<TPair<int32, uint64>> Started;
+      Bot::RequestOps::Start(Tracker, 0.0, Started);
+      TestFalse("Already in flight", Bot::RequestOps::Enqueue(Tracker, 7, 0));
+      TestEqual("Coalesced", Tracker.Stats.Coalesced, (uint64)2);
+    });
+  });
+
+  Describe("Staleness", [this]() {
+    It("Should drop responses after a timeout or cancel", [this]() {
+      Bot::TRequestTracker<int32> Tracker;
+      Tracker.TimeoutSeconds = 5.0;
+      Bot::RequestOps::Enqueue(Tracker, 1, 0);
+      Bot::RequestOps::Enqueue(Tracker, 2, 0);
+
+      TArray<TPair<int32, uint64>> Started;
+      Bot::RequestOps::Start(Tracker, 0.0, Started);
+
+      TArray<int32> TimedOut;
+      Bot::RequestOps::CollectTimedOut(Tracker, 4.0, TimedOut);
+      TestEqual("Not yet", TimedOut.Num(), 0);
+
+      Bot::RequestOps::Cancel(Tracker, 2);
+      Bot::RequestOps::CollectTimedOut(Tracker, 6.0, TimedOut);
+      TestEqual("Key 1 timed out", TimedOut.Num(), 1);
+
+      TestFalse("Late response dropped",
+                Bot::RequestOps::Complete(Tracker, 1, Started[0].Value, 7.0));
+      TestFalse("Cancelled response dropped",
+                Bot::RequestOps::Complete(Tracker, 2, Started[1].Value, 7.0));
+
+      // A fresh request for the same key gets a new token
+      Bot::RequestOps::Enqueue(Tracker, 1, 0);
+      TArray<TPair<int32, uint64>> Restarted;
+      Bot::RequestOps::Start(Tracker, 8.0, Restarted);
+      TestFalse("Old token stale", Bot::RequestOps::IsCurrent(
+                                       Tracker, 1, Started[0].Value));
+      TestTrue("New token current",
+               Bot::RequestOps::Complete(Tracker, 1, Restarted[0].Value, 8.5));
+      TestEqual("Latency", Tracker.Stats.MaxLatency, 0.5);
+    });
+  });
+}
@@ -0,0 +1,99 @@
+#include "DemoProject/Bot/ResponseCache.h"
+#include "DemoProject/State/BotState.h"
+#include "Misc/AutomationTest.h"
+
+using namespace ForbocAI;
+
+DEFINE_SPEC(FResponseCacheSpec, "ForbocAI.Bot.ResponseCache",
+            EAutomationTestFlags::ProductFilter |
+                EAutomationTestFlags::ApplicationContextMask)
+
+void FResponseCacheSpec::Define() {
+  Describe("Key", [this]() {
+    It("Should ignore changes inside a bucket and cell", [this]() {
+      const Bot::FObservationKeyConfig Config;
+      const FName Guard(TEXT("Guard"));
+      State::FBotState Snapshot = State::CreateInitialState(TEXT("Key"));
+      Snapshot.Stats.Health = 97.0f;
+      const Bot::FObservationKey Before =
+          Bot::CacheOps::MakeKey(Snapshot, Guard, Config);
+
+      Snapshot.Stats.Health = 92.0f;
+      Snapshot.Position = FVector(100, 200, 0);
+      TestTrue("Same key",
+               Bot::CacheOps::MakeKey(Snapshot, Guard, Config) == Before);
+      const FName Merchant(TEXT("Merchant"));
+      TestFalse("Other persona",
+                Bot::CacheOps::MakeKey(Snapshot, Merchant, Config) == Before);
+
+      Snapshot.Stats.Health = 85.0f;
+      TestFalse("Health bucket",
+                Bot::CacheOps::MakeKey(Snapshot, Guard, Config) == Before);
+
+      Snapshot.Stats.Health = 97.0f;
+      Snapshot.Position = FVector(-1, 0, 0);
+      TestFalse("Cell",
+                Bot::CacheOps::MakeKey(Snapshot, Guard, Config) == Before);
+
+      Snapshot.Position = FVector::ZeroVector;
+      Snapshot.Phase = State::EBotPhase::Combat;
+      TestFalse("Phase",
+                Bot::CacheOps::MakeKey(Snapshot, Guard, Config) == Before);
+    });
+  });
+
+  Describe("Eviction", [this]() {
+    It("Should expire entries after the TTL", [this]() {
+      Bot::FResponseCache Cache;
+      Cache.TtlSeconds = 10.0;
+
+      Bot::FObservationKey Key;
+      FAgentAction Action;
+      Action.Type = TEXT("MOVE");
+
+      TestNull("Cold", Bot::CacheOps::Find(Cache, Key, 0.0));
+      Bot::CacheOps::Store(Cache, Key, Action, 0.0);
+
+      const FAgentAction *Hit = Bot::CacheOps::Find(Cache, Key, 5.0);
+      TestTrue("Warm", Hit && Hit->Type == TEXT("MOVE"));
+      TestNull("Expired", Bot::CacheOps::Find(Cache, Key, 10.0));
+
+      TestEqual("Hits", Cache.Stats.Hits, (uint64)1);
+      TestEqual("Misses", Cache.Stats.Misses, (uint64)2);
+      TestEqual("Expirations", Cache.Stats.Expired, (uint64)1);
+    });
+
+    It("Should evict the least recently used key when full", [this]() {
+      Bot::FResponseCache Cache(2);
+      FAgentAction Action;
+
+      Bot::FObservationKey A, B, C;
+      A.CellX = 1;
+      B.CellX = 2;
+      C.CellX = 3;
+
+      Bot::CacheOps::Store(Cache, A, Action, 0.0);
+      Bot::CacheOps::Store(Cache, B, Action, 0.0);
+      Bot::CacheOps::Find(Cache, A, 1.0); // A is now most recent
+      Bot::CacheOps::Store(Cache, C, Action, 1.0);
+
+      TestNotNull("A kept", Bot::CacheOps::Find(Cache, A, 2.0));
+      TestNull("B evicted", Bot::CacheOps::Find(Cache, B, 2.0));
+      TestNotNull("C kept", Bot::CacheOps::Find(Cache, C, 2.0));
+    });
+
+    It("Should never serve one persona's action to another", [this]() {
+      Bot::FResponseCache Cache;
+      FAgentAction Action;
+      Action.Type = TEXT("ATTACK");
+
+      Bot::FObservationKey Guard, Merchant;
+      Guard.Persona = TEXT("Guard");
+      Merchant.Persona = TEXT("Merchant");
+
+      Bot::CacheOps::Store(Cache, Guard, Action, 0.0);
+      TestNotNull("Guard hit", Bot::CacheOps::Find(Cache, Guard, 1.0));
+      TestNull("Merchant miss", Bot::CacheOps::Find(Cache, Merchant, 1.0));
+    });
+  });
+}
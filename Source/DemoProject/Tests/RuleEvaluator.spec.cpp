@@ -0,0 +1,209 @@
+#include "AgentModule.h"
+#include "DemoProject/Bridge/RuleEvaluator.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+
+using namespace ForbocAI;
+
+DEFINE_SPEC(FRuleEvaluatorSpec, "ForbocAI.Bridge.RuleEvaluator",
+            EAutomationTestFlags::ProductFilter |
+                EAutomationTestFlags::ApplicationContextMask)
+
+namespace {
+
+// A rule counting its calls, rejecting every action when bReject is set
+FValidationRule CountingRule(const FString &Id, TArray<FString> ActionTypes,
+                             TSharedRef<int32> Calls, bool bReject) {
+  FValidationRule Rule;
+  Rule.Id = Id;
+  Rule.Name = Id;
+  Rule.ActionTypes = MoveTemp(ActionTypes);
+  Rule.Validator = [Id, Calls, bReject](const FAgentAction &,
+                                        const FBridgeValidationContext &) {
+    ++*Calls;
+    FValidationResult Result;
+    Result.bValid = !bReject;
+    Result.Reason = Id;
+    return Result;
+  };
+  return Rule;
+}
+
+Bridge::FRuleSetPtr Share(Bridge::FRuleSet Rules) {
+  return MakeShared<const Bridge::FRuleSet, ESPMode::ThreadSafe>(
+      MoveTemp(Rules));
+}
+
+// Every type the RPG preset names, plus ones it doesn't, in random order
+TArray<FAgentAction> RandomActions(int32 Count) {
+  TArray<FString> Types = {TEXT("IDLE"), TEXT("UNKNOWN"), TEXT("move")};
+  for (const FValidationRule &Rule : BridgeOps::CreateRPGRules()) {
+    for (const FString &ActionType : Rule.ActionTypes) {
+      Types.AddUnique(ActionType);
+    }
+  }
+
+  FRandomStream Random(Count);
+  TArray<FAgentAction> Actions;
+  Actions.Reserve(Count);
+  for (int32 Index = 0; Index < Count; ++Index) {
+    FAgentAction &Action = Actions.AddDefaulted_GetRef();
+    Action.Type = Types[Random.RandHelper(Types.Num())];
+  }
+  return Actions;
+}
+
+} // namespace
+
+void FRuleEvaluatorSpec::Define() {
+  Describe("Buckets", [this]() {
+    It("Should only run the rules for the action's type", [this]() {
+      TSharedRef<int32> MoveCalls = MakeShared<int32>(0);
+      TSharedRef<int32> AttackCalls = MakeShared<int32>(0);
+      TSharedRef<int32> AnyCalls = MakeShared<int32>(0);
+      Bridge::FRuleEvaluator Evaluator;
+      Bridge::RuleEvaluatorOps::Compile(
+          Evaluator,
+          Share({CountingRule(TEXT("move"), {TEXT("MOVE")}, MoveCalls, false),
+                 CountingRule(TEXT("attack"), {TEXT("ATTACK")}, AttackCalls,
+                              false),
+                 CountingRule(TEXT("any"), {}, AnyCalls, false)}));
+      const FAgentState State = TypeFactory::AgentState(TEXT("{}"));
+      const FBridgeValidationContext Context =
+          BridgeFactory::CreateContext(&State, {});
+
+      FAgentAction Action;
+      Action.Type = TEXT("Move");
+      TestTrue("Valid",
+               Bridge::RuleEvaluatorOps::Validate(Evaluator, Action, Context)
+                   .bValid);
+      Action.Type = TEXT("SPEAK");
+      Bridge::RuleEvaluatorOps::Validate(Evaluator, Action, Context);
+
+      TestEqual("Move rule, case-insensitively", *MoveCalls, 1);
+      TestEqual("Attack rule never", *AttackCalls, 0);
+      TestEqual("Rule for any type, both times", *AnyCalls, 2);
+    });
+
+    It("Should try the most rejecting rule first once measured", [this]() {
+      TSharedRef<int32> PassCalls = MakeShared<int32>(0);
+      TSharedRef<int32> RejectCalls = MakeShared<int32>(0);
+      Bridge::FRuleEvaluator Evaluator;
+      Evaluator.ReorderInterval = 16;
+      Bridge::RuleEvaluatorOps::Compile(
+          Evaluator,
+          Share({CountingRule(TEXT("pass"), {TEXT("MOVE")}, PassCalls, false),
+                 CountingRule(TEXT("reject"), {TEXT("MOVE")}, RejectCalls,
+                              true)}));
+      const FAgentState State = TypeFactory::AgentState(TEXT("{}"));
+      const FBridgeValidationContext Context =
+          BridgeFactory::CreateContext(&State, {});
+
+      FAgentAction Action;
+      Action.Type = TEXT("MOVE");
+      for (int32 Index = 0; Index < 100; ++Index) {
+        const FValidationResult Result =
+            Bridge::RuleEvaluatorOps::Validate(Evaluator, Action, Context);
+        if (!TestFalse("Rejected", Result.bValid)) {
+          return;
+        }
+      }
+
+      TestEqual("First in line",
+                Bridge::RuleEvaluatorOps::RulesFor(Evaluator, TEXT("MOVE"))[0],
+                1);
+      TestTrue("Passing rule skipped after reordering", *PassCalls < 20);
+      TestEqual("Rejections", Evaluator.Rejected, (uint64)100);
+    });
+  });
+
+  Describe("RPG preset", [this]() {
+    It("Should reach the same verdicts as BridgeOps::Validate", [this]() {
+      const TArray<FValidationRule> Rules = BridgeOps::CreateRPGRules();
+      Bridge::FRuleEvaluator Evaluator;
+      Evaluator.ReorderInterval = 64;
+      Bridge::RuleEvaluatorOps::Compile(Evaluator, Share(Rules));
+      const FAgentState State = TypeFactory::AgentState(TEXT("{}"));
+      const FBridgeValidationContext Context =
+          BridgeFactory::CreateContext(&State, {});
+
+      const TArray<FAgentAction> Actions = RandomActions(2000);
+      TArray<FValidationResult> Batch;
+      Bridge::RuleEvaluatorOps::ValidateBatch(
+          Evaluator, Actions,
+          [&Context](int32) -> const FBridgeValidationContext & {
+            return Context;
+          },
+          Batch);
+      if (!TestEqual("Batch results", Batch.Num(), Actions.Num())) {
+        return;
+      }
+
+      for (int32 Index = 0; Index < Actions.Num(); ++Index) {
+        const bool bExpected =
+            BridgeOps::Validate(Actions[Index], Rules, Context).bValid;
+        const bool bCompiled = Bridge::RuleEvaluatorOps::Validate(
+                                   Evaluator, Actions[Index], Context)
+                                   .bValid;
+        if (!TestEqual(*Actions[Index].Type, bCompiled, bExpected) ||
+            !TestEqual("Batch", Batch[Index].bValid, bExpected)) {
+          return;
+        }
+      }
+    });
+  });
+
+  Describe("Performance", [this]() {
+    It("Should report the cost against BridgeOps::Validate", [this]() {
+      const TArray<FValidationRule> Rules = BridgeOps::CreateRPGRules();
+      const TArray<FAgentAction> Actions = RandomActions(100000);
+      const FAgentState State = TypeFactory::AgentState(TEXT("{}"));
+      int32 Valid[3] = {0, 0, 0};
+
+      // The response path before: a context per response, every rule listed
+      double Start = FPlatformTime::Seconds();
+      for (const FAgentAction &Action : Actions) {
+        const FBridgeValidationContext Context =
+            BridgeFactory::CreateContext(&State, {});
+        Valid[0] += BridgeOps::Validate(Action, Rules, Context).bValid;
+      }
+      const double BaselineNs =
+          (FPlatformTime::Seconds() - Start) * 1e9 / Actions.Num();
+
+      Bridge::FRuleEvaluator Evaluator;
+      Bridge::RuleEvaluatorOps::Compile(Evaluator, Share(Rules));
+      const FBridgeValidationContext Context =
+          BridgeFactory::CreateContext(&State, {});
+      Start = FPlatformTime::Seconds();
+      for (const FAgentAction &Action : Actions) {
+        Valid[1] +=
+            Bridge::RuleEvaluatorOps::Validate(Evaluator, Action, Context)
+                .bValid;
+      }
+      const double CompiledNs =
+          (FPlatformTime::Seconds() - Start) * 1e9 / Actions.Num();
+
+      TArray<FValidationResult> Results;
+      Start = FPlatformTime::Seconds();
+      Bridge::RuleEvaluatorOps::ValidateBatch(
+          Evaluator, Actions,
+          [&Context](int32) -> const FBridgeValidationContext & {
+            return Context;
+          },
+          Results);
+      const double BatchNs =
+          (FPlatformTime::Seconds() - Start) * 1e9 / Actions.Num();
+      for (const FValidationResult &Result : Results) {
+        Valid[2] += Result.bValid;
+      }
+
+      TestEqual("Compiled verdicts", Valid[1], Valid[0]);
+      TestEqual("Batch verdicts", Valid[2], Valid[0]);
+      AddInfo(FString::Printf(
+          TEXT("%d rules, %d actions: BridgeOps::Validate %.1f ns, compiled "
+               "%.1f ns, batch %.1f ns per action (%d valid)"),
+          Rules.Num(), Actions.Num(), BaselineNs, CompiledNs, BatchNs,
+          Valid[0]));
+    });
+  });
+}
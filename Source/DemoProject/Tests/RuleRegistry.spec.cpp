@@ -0,0 +1,247 @@
+#include "DemoProject/Bridge/RuleRegistry.h"
+#include "DemoProject/Tests/StubHttpServer.h"
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+using namespace ForbocAI;
+
+DEFINE_SPEC(FRuleRegistrySpec, "ForbocAI.Bridge.RuleRegistry",
+            EAutomationTestFlags::ProductFilter |
+                EAutomationTestFlags::ApplicationContextMask)
+
+namespace {
+
+constexpr int32 NumActors = 200;
+
+// Records registrations instead of sending them
+struct FFakeRegistrar {
+  TArray<FString> Urls;
+  bool bSucceed = true;
+
+  Bridge::FRuleRegistrar Bind() {
+    return [this](const FString &ApiUrl, Bridge::FRuleSetPtr,
+                  TFunction<void(bool)> OnComplete) {
+      Urls.Add(ApiUrl);
+      OnComplete(bSucceed);
+    };
+  }
+};
+
+int32 CountRules(const FString &RequestBody) {
+  TSharedPtr<FJsonObject> Root;
+  const TArray<TSharedPtr<FJsonValue>> *Rules = nullptr;
+  if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(RequestBody),
+                                    Root) ||
+      !Root->TryGetArrayField(TEXT("rules"), Rules)) {
+    return INDEX_NONE;
+  }
+  return Rules->Num();
+}
+
+} // namespace
+
+void FRuleRegistrySpec::Define() {
+  Describe("Dedup", [this]() {
+    It("Should build and register a preset once for every actor", [this]() {
+      Bridge::FRuleRegistry Registry;
+      FFakeRegistrar Fake;
+      Registry.Registrar = Fake.Bind();
+
+      int32 Builds = 0;
+      Bridge::FRuleSetPtr First;
+      for (int32 Actor = 0; Actor < NumActors; ++Actor) {
+        Bridge::FRuleSetPtr Rules = Bridge::RuleRegistryOps::AcquirePreset(
+            Registry, TEXT("RPG"),
+            [&Builds] {
+              ++Builds;
+              return BridgeOps::CreateRPGRules();
+            },
+            TEXT("http://localhost"));
+        First = First.IsValid() ? First : Rules;
+        if (!TestTrue("Shared", Rules == First)) {
+          return;
+        }
+      }
+
+      TestEqual("Built", Builds, 1);
+      TestEqual("Registered", Fake.Urls.Num(), 1);
+      const Bridge::FRuleRegistryStats Stats =
+          Bridge::RuleRegistryOps::GetStats(Registry);
+      TestEqual("Acquired", Stats.Acquired, (uint64)NumActors);
+      TestEqual("Sets", Stats.Sets, 1);
+    });
+
+    It("Should key sets by content and registrations by API", [this]() {
+      Bridge::FRuleRegistry Registry;
+      FFakeRegistrar Fake;
+      Registry.Registrar = Fake.Bind();
+
+      const Bridge::FRuleSetPtr Preset =
+          Bridge::RuleRegistryOps::AcquirePreset(
+              Registry, TEXT("RPG"), [] { return BridgeOps::CreateRPGRules(); },
+              TEXT("http://a"));
+      const Bridge::FRuleSetPtr SameContent = Bridge::RuleRegistryOps::Acquire(
+          Registry, BridgeOps::CreateRPGRules(), TEXT("http://a"));
+      TestTrue("Same set", Preset == SameContent);
+      TestEqual("Not registered twice", Fake.Urls.Num(), 1);
+
+      Bridge::RuleRegistryOps::Acquire(Registry, BridgeOps::CreateRPGRules(),
+                                       TEXT("http://b"));
+      TestEqual("Another API", Fake.Urls.Num(), 2);
+
+      TArray<FValidationRule> Fewer = BridgeOps::CreateRPGRules();
+      if (Fewer.Num() > 0) {
+        Fewer.RemoveAt(0);
+        const Bridge::FRuleSetPtr Other = Bridge::RuleRegistryOps::Acquire(
+            Registry, MoveTemp(Fewer), TEXT("http://a"));
+        TestTrue("Different set", Other != Preset);
+        TestEqual("Registered too", Fake.Urls.Num(), 3);
+      }
+    });
+
+    It("Should keep sets apart that only share a hash", [this]() {
+      Bridge::FRuleRegistry Registry;
+      FFakeRegistrar Fake;
+      Registry.Registrar = Fake.Bind();
+
+      // The hash doesn't cover validators
+      TArray<FValidationRule> Unchecked = BridgeOps::CreateRPGRules();
+      if (Unchecked.Num() == 0) {
+        return;
+      }
+      Unchecked[0].Validator = nullptr;
+      TestEqual("Same hash",
+                Bridge::RuleRegistryOps::HashRules(Unchecked),
+                Bridge::RuleRegistryOps::HashRules(
+                    BridgeOps::CreateRPGRules()));
+
+      const Bridge::FRuleSetPtr Rpg = Bridge::RuleRegistryOps::Acquire(
+          Registry, BridgeOps::CreateRPGRules(), TEXT("http://a"));
+      const Bridge::FRuleSetPtr Other = Bridge::RuleRegistryOps::Acquire(
+          Registry, MoveTemp(Unchecked), TEXT("http://a"));
+      TestTrue("Different set", Other != Rpg);
+      TestFalse("Validator kept", (bool)(*Other)[0].Validator);
+      TestEqual("Sets", Bridge::RuleRegistryOps::GetStats(Registry).Sets, 2);
+      TestTrue("Found again",
+               Bridge::RuleRegistryOps::Acquire(
+                   Registry, BridgeOps::CreateRPGRules(),
+                   TEXT("http://a")) == Rpg);
+    });
+
+    It("Should register again once the session ends", [this]() {
+      Bridge::FRuleRegistry Registry;
+      FFakeRegistrar Fake;
+      Registry.Registrar = Fake.Bind();
+
+      const Bridge::FRuleSetPtr First = Bridge::RuleRegistryOps::AcquirePreset(
+          Registry, TEXT("RPG"), [] { return BridgeOps::CreateRPGRules(); },
+          TEXT("http://a"));
+      Bridge::RuleRegistryOps::EndSession(Registry);
+      const Bridge::FRuleSetPtr Second =
+          Bridge::RuleRegistryOps::AcquirePreset(
+              Registry, TEXT("RPG"), [] { return BridgeOps::CreateRPGRules(); },
+              TEXT("http://a"));
+      TestTrue("Same set", First == Second);
+      TestEqual("Registered each session", Fake.Urls.Num(), 2);
+    });
+
+    It("Should count failed registrations", [this]() {
+      Bridge::FRuleRegistry Registry;
+      FFakeRegistrar Fake;
+      Fake.bSucceed = false;
+      Registry.Registrar = Fake.Bind();
+
+      Bridge::RuleRegistryOps::Acquire(Registry, BridgeOps::CreateRPGRules(),
+                                       TEXT("http://a"));
+      TestEqual("Failed", Bridge::RuleRegistryOps::GetStats(Registry).Failed,
+                (uint64)1);
+    });
+  });
+
+  Describe("Stub server", [this]() {
+    LatentIt(
+        "Should register a level's worth of actors in one request",
+        FTimespan::FromSeconds(10), [this](const FDoneDelegate &Done) {
+          TSharedRef<Tests::FStubHttpServer> Server =
+              MakeShared<Tests::FStubHttpServer>();
+          TSharedRef<int32> RulesSent = MakeShared<int32>(0);
+          if (!Server->Start(Bridge::RuleRegistryOps::BatchPath,
+                             [RulesSent](const FString &Body) {
+                               *RulesSent += CountRules(Body);
+                               return FString(TEXT("{}"));
+                             })) {
+            AddError(TEXT("Could not bind stub route"));
+            Done.Execute();
+            return;
+          }
+
+          TSharedRef<Bridge::FRuleRegistry> Registry =
+              MakeShared<Bridge::FRuleRegistry>();
+          const double Start = FPlatformTime::Seconds();
+          Registry->Registrar = [this, Server, RulesSent, Registry, Start,
+                                 Done](const FString &ApiUrl,
+                                       Bridge::FRuleSetPtr Rules,
+                                       TFunction<void(bool)> OnComplete) {
+            Bridge::RuleRegistryOps::RegisterBatch(
+                *Registry, ApiUrl, Rules,
+                [this, Server, RulesSent, Registry, Rules, Start, Done,
+                 OnComplete](bool bOk) {
+                  OnComplete(bOk);
+                  // The registry holds this registrar, which holds it
+                  Registry->Registrar = nullptr;
+                  const double Ms = (FPlatformTime::Seconds() - Start) * 1000.0;
+                  TestTrue("Registered", bOk);
+                  TestEqual("Requests", Server->NumRequests, 1);
+                  TestEqual("Rules sent", *RulesSent, Rules->Num());
+                  AddInfo(FString::Printf(
+                      TEXT("%d actors: %d request, %d rules, %.2f ms "
+                           "(one request per rule per actor would be %d)"),
+                      NumActors, Server->NumRequests, *RulesSent, Ms,
+                      NumActors * Rules->Num()));
+                  Done.Execute();
+                });
+          };
+
+          for (int32 Actor = 0; Actor < NumActors; ++Actor) {
+            Bridge::RuleRegistryOps::AcquirePreset(
+                *Registry, TEXT("RPG"),
+                [] { return BridgeOps::CreateRPGRules(); },
+                Server->BaseUrl());
+          }
+        });
+
+    LatentIt(
+        "Should remember an API without the batch route",
+        FTimespan::FromSeconds(10), [this](const FDoneDelegate &Done) {
+          // Listening, but not on the batch route: it answers with a 404
+          TSharedRef<Tests::FStubHttpServer> Server =
+              MakeShared<Tests::FStubHttpServer>();
+          Server->Start(TEXT("/rules/elsewhere"),
+                        [](const FString &) { return FString(TEXT("{}")); });
+
+          TSharedRef<Bridge::FRuleRegistry> Registry =
+              MakeShared<Bridge::FRuleRegistry>();
+          const Bridge::FRuleSetPtr Rules =
+              MakeShared<const Bridge::FRuleSet, ESPMode::ThreadSafe>(
+                  BridgeOps::CreateRPGRules());
+          const FString ApiUrl = Server->BaseUrl();
+          Bridge::RuleRegistryOps::RegisterBatch(
+              *Registry, ApiUrl, Rules,
+              [this, Server, Registry, Rules, ApiUrl, Done](bool bOk) {
+                TestFalse("Batch refused", bOk);
+                TestTrue("Remembered",
+                         Registry->NoBatchRoute.Contains(ApiUrl));
+
+                bool bCompleted = false;
+                Bridge::RuleRegistryOps::RegisterBatch(
+                    *Registry, ApiUrl, Rules,
+                    [&bCompleted](bool) { bCompleted = true; });
+                TestTrue("Not probed again", bCompleted);
+                Done.Execute();
+              });
+        });
+  });
+}
@@ -0,0 +1,53 @@
+#include "DemoProject/Bot/SlotMap.h"
+#include "Misc/AutomationTest.h"
+
+using namespace ForbocAI;
+
+DEFINE_SPEC(FSlotMapSpec, "ForbocAI.Bot.SlotMap",
+            EAutomationTestFlags::ProductFilter |
+                EAutomationTestFlags::ApplicationContextMask)
+
+void FSlotMapSpec::Define() {
+  Describe("Handles", [this]() {
+    It("Should resolve until removed, then never again", [this]() {
+      Bot::TSlotMap<int32> Map;
+      const Bot::FBotHandle A = Bot::SlotMapOps::Add(Map, 10);
+      const Bot::FBotHandle B = Bot::SlotMapOps::Add(Map, 20);
+
+      TestEqual("A", *Bot::SlotMapOps::Find(Map, A), 10);
+      TestEqual("B", *Bot::SlotMapOps::Find(Map, B), 20);
+
+      Bot::SlotMapOps::RemoveSwap(Map, A);
+      TestNull("A stale", Bot::SlotMapOps::Find(Map, A));
+
+      // C reuses A's slot under a new generation
+      const Bot::FBotHandle C = Bot::SlotMapOps::Add(Map, 30);
+      TestEqual("Slot reused", C.Index, A.Index);
+      TestNull("A still stale", Bot::SlotMapOps::Find(Map, A));
+      TestEqual("C", *Bot::SlotMapOps::Find(Map, C), 30);
+      TestNull("Unset handle", Bot::SlotMapOps::Find(Map, Bot::FBotHandle()));
+    });
+  });
+
+  Describe("Packing", [this]() {
+    It("Should swap the last value into the hole", [this]() {
+      Bot::TSlotMap<int32> Map;
+      TArray<Bot::FBotHandle> Handles;
+      for (int32 Value = 0; Value < 5; ++Value) {
+        Handles.Add(Bot::SlotMapOps::Add(Map, Value));
+      }
+
+      TestEqual("Hole", Bot::SlotMapOps::RemoveSwap(Map, Handles[1]), 1);
+      TestEqual("Packed", Bot::SlotMapOps::Num(Map), 4);
+      TestEqual("Last moved in", Map.Dense[1], 4);
+      TestEqual("Moved handle follows",
+                Bot::SlotMapOps::DenseIndex(Map, Handles[4]), 1);
+      TestTrue("HandleAt", Bot::SlotMapOps::HandleAt(Map, 1) == Handles[4]);
+
+      TestEqual("Removing last moves nothing",
+                Bot::SlotMapOps::RemoveSwap(Map, Handles[3]), 3);
+      TestEqual("Stale remove", Bot::SlotMapOps::RemoveSwap(Map, Handles[3]),
+                INDEX_NONE);
+    });
+  });
+}
@@ -0,0 +1,444 @@
+#include "DemoProject/Soul/SoulExport.h"
+#include "DemoProject/Tests/StubHttpServer.h"
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Base64.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+using namespace ForbocAI;
+
+DEFINE_SPEC(FSoulExportSpec, "ForbocAI.Soul.SoulExport",
+            EAutomationTestFlags::ProductFilter |
+                EAutomationTestFlags::ApplicationContextMask)
+
+namespace {
+
+namespace StateOps = State::AgentStateOps;
+
+FName MemoryName(int32 Index) {
+  return FName(*FString::Printf(TEXT("memory-%d"), Index));
+}
+
+// An agent with Count memories, the one at Changed (if any) rewritten
+Soul::FSoulSnapshot MakeSnapshot(int32 Count, int32 Changed = INDEX_NONE) {
+  State::FAgentStateObject Memories;
+  for (int32 Index = 0; Index < Count; ++Index) {
+    Memories = StateOps::With(
+        Memories, MemoryName(Index),
+        StateOps::MakeValue(
+            Index == Changed
+                ? FString(TEXT("Forgot about the crate"))
+                : FString::Printf(
+                      TEXT("Saw the player near crate %d, carrying a torch"),
+                      Index)));
+  }
+
+  State::FAgentStatePatch Patch;
+  StateOps::Set(Patch, {TEXT("description")}, TEXT("Guarding the gate"));
+  StateOps::Set(Patch, {TEXT("memories")}, Memories);
+
+  Soul::FSoulSnapshot Snapshot;
+  Snapshot.AgentId = TEXT("agent-1");
+  Snapshot.Persona = TEXT("Guard");
+  Snapshot.State = StateOps::Apply({}, Patch);
+  return Snapshot;
+}
+
+TSharedPtr<FJsonObject> ParseBlock(const Soul::FSoulBlock &Block) {
+  FString Json;
+  TSharedPtr<FJsonObject> Root;
+  if (!Soul::SoulExportOps::ReadBlock(Block, Json) ||
+      !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json),
+                                    Root)) {
+    Root.Reset();
+  }
+  return Root;
+}
+
+#if WITH_FORBOCAI_STUB_SERVER
+const TCHAR *StubPath = TEXT("/souls/stream");
+
+// Holds uploaded blocks by name, the way the endpoint would
+struct FStubSoulStore {
+  TMap<FString, TArray<uint8>> Blocks;
+  int32 Chunks = 0;
+  int64 BytesReceived = 0;
+  // Chunk requests to fail, once Chunks reaches OutageAfter
+  int32 Outage = 0;
+  int32 OutageAfter = 0;
+  int32 CommittedBlocks = 0;
+  bool bCommittedAllHeld = false;
+  // Commits answered with the blocks the store lacks
+  int32 MissingReplies = 0;
+};
+
+FString HandleSoulRequest(FStubSoulStore &Store, const FString &Body) {
+  TSharedPtr<FJsonObject> Root;
+  if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Body),
+                                    Root) ||
+      !Root.IsValid()) {
+    return FString();
+  }
+
+  if (Root->GetStringField(TEXT("op")) == TEXT("chunk")) {
+    if (Store.Outage > 0 && Store.Chunks >= Store.OutageAfter) {
+      --Store.Outage;
+      return FString();
+    }
+    TArray<uint8> &Held =
+        Store.Blocks.FindOrAdd(Root->GetStringField(TEXT("block")));
+    TArray<uint8> Data;
+    FBase64::Decode(Root->GetStringField(TEXT("data")), Data);
+    if (Root->GetIntegerField(TEXT("offset")) == Held.Num()) {
+      Held.Append(Data);
+      ++Store.Chunks;
+      Store.BytesReceived += Data.Num();
+    }
+    return FString::Printf(TEXT("{\"received\":%d}"), Held.Num());
+  }
+
+  const TArray<TSharedPtr<FJsonValue>> &Listed =
+      Root->GetArrayField(TEXT("blocks"));
+  TArray<FString> Missing;
+  for (const TSharedPtr<FJsonValue> &Entry : Listed) {
+    const FString Block = Entry->AsObject()->GetStringField(TEXT("block"));
+    if (!Store.Blocks.Contains(Block)) {
+      Missing.Add(FString::Printf(TEXT("\"%s\""), *Block));
+    }
+  }
+  if (!Missing.IsEmpty()) {
+    ++Store.MissingReplies;
+    return FString::Printf(TEXT("{\"missing\":[%s]}"),
+                           *FString::Join(Missing, TEXT(",")));
+  }
+  Store.CommittedBlocks = Listed.Num();
+  Store.bCommittedAllHeld = true;
+  return TEXT("{\"txId\":\"stub-tx\"}");
+}
+#endif
+
+} // namespace
+
+void FSoulExportSpec::Define() {
+  Describe("Blocks", [this]() {
+    It("Should write the header, then every memory once", [this]() {
+      TArray<Soul::FSoulBlock> Blocks;
+      Soul::FSoulExportConfig Config;
+      Config.MemoriesPerBlock = 100;
+      TestTrue("Written", Soul::SoulExportOps::WriteBlocks(
+                              MakeSnapshot(1000), {}, Config, Blocks));
+      // 1000 / 100 rounds up to 16 blocks
+      if (!TestEqual("Header and memory blocks", Blocks.Num(), 17)) {
+        return;
+      }
+
+      const TSharedPtr<FJsonObject> Header = ParseBlock(Blocks[0]);
+      const TSharedPtr<FJsonObject> *State = nullptr;
+      TestTrue("Header", Header.IsValid() &&
+                             Header->GetStringField(TEXT("agentId")) ==
+                                 TEXT("agent-1") &&
+                             Header->TryGetObjectField(TEXT("state"), State));
+      TestFalse("Memories not in the header",
+                State && (*State)->HasField(TEXT("memories")));
+
+      int32 Memories = 0;
+      for (int32 Index = 1; Index < Blocks.Num(); ++Index) {
+        const TSharedPtr<FJsonObject> Block = ParseBlock(Blocks[Index]);
+        const TSharedPtr<FJsonObject> *Map = nullptr;
+        if (TestTrue("Memory block", Block.IsValid() &&
+                                         Block->TryGetObjectField(
+                                             TEXT("memories"), Map))) {
+          Memories += (*Map)->Values.Num();
+        }
+        TestTrue("Compressed", Blocks[Index].Data.Num() <
+                                   Blocks[Index].RawSize);
+      }
+      TestEqual("Every memory", Memories, 1000);
+    });
+
+    It("Should only rewrite the block of a changed memory", [this]() {
+      TArray<Soul::FSoulBlock> Before;
+      Soul::SoulExportOps::WriteBlocks(MakeSnapshot(5000), {}, {}, Before);
+      TSet<uint64> Known;
+      for (const Soul::FSoulBlock &Block : Before) {
+        Known.Add(Block.Hash);
+      }
+
+      TArray<Soul::FSoulBlock> After;
+      Soul::SoulExportOps::WriteBlocks(MakeSnapshot(5000, 1234), Known, {},
+                                       After);
+      TestEqual("Same blocks", After.Num(), Before.Num());
+      int32 Fresh = 0;
+      for (const Soul::FSoulBlock &Block : After) {
+        Fresh += Block.bKnown ? 0 : 1;
+        TestTrue("Known blocks aren't compressed",
+                 !Block.bKnown || Block.Data.IsEmpty());
+      }
+      TestEqual("One block to send", Fresh, 1);
+    });
+
+    It("Should write the same blocks whatever the insertion order", [this]() {
+      State::FAgentStateObject Memories;
+      for (int32 Index = 999; Index >= 0; --Index) {
+        Memories = StateOps::With(
+            Memories, MemoryName(Index),
+            StateOps::MakeValue(FString::Printf(
+                TEXT("Saw the player near crate %d, carrying a torch"),
+                Index)));
+      }
+      Soul::FSoulSnapshot Reversed = MakeSnapshot(0);
+      Reversed.State =
+          StateOps::With(Reversed.State, TEXT("memories"),
+                         StateOps::MakeValue(Memories));
+
+      TArray<Soul::FSoulBlock> Forward;
+      TArray<Soul::FSoulBlock> Backward;
+      Soul::SoulExportOps::WriteBlocks(MakeSnapshot(1000), {}, {}, Forward);
+      Soul::SoulExportOps::WriteBlocks(Reversed, {}, {}, Backward);
+      if (!TestEqual("Blocks", Backward.Num(), Forward.Num())) {
+        return;
+      }
+      for (int32 Index = 0; Index < Forward.Num(); ++Index) {
+        TestEqual("Hash", Backward[Index].Hash, Forward[Index].Hash);
+      }
+    });
+  });
+
+#if WITH_FORBOCAI_STUB_SERVER
+  Describe("Stub server", [this]() {
+    LatentIt(
+        "Should upload only what changed since the last export",
+        FTimespan::FromSeconds(20), [this](const FDoneDelegate &Done) {
+          TSharedRef<Tests::FStubHttpServer> Server =
+              MakeShared<Tests::FStubHttpServer>();
+          TSharedRef<FStubSoulStore> Store = MakeShared<FStubSoulStore>();
+          if (!Server->Start(StubPath, [Store](const FString &Body) {
+                return HandleSoulRequest(*Store, Body);
+              })) {
+            AddError(TEXT("Could not bind stub route"));
+            Done.Execute();
+            return;
+          }
+
+          const FString Url = Server->BaseUrl() + StubPath;
+          Soul::FSoulBlockCachePtr Cache =
+              MakeShared<Soul::FSoulBlockCache, ESPMode::ThreadSafe>();
+          Soul::FSoulExportConfig Config;
+          Config.ChunkBytes = 4096;
+          TSharedRef<int64> Sent = MakeShared<int64>(0);
+          TSharedRef<TSet<int64>> Totals = MakeShared<TSet<int64>>();
+
+          Soul::SoulExportOps::Start(
+              Url, MakeSnapshot(2000), Cache, Config,
+              [this, Sent, Totals](const Soul::FSoulExportProgress &Progress) {
+                TestTrue("On the game thread", IsInGameThread());
+                TestTrue("Only forward", Progress.BytesSent >= *Sent);
+                *Sent = Progress.BytesSent;
+                Totals->Add(Progress.BytesTotal);
+              },
+              [this, Server, Store, Cache, Url, Config, Sent, Totals,
+               Done](bool bOk, const FString &TxId) {
+                TestTrue("First export", bOk);
+                // Each block is compressed as its upload begins
+                TestTrue("Written block by block",
+                         Totals->Num() > Cache->Uploaded.Num());
+                TestEqual("TxId", TxId, FString(TEXT("stub-tx")));
+                TestTrue("Committed blocks held", Store->bCommittedAllHeld);
+                TestEqual("Progress reached the end", *Sent,
+                          Store->BytesReceived);
+                TestEqual("Blocks remembered", Cache->Uploaded.Num(),
+                          Store->CommittedBlocks);
+
+                const int64 FirstBytes = Store->BytesReceived;
+                const int32 FirstBlocks = Store->Blocks.Num();
+                Store->BytesReceived = 0;
+                Soul::SoulExportOps::Start(
+                    Url, MakeSnapshot(2000, 7), Cache, Config, nullptr,
+                    [this, Server, Store, FirstBytes, FirstBlocks,
+                     Done](bool bOk, const FString &) {
+                      TestTrue("Second export", bOk);
+                      TestTrue("Committed blocks held",
+                               Store->bCommittedAllHeld);
+                      TestEqual("One new block", Store->Blocks.Num(),
+                                FirstBlocks + 1);
+                      TestTrue("A fraction of the bytes",
+                               Store->BytesReceived * 4 < FirstBytes);
+                      Done.Execute();
+                    });
+              });
+        });
+
+    LatentIt(
+        "Should upload again the blocks the endpoint dropped",
+        FTimespan::FromSeconds(20), [this](const FDoneDelegate &Done) {
+          TSharedRef<Tests::FStubHttpServer> Server =
+              MakeShared<Tests::FStubHttpServer>();
+          TSharedRef<FStubSoulStore> Store = MakeShared<FStubSoulStore>();
+          Server->Start(StubPath, [Store](const FString &Body) {
+            return HandleSoulRequest(*Store, Body);
+          });
+
+          const FString Url = Server->BaseUrl() + StubPath;
+          Soul::FSoulBlockCachePtr Cache =
+              MakeShared<Soul::FSoulBlockCache, ESPMode::ThreadSafe>();
+          Soul::SoulExportOps::Start(
+              Url, MakeSnapshot(2000), Cache, {}, nullptr,
+              [this, Server, Store, Cache, Url, Done](bool bOk,
+                                                      const FString &) {
+                TestTrue("First export", bOk);
+
+                // The endpoint lets go of a block the cache says it holds
+                const int32 Held = Store->Blocks.Num();
+                const int64 FirstBytes = Store->BytesReceived;
+                Store->Blocks.Remove(Store->Blocks.CreateConstIterator().Key());
+                Store->BytesReceived = 0;
+                Soul::SoulExportOps::Start(
+                    Url, MakeSnapshot(2000), Cache, {}, nullptr,
+                    [this, Server, Store, Cache, Held, FirstBytes,
+                     Done](bool bOk, const FString &TxId) {
+                      TestTrue("Second export", bOk);
+                      TestEqual("TxId", TxId, FString(TEXT("stub-tx")));
+                      TestEqual("Told once", Store->MissingReplies, 1);
+                      TestTrue("Committed blocks held",
+                               Store->bCommittedAllHeld);
+                      TestEqual("Dropped block back", Store->Blocks.Num(),
+                                Held);
+                      TestTrue("Only that block resent",
+                               Store->BytesReceived > 0 &&
+                                   Store->BytesReceived * 4 < FirstBytes);
+                      TestEqual("Cache kept", Cache->Uploaded.Num(), Held);
+                      Done.Execute();
+                    });
+              });
+        });
+
+    LatentIt(
+        "Should resume a stopped export where the endpoint left off",
+        FTimespan::FromSeconds(20), [this](const FDoneDelegate &Done) {
+          TSharedRef<Tests::FStubHttpServer> Server =
+              MakeShared<Tests::FStubHttpServer>();
+          TSharedRef<FStubSoulStore> Store = MakeShared<FStubSoulStore>();
+          Store->OutageAfter = 3;
+          Store->Outage = 2;
+          Server->Start(StubPath, [Store](const FString &Body) {
+            return HandleSoulRequest(*Store, Body);
+          });
+
+          Soul::FSoulExportConfig Config;
+          Config.ChunkBytes = 1024;
+          Config.MaxAttempts = 2;
+          TSharedRef<Soul::FSoulExportPtr> Export =
+              MakeShared<Soul::FSoulExportPtr>();
+          TSharedRef<int32> Failures = MakeShared<int32>(0);
+
+          *Export = Soul::SoulExportOps::Start(
+              Server->BaseUrl() + StubPath, MakeSnapshot(2000), nullptr,
+              Config, nullptr,
+              [this, Server, Store, Export, Failures,
+               Done](bool bOk, const FString &) {
+                if (!bOk) {
+                  ++*Failures;
+                  TestEqual("Stopped after the outage began", Store->Chunks,
+                            3);
+                  TestTrue("Resumed",
+                           Soul::SoulExportOps::Resume(*Export));
+                  return;
+                }
+                TestEqual("Stopped once", *Failures, 1);
+                TestTrue("Committed blocks held", Store->bCommittedAllHeld);
+                TestEqual("Nothing sent twice", Store->BytesReceived,
+                          (*Export)->Progress.BytesTotal);
+                TestFalse("Done", Soul::SoulExportOps::Resume(*Export));
+                Done.Execute();
+              });
+        });
+
+    LatentIt(
+        "Should resume an export whose block failed to write",
+        FTimespan::FromSeconds(20), [this](const FDoneDelegate &Done) {
+          TSharedRef<Tests::FStubHttpServer> Server =
+              MakeShared<Tests::FStubHttpServer>();
+          TSharedRef<FStubSoulStore> Store = MakeShared<FStubSoulStore>();
+          Server->Start(StubPath, [Store](const FString &Body) {
+            return HandleSoulRequest(*Store, Body);
+          });
+
+          Soul::FSoulExportConfig Config;
+          Config.WriteFailures = 1;
+          Config.WriteFailuresAfter = 2;
+          TSharedRef<Soul::FSoulExportPtr> Export =
+              MakeShared<Soul::FSoulExportPtr>();
+          TSharedRef<int32> Failures = MakeShared<int32>(0);
+
+          *Export = Soul::SoulExportOps::Start(
+              Server->BaseUrl() + StubPath, MakeSnapshot(2000), nullptr,
+              Config, nullptr,
+              [this, Server, Store, Export, Failures,
+               Done](bool bOk, const FString &) {
+                if (!bOk) {
+                  ++*Failures;
+                  TestEqual("Stopped at the failed block",
+                            (*Export)->NextBlock, 2);
+                  TestTrue("Resumed",
+                           Soul::SoulExportOps::Resume(*Export));
+                  return;
+                }
+                TestEqual("Stopped once", *Failures, 1);
+                TestTrue("Committed blocks held", Store->bCommittedAllHeld);
+                TestEqual("Every block committed", Store->CommittedBlocks,
+                          (*Export)->Progress.Blocks);
+                TestEqual("Nothing sent twice", Store->BytesReceived,
+                          (*Export)->Progress.BytesTotal);
+                Done.Execute();
+              });
+        });
+  });
+#endif
+
+  Describe("Performance", [this]() {
+    It("Should report export cost with a large memory set", [this]() {
+      constexpr int32 Memories = 10000;
+      const Soul::FSoulSnapshot Snapshot = MakeSnapshot(Memories);
+
+      // Before: the whole Soul as one string, written where it was asked for
+      double Start = FPlatformTime::Seconds();
+      const FString Whole = StateOps::ToJson(Snapshot.State);
+      const double WholeMs = (FPlatformTime::Seconds() - Start) * 1e3;
+      const FTCHARToUTF8 WholeUtf8(*Whole, Whole.Len());
+
+      TArray<Soul::FSoulBlock> Blocks;
+      Start = FPlatformTime::Seconds();
+      Soul::SoulExportOps::WriteBlocks(Snapshot, {}, {}, Blocks);
+      const double BlocksMs = (FPlatformTime::Seconds() - Start) * 1e3;
+
+      int64 Compressed = 0;
+      int32 LargestRaw = 0;
+      TSet<uint64> Known;
+      for (const Soul::FSoulBlock &Block : Blocks) {
+        Compressed += Block.Data.Num();
+        LargestRaw = FMath::Max(LargestRaw, Block.RawSize);
+        Known.Add(Block.Hash);
+      }
+
+      TArray<Soul::FSoulBlock> Again;
+      Soul::SoulExportOps::WriteBlocks(MakeSnapshot(Memories, 42), Known, {},
+                                       Again);
+      int64 Resent = 0;
+      for (const Soul::FSoulBlock &Block : Again) {
+        Resent += Block.Data.Num();
+      }
+
+      TestTrue("Compressed", Compressed < WholeUtf8.Length());
+      TestTrue("Blocks smaller than the Soul",
+               LargestRaw * 4 < WholeUtf8.Length());
+      AddInfo(FString::Printf(
+          TEXT("%d memories: one piece %d bytes in %.1f ms; %d blocks in "
+               "%.1f ms off the game thread, largest %d raw, %lld "
+               "compressed; %lld bytes resent after one memory changed"),
+          Memories, WholeUtf8.Length(), WholeMs, Blocks.Num(), BlocksMs,
+          LargestRaw, Compressed, Resent));
+    });
+  });
+}
@@ -0,0 +1,200 @@
+#include "DemoProject/Bot/ParallelTick.h"
+#include "DemoProject/Bot/SlotMap.h"
+#include "DemoProject/Bot/SpatialGrid.h"
+#include "DemoProject/State/BotState.h"
+#include "DemoProject/State/BotStateTable.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+
+using namespace ForbocAI;
+
+DEFINE_SPEC(FSpatialGridSpec, "ForbocAI.Bot.SpatialGrid",
+            EAutomationTestFlags::ProductFilter |
+                EAutomationTestFlags::ApplicationContextMask)
+
+namespace {
+
+TArray<FVector> RandomPositions(int32 Count, float Extent) {
+  FRandomStream Random(Count);
+  TArray<FVector> Positions;
+  Positions.Reserve(Count);
+  for (int32 Index = 0; Index < Count; ++Index) {
+    Positions.Add(FVector(Random.FRandRange(-Extent, Extent),
+                          Random.FRandRange(-Extent, Extent), 0.0f));
+  }
+  return Positions;
+}
+
+TSet<int32> BruteForce(const TArray<FVector> &Positions, const FVector &Center,
+                       float Radius) {
+  TSet<int32> Found;
+  for (int32 Index = 0; Index < Positions.Num(); ++Index) {
+    if (FVector::DistSquared(Positions[Index], Center) <=
+        (double)Radius * Radius) {
+      Found.Add(Index);
+    }
+  }
+  return Found;
+}
+
+} // namespace
+
+void FSpatialGridSpec::Define() {
+  Describe("Grid", [this]() {
+    It("Should find exactly the keys within the radius", [this]() {
+      TArray<FVector> Positions = RandomPositions(2000, 20000.0f);
+      Bot::TSpatialGrid<int32> Grid;
+      for (int32 Index = 0; Index < Positions.Num(); ++Index) {
+        Bot::GridOps::Update(Grid, Index, Positions[Index]);
+      }
+
+      // Move a third of them, then re-bucket under another cell size
+      FRandomStream Random(7);
+      for (int32 Index = 0; Index < Positions.Num(); Index += 3) {
+        Positions[Index] = FVector(Random.FRandRange(-2e4f, 2e4f),
+                                   Random.FRandRange(-2e4f, 2e4f), 0.0f);
+        Bot::GridOps::Update(Grid, Index, Positions[Index]);
+      }
+      Bot::GridOps::SetCellSize(Grid, 777.0f);
+      TestEqual("Num", Bot::GridOps::Num(Grid), Positions.Num());
+
+      for (int32 Query = 0; Query < 50; ++Query) {
+        const FVector Center(Random.FRandRange(-2e4f, 2e4f),
+                             Random.FRandRange(-2e4f, 2e4f), 0.0f);
+        TSet<int32> Found;
+        Bot::GridOps::ForEachInRadius(
+            Grid, Center, 3000.0f,
+            [&Found](int32 Key, const FVector &, double) { Found.Add(Key); });
+
+        const TSet<int32> Expected = BruteForce(Positions, Center, 3000.0f);
+        if (!TestTrue("Same keys", Found.Num() == Expected.Num() &&
+                                       Found.Includes(Expected))) {
+          return;
+        }
+      }
+    });
+
+    It("Should forget removed keys", [this]() {
+      Bot::TSpatialGrid<int32> Grid;
+      Bot::GridOps::Update(Grid, 1, FVector::ZeroVector);
+      Bot::GridOps::Update(Grid, 2, FVector(10.0f, 0.0f, 0.0f));
+      Bot::GridOps::Remove(Grid, 1);
+      Bot::GridOps::Remove(Grid, 3);
+
+      int32 Found = 0;
+      Bot::GridOps::ForEachInRadius(
+          Grid, FVector::ZeroVector, 100.0f,
+          [&Found](int32 Key, const FVector &, double) { Found += Key; });
+      TestEqual("Only the survivor", Found, 2);
+      TestEqual("Num", Bot::GridOps::Num(Grid), 1);
+    });
+  });
+
+  Describe("Perception", [this]() {
+    It("Should report a sighting only when a bot comes into range",
+       [this]() {
+         Bot::TPerception<int32> Perception;
+         Bot::GridOps::Update(Perception.Grid, 1, FVector::ZeroVector);
+         Bot::GridOps::Update(Perception.Grid, 2, FVector(4000, 0, 0));
+         Bot::GridOps::Update(Perception.Grid, 3, FVector(90000, 0, 0));
+
+         const TArray<FVector> Players = {FVector(1000, 0, 0),
+                                          FVector(100, 0, 0)};
+         Bot::FPerceptionConfig Config;
+         TArray<Bot::TSighting<int32>> Entered;
+         TMap<int32, double> Near;
+
+         Bot::PerceptionOps::Sense(Perception, Players, Config, Entered, Near);
+         TestEqual("Entered", Entered.Num(), 1);
+         if (Entered.Num() == 1) {
+           TestEqual("Nearest player", Entered[0].PlayerLocation.X, 100.0);
+         }
+         TestEqual("Near", Near.Num(), 2);
+         TestEqual("Nearest distance", Near.FindRef(1), 100.0 * 100.0);
+
+         Bot::PerceptionOps::Sense(Perception, Players, Config, Entered, Near);
+         TestEqual("Still in range", Entered.Num(), 0);
+
+         Bot::GridOps::Update(Perception.Grid, 2, FVector(1500, 0, 0));
+         Bot::PerceptionOps::Sense(Perception, Players, Config, Entered, Near);
+         TestEqual("Walked in", Entered.Num(), 1);
+
+         // Leaving and coming back is a new sighting
+         Bot::GridOps::Update(Perception.Grid, 1, FVector(50000, 0, 0));
+         Bot::PerceptionOps::Sense(Perception, Players, Config, Entered, Near);
+         TestFalse("Left", Near.Contains(1));
+         Bot::GridOps::Update(Perception.Grid, 1, FVector::ZeroVector);
+         Bot::PerceptionOps::Sense(Perception, Players, Config, Entered, Near);
+         TestEqual("Came back", Entered.Num(), 1);
+       });
+  });
+
+  Describe("Sleeping Rows", [this]() {
+    It("Should swap rows without breaking handles", [this]() {
+      Bot::TSlotMap<int32> Map;
+      const Bot::FBotHandle First = Bot::SlotMapOps::Add(Map, 10);
+      const Bot::FBotHandle Second = Bot::SlotMapOps::Add(Map, 11);
+      Bot::SlotMapOps::Add(Map, 12);
+
+      State::FBotStateTable Table;
+      for (int32 Row = 0; Row < 3; ++Row) {
+        State::FBotState Bot = State::CreateInitialState(TEXT("Swap"));
+        Bot.TickCount = Row;
+        State::TableOps::AddRow(Table, Bot);
+      }
+
+      Bot::SlotMapOps::SwapDense(Map, 0, 2);
+      State::TableOps::SwapRows(Table, 0, 2);
+      TestEqual("Moved", Bot::SlotMapOps::DenseIndex(Map, First), 2);
+      TestEqual("Value", *Bot::SlotMapOps::Find(Map, First), 10);
+      TestEqual("Untouched", *Bot::SlotMapOps::Find(Map, Second), 11);
+      TestEqual("Row moved", Table.TickCounts[2], (uint64)0);
+      TestEqual("Row moved back", Table.TickCounts[0], (uint64)2);
+    });
+
+    It("Should tick only the awake rows", [this]() {
+      State::FBotStateTable Table;
+      for (int32 Row = 0; Row < 10; ++Row) {
+        State::TableOps::AddRow(Table, State::CreateInitialState(TEXT("Z")));
+      }
+
+      Bot::FParallelTickConfig Config;
+      Config.ChunkSize = 3;
+      Bot::ParallelOps::Tick(Table, 0, 4, State::FActionTick{0.1f}, Config);
+      TestEqual("Awake", Table.TickCounts[3], (uint64)1);
+      TestEqual("Asleep", Table.TickCounts[4], (uint64)0);
+    });
+  });
+
+  Describe("Performance", [this]() {
+    It("Should report query cost against a linear scan", [this]() {
+      const TArray<FVector> Positions = RandomPositions(100000, 1e5f);
+      Bot::TSpatialGrid<int32> Grid;
+      for (int32 Index = 0; Index < Positions.Num(); ++Index) {
+        Bot::GridOps::Update(Grid, Index, Positions[Index]);
+      }
+      const TArray<FVector> Players = RandomPositions(8, 1e5f);
+
+      int32 GridHits = 0;
+      const double GridStart = FPlatformTime::Seconds();
+      for (const FVector &Player : Players) {
+        Bot::GridOps::ForEachInRadius(
+            Grid, Player, 5000.0f,
+            [&GridHits](int32, const FVector &, double) { ++GridHits; });
+      }
+      const double GridMs = (FPlatformTime::Seconds() - GridStart) * 1000.0;
+
+      int32 ScanHits = 0;
+      const double ScanStart = FPlatformTime::Seconds();
+      for (const FVector &Player : Players) {
+        ScanHits += BruteForce(Positions, Player, 5000.0f).Num();
+      }
+      const double ScanMs = (FPlatformTime::Seconds() - ScanStart) * 1000.0;
+
+      TestEqual("Same hits", GridHits, ScanHits);
+      AddInfo(FString::Printf(
+          TEXT("100k bots, 8 players: grid %.3f ms, scan %.3f ms"), GridMs,
+          ScanMs));
+    });
+  });
+}
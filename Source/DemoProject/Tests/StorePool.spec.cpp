@@ -0,0 +1,76 @@
+#include "DemoProject/Bot/StorePool.h"
+#include "DemoProject/State/Actions.h"
+#include "DemoProject/State/BotStateTable.h"
+#include "Misc/AutomationTest.h"
+
+using namespace ForbocAI;
+
+DEFINE_SPEC(FStorePoolSpec, "ForbocAI.Bot.StorePool",
+            EAutomationTestFlags::ProductFilter |
+                EAutomationTestFlags::ApplicationContextMask)
+
+void FStorePoolSpec::Define() {
+  Describe("Slots", [this]() {
+    It("Should recycle released slots before growing", [this]() {
+      State::FBotStateTable Table;
+      State::TableOps::AddRow(Table, State::CreateInitialState(TEXT("A")));
+      State::TableOps::AddRow(Table, State::CreateInitialState(TEXT("B")));
+
+      Bot::FBotStorePool Pool;
+      Bot::FStoreSlot *A = Bot::PoolOps::Acquire(Pool, Table, 0);
+      Bot::FStoreSlot *B = Bot::PoolOps::Acquire(Pool, Table, 1);
+      TestEqual("Live", Pool.Stats.Live, 2);
+
+      Bot::PoolOps::Release(Pool, A);
+      Bot::FStoreSlot *C = Bot::PoolOps::Acquire(Pool, Table, 0);
+
+      TestTrue("Reused", C == A);
+      TestEqual("Recycled", Pool.Stats.Recycled, (int64)1);
+      TestEqual("HighWater", Pool.Stats.HighWater, 2);
+      TestEqual("One chunk", Bot::PoolOps::Capacity(Pool),
+                Bot::FBotStorePool::ChunkSize);
+
+      Bot::PoolOps::Release(Pool, B);
+      Bot::PoolOps::Release(Pool, C);
+      TestEqual("Empty", Pool.Stats.Live, 0);
+      TestEqual("HighWater kept", Pool.Stats.HighWater, 2);
+    });
+
+    It("Should reserve without moving live slots", [this]() {
+      State::FBotStateTable Table;
+      State::TableOps::AddRow(Table, State::CreateInitialState(TEXT("A")));
+
+      Bot::FBotStorePool Pool;
+      Bot::FStoreSlot *First = Bot::PoolOps::Acquire(Pool, Table, 0);
+      Bot::PoolOps::Reserve(Pool, 3 * Bot::FBotStorePool::ChunkSize);
+
+      TestEqual("Capacity", Bot::PoolOps::Capacity(Pool),
+                3 * Bot::FBotStorePool::ChunkSize);
+      TestEqual("Still row 0", First->Row, 0);
+      TestTrue("Still the table", First->Table == &Table);
+    });
+  });
+
+  Describe("Stores", [this]() {
+    It("Should follow the slot to a new row", [this]() {
+      State::FBotStateTable Table;
+      State::TableOps::AddRow(Table, State::CreateInitialState(TEXT("A")));
+      State::TableOps::AddRow(Table, State::CreateInitialState(TEXT("B")));
+
+      Bot::FBotStorePool Pool;
+      Bot::FStoreSlot *Slot = Bot::PoolOps::Acquire(Pool, Table, 1);
+      const Bot::FBotStore Store = Bot::PoolOps::CreateStore(Slot);
+
+      // B is swapped into row 0, as ABotOrchestrator::RemoveBot does
+      State::TableOps::RemoveRowSwap(Table, 0);
+      Slot->Row = 0;
+
+      State::FActionTakeDamage Damage;
+      Damage.Amount = 30.0f;
+      Store.Dispatch(Damage);
+
+      TestEqual("Name", Store.GetState().Name.ToString(), FString(TEXT("B")));
+      TestEqual("Row Health", Table.Stats[0].Health, 70.0f);
+    });
+  });
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// HTTPServer is only linked where WITH_FORBOCAI_STUB_SERVER is set (see
+// DemoProject.Build.cs); specs that need the stub check it too.
+#if WITH_FORBOCAI_STUB_SERVER
+
+#include "HttpPath.h"
+#include "HttpRouteHandle.h"
+#include "HttpServerModule.h"
+#include "HttpServerResponse.h"
+#include "IHttpRouter.h"
+
+namespace ForbocAI {
+namespace Tests {
+
+// ── Stub HTTP Server ──
+// Serves a single POST route on localhost so specs can exercise code that
+// talks to the API without a real backend. Routes are unbound (and listeners
+// stopped) when the stub goes out of scope.
+
+class FStubHttpServer {
+public:
+  // Returns the response body for a request body, or an empty string to
+  // answer with a 500.
+  using FHandler = TFunction<FString(const FString &RequestBody)>;
+
+  explicit FStubHttpServer(uint32 InPort = 18089) : Port(InPort) {}
+
+  ~FStubHttpServer() { Stop(); }
+
+  FString BaseUrl() const {
+    return FString::Printf(TEXT("http://localhost:%u"), Port);
+  }
+
+  bool Start(const FString &Path, FHandler Handler) {
+    Router = FHttpServerModule::Get().GetHttpRouter(Port);
+    if (!Router.IsValid()) {
+      return false;
+    }
+
+    Route = Router->BindRoute(
+        FHttpPath(Path), EHttpServerRequestVerbs::VERB_POST,
+        FHttpRequestHandler::CreateLambda(
+            [this, Handler = MoveTemp(Handler)](
+                const FHttpServerRequest &Request,
+                const FHttpResultCallback &OnComplete) {
+              ++NumRequests;
+
+              FUTF8ToTCHAR Body(
+                  reinterpret_cast<const ANSICHAR *>(Request.Body.GetData()),
+                  Request.Body.Num());
+              const FString Reply =
+                  Handler(FString(Body.Length(), Body.Get()));
+
+              TUniquePtr<FHttpServerResponse> Response =
+                  Reply.IsEmpty()
+                      ? FHttpServerResponse::Error(
+                            EHttpServerResponseCodes::ServerError)
+                      : FHttpServerResponse::Create(
+                            Reply, TEXT("application/json"));
+              OnComplete(MoveTemp(Response));
+              return true;
+            }));
+
+    FHttpServerModule::Get().StartAllListeners();
+    return Route.IsValid();
+  }
+
+  void Stop() {
+    if (Router.IsValid() && Route.IsValid()) {
+      Router->UnbindRoute(Route);
+    }
+    Route.Reset();
+    Router.Reset();
+  }
+
+  int32 NumRequests = 0;
+
+private:
+  uint32 Port;
+  TSharedPtr<IHttpRouter> Router;
+  FHttpRouteHandle Route;
+};
+
+} // namespace Tests
+} // namespace ForbocAI
+
+#endif // WITH_FORBOCAI_STUB_SERVER